@@ -0,0 +1,213 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Compares end-to-end latency and CPU time of Trajectories against BoundedTrajectories between a
+// publisher and a subscriber in separate nodes of one process. Intra-process communication is off,
+// so every message goes through the middleware, and through shared memory when it is configured
+// for loaned messages (e.g. Fast DDS data sharing or iceoryx).
+//
+// usage: bounded_transport_benchmark [num_messages] [num_candidates] [num_points]
+
+#include "autoware/trajectory_optimizer/bounded_trajectories.hpp"
+
+#include <rclcpp/rclcpp.hpp>
+
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace
+{
+using autoware::trajectory_optimizer::BoundedTrajectories;
+using autoware::trajectory_optimizer::Trajectories;
+
+struct Result
+{
+  std::vector<double> latencies_us;
+  double cpu_us_per_message{0.0};
+  bool loaned{false};
+};
+
+double get_process_cpu_us()
+{
+  rusage usage{};
+  getrusage(RUSAGE_SELF, &usage);
+  return static_cast<double>(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1e6 +
+         static_cast<double>(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec);
+}
+
+int64_t get_now_ns()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+           std::chrono::system_clock::now().time_since_epoch())
+    .count();
+}
+
+builtin_interfaces::msg::Time to_stamp(const int64_t ns)
+{
+  builtin_interfaces::msg::Time stamp;
+  stamp.sec = static_cast<int32_t>(ns / 1000000000);
+  stamp.nanosec = static_cast<uint32_t>(ns % 1000000000);
+  return stamp;
+}
+
+int64_t from_stamp(const builtin_interfaces::msg::Time & stamp)
+{
+  return static_cast<int64_t>(stamp.sec) * 1000000000 + stamp.nanosec;
+}
+
+Trajectories create_trajectories(const size_t num_candidates, const size_t num_points)
+{
+  Trajectories trajectories;
+  trajectories.trajectories.resize(num_candidates);
+  for (auto & trajectory : trajectories.trajectories) {
+    trajectory.header.frame_id = "map";
+    trajectory.points.resize(num_points);
+    for (size_t i = 0; i < num_points; ++i) {
+      trajectory.points[i].pose.position.x = static_cast<double>(i);
+      trajectory.points[i].pose.orientation.w = 1.0;
+    }
+  }
+  return trajectories;
+}
+
+/**
+ * @brief Publishes num_messages messages of type MessageT and collects their latency.
+ * @param publish Publishes one message stamped with the given time and returns whether it was
+ * loaned.
+ * @param get_stamp Extracts the publish time from a received message.
+ */
+template <typename MessageT, typename PublishFunction, typename StampFunction>
+Result run(
+  const std::string & topic, const size_t num_messages, PublishFunction publish,
+  StampFunction get_stamp)
+{
+  rclcpp::NodeOptions options;
+  options.use_intra_process_comms(false);
+  auto publisher_node = std::make_shared<rclcpp::Node>("benchmark_publisher", options);
+  auto subscriber_node = std::make_shared<rclcpp::Node>("benchmark_subscriber", options);
+
+  Result result;
+  result.latencies_us.reserve(num_messages);
+  std::atomic<size_t> received{0};
+  const auto qos = rclcpp::QoS(10).reliable();
+  auto subscription = subscriber_node->create_subscription<MessageT>(
+    topic, qos, [&](const typename MessageT::ConstSharedPtr msg) {
+      result.latencies_us.push_back(static_cast<double>(get_now_ns() - get_stamp(*msg)) * 1e-3);
+      ++received;
+    });
+  auto publisher = publisher_node->create_publisher<MessageT>(topic, qos);
+
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(subscriber_node);
+  std::thread spin_thread([&executor]() { executor.spin(); });
+  // wait for discovery
+  while (publisher->get_subscription_count() == 0) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+
+  const auto cpu_start = get_process_cpu_us();
+  for (size_t i = 0; i < num_messages; ++i) {
+    result.loaned = publish(*publisher, get_now_ns());
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (received < num_messages && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  // the sleeps between messages do not use cpu time
+  result.cpu_us_per_message =
+    (get_process_cpu_us() - cpu_start) / static_cast<double>(std::max<size_t>(num_messages, 1));
+
+  executor.cancel();
+  spin_thread.join();
+  return result;
+}
+
+void print_result(const std::string & name, Result result, const size_t num_messages)
+{
+  auto & latencies = result.latencies_us;
+  if (latencies.empty()) {
+    std::printf("%-10s no message received\n", name.c_str());
+    return;
+  }
+  std::sort(latencies.begin(), latencies.end());
+  const auto percentile = [&latencies](const double p) {
+    return latencies[static_cast<size_t>(p * static_cast<double>(latencies.size() - 1))];
+  };
+  double sum = 0.0;
+  for (const auto latency : latencies) {
+    sum += latency;
+  }
+  std::printf(
+    "%-10s received %zu/%zu, loaned %s, latency mean %.1f us, p50 %.1f us, p99 %.1f us, "
+    "cpu %.1f us/msg\n",
+    name.c_str(), latencies.size(), num_messages, result.loaned ? "yes" : "no",
+    sum / static_cast<double>(latencies.size()), percentile(0.5), percentile(0.99),
+    result.cpu_us_per_message);
+}
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  rclcpp::init(argc, argv);
+  const size_t num_messages = argc > 1 ? std::stoul(argv[1]) : 500;
+  const size_t num_candidates = argc > 2 ? std::stoul(argv[2]) : 10;
+  const size_t num_points = argc > 3 ? std::stoul(argv[3]) : 300;
+  const auto trajectories = create_trajectories(num_candidates, num_points);
+
+  auto unbounded_result = run<Trajectories>(
+    "benchmark/trajectories", num_messages,
+    [&trajectories](rclcpp::Publisher<Trajectories> & publisher, const int64_t now_ns) {
+      auto msg = trajectories;
+      msg.trajectories.front().header.stamp = to_stamp(now_ns);
+      publisher.publish(msg);
+      return false;
+    },
+    [](const Trajectories & msg) { return from_stamp(msg.trajectories.front().header.stamp); });
+
+  auto bounded_msg = std::make_unique<BoundedTrajectories>();
+  auto bounded_result = run<BoundedTrajectories>(
+    "benchmark/bounded_trajectories", num_messages,
+    [&](rclcpp::Publisher<BoundedTrajectories> & publisher, const int64_t now_ns) {
+      // the conversion is part of the measured cost, as it is in the node
+      if (publisher.can_loan_messages()) {
+        auto loaned_msg = publisher.borrow_loaned_message();
+        autoware::trajectory_optimizer::to_bounded(trajectories, loaned_msg.get());
+        loaned_msg.get().trajectories.front().stamp = to_stamp(now_ns);
+        publisher.publish(std::move(loaned_msg));
+        return true;
+      }
+      autoware::trajectory_optimizer::to_bounded(trajectories, *bounded_msg);
+      bounded_msg->trajectories.front().stamp = to_stamp(now_ns);
+      publisher.publish(*bounded_msg);
+      return false;
+    },
+    [](const BoundedTrajectories & msg) { return from_stamp(msg.trajectories.front().stamp); });
+
+  std::printf(
+    "%zu messages of %zu candidates x %zu points\n", num_messages, num_candidates, num_points);
+  print_result("unbounded", std::move(unbounded_result), num_messages);
+  print_result("bounded", std::move(bounded_result), num_messages);
+  rclcpp::shutdown();
+  return 0;
+}
@@ -0,0 +1,120 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Compares the element-wise stages (non-finite point removal, engage speed clamp and speed limit)
+// run once per candidate with the same stages run as batch kernels over a CandidateBatch, for a
+// cycle of many short candidates. The batch is timed with and without packing the candidates into
+// it and copying them back, since a caller that does not keep its candidates in a batch pays for
+// both.
+//
+// usage: candidate_batch_benchmark [num_cycles] [num_candidates] [num_points]
+
+#include "autoware/trajectory_optimizer/candidate_batch.hpp"
+#include "autoware/trajectory_optimizer/scenario_generator.hpp"
+#include "autoware/trajectory_optimizer/utils.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace
+{
+using autoware::trajectory_optimizer::CandidateBatch;
+using autoware::trajectory_optimizer::NewTrajectory;
+namespace scenarios = autoware::trajectory_optimizer::scenarios;
+namespace utils = autoware::trajectory_optimizer::utils;
+
+constexpr float min_velocity = 1.0f;
+constexpr float min_acceleration = 0.5f;
+constexpr float max_velocity = 5.0f;
+
+/**
+ * @brief Runs a cycle num_cycles times on a fresh copy of the candidates.
+ * @return The mean time per cycle in microseconds, without the copy.
+ */
+double run(
+  const std::vector<NewTrajectory> & candidates, const size_t num_cycles,
+  const std::function<void(std::vector<NewTrajectory> &)> & cycle)
+{
+  auto trajectories = candidates;
+  double total_us = 0.0;
+  for (size_t i = 0; i < num_cycles; ++i) {
+    for (size_t j = 0; j < candidates.size(); ++j) {
+      trajectories[j].points.assign(candidates[j].points.begin(), candidates[j].points.end());
+    }
+    const auto start = std::chrono::steady_clock::now();
+    cycle(trajectories);
+    total_us +=
+      std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+  }
+  return total_us / static_cast<double>(num_cycles);
+}
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  const size_t num_cycles = argc > 1 ? std::stoul(argv[1]) : 10000;
+  const size_t num_candidates = argc > 2 ? std::stoul(argv[2]) : 64;
+  const size_t num_points = argc > 3 ? std::stoul(argv[3]) : 20;
+
+  scenarios::ScenarioParams params;
+  params.type = scenarios::ScenarioType::INTERSECTION_TURN;
+  params.num_points = num_points;
+  params.defects.invalid_point_ratio = 0.01;
+  const auto candidates =
+    scenarios::ScenarioGenerator(0).generate_candidates(params, num_candidates).trajectories;
+
+  const double per_candidate_us = run(candidates, num_cycles, [](auto & trajectories) {
+    for (auto & trajectory : trajectories) {
+      auto & points = trajectory.points;
+      points.erase(
+        std::remove_if(
+          points.begin(), points.end(), [](const auto & p) { return !utils::validate_point(p); }),
+        points.end());
+      utils::clamp_velocities(points, min_velocity, min_acceleration);
+      utils::set_max_velocity(points, max_velocity);
+    }
+  });
+
+  CandidateBatch batch;
+  const auto run_batch_kernels = [&batch]() {
+    batch.remove_non_finite_points();
+    batch.clamp_velocities(min_velocity, min_acceleration);
+    batch.set_max_velocity(max_velocity);
+  };
+  const double packed_batch_us = run(candidates, num_cycles, [&](auto & trajectories) {
+    batch.assign(trajectories);
+    run_batch_kernels();
+    batch.copy_to(trajectories);
+  });
+  double kept_batch_us = 0.0;
+  for (size_t i = 0; i < num_cycles; ++i) {
+    batch.assign(candidates);
+    const auto start = std::chrono::steady_clock::now();
+    run_batch_kernels();
+    kept_batch_us +=
+      std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+  }
+  kept_batch_us /= static_cast<double>(num_cycles);
+
+  std::printf(
+    "%zu candidates of %zu points, mean of %zu cycles\n", num_candidates, num_points, num_cycles);
+  std::printf("%-36s %10.2f us\n", "per candidate", per_candidate_us);
+  std::printf("%-36s %10.2f us\n", "batch, packed and copied back", packed_batch_us);
+  std::printf("%-36s %10.2f us\n", "batch, kept packed", kept_batch_us);
+  return 0;
+}
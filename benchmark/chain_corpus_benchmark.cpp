@@ -0,0 +1,131 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Times the optimizer chain on a corpus of fuzzer inputs, e.g. the slowest inputs found by
+// chain_latency_fuzzer. Each input is decoded as by the fuzzer and run num_repetitions times; the
+// inputs are listed slowest first with their median time and the median time of each stage.
+//
+// usage: chain_corpus_benchmark <corpus directory> [num_repetitions] [max_points]
+
+#include "fuzzed_cycle.hpp"
+
+#include "autoware/trajectory_optimizer/cycle_capture.hpp"
+#include "autoware/trajectory_optimizer/optimizer_chain.hpp"
+
+#include <autoware_utils/system/time_keeper.hpp>
+#include <rclcpp/rclcpp.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+using autoware::trajectory_optimizer::OptimizerChain;
+using autoware::trajectory_optimizer::StageTimings;
+namespace benchmark = autoware::trajectory_optimizer::benchmark;
+
+struct Result
+{
+  std::string name;
+  size_t num_points{0};
+  double median_ms{0.0};
+  std::map<std::string, double> stage_median_ms;
+};
+
+double median(std::vector<double> values)
+{
+  std::nth_element(values.begin(), values.begin() + values.size() / 2, values.end());
+  return values[values.size() / 2];
+}
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  if (argc < 2) {
+    std::fprintf(
+      stderr, "usage: chain_corpus_benchmark <corpus directory> [num_repetitions] [max_points]\n");
+    return 1;
+  }
+  rclcpp::init(1, argv);
+  const std::filesystem::path corpus(argv[1]);
+  const size_t num_repetitions = std::max<size_t>(argc > 2 ? std::stoul(argv[2]) : 20, 1);
+  const size_t max_points = argc > 3 ? std::stoul(argv[3]) : 10000;
+
+  auto node = benchmark::create_node_with_shipped_config("chain_corpus_benchmark");
+  const auto base_params = benchmark::create_fuzzing_params(*node);
+  OptimizerChain chain(
+    node.get(), std::make_shared<autoware_utils_debug::TimeKeeper>(), base_params);
+
+  std::vector<Result> results;
+  for (const auto & entry : std::filesystem::directory_iterator(corpus)) {
+    if (!entry.is_regular_file()) {
+      continue;
+    }
+    std::ifstream file(entry.path(), std::ios::binary);
+    const std::vector<uint8_t> data(
+      (std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    const auto cycle = benchmark::decode_cycle(data.data(), data.size(), max_points);
+
+    auto params = base_params;
+    params.current_odometry = cycle.odometry;
+    params.current_acceleration = cycle.acceleration;
+    params.ego_history_points = cycle.ego_history_points;
+    StageTimings stage_timings;
+    params.stage_timings = &stage_timings;
+
+    std::vector<double> times_ms;
+    std::map<std::string, std::vector<double>> stage_times_ms;
+    for (size_t i = 0; i < num_repetitions; ++i) {
+      auto points = cycle.points;
+      const auto start = std::chrono::steady_clock::now();
+      chain.optimize_trajectory(points, params);
+      times_ms.push_back(
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+          .count());
+      for (const auto & [stage, time] : stage_timings.take()) {
+        stage_times_ms[stage].push_back(time.total_ms);
+      }
+    }
+
+    Result result{entry.path().filename().string(), cycle.points.size(), median(times_ms), {}};
+    for (const auto & [stage, times] : stage_times_ms) {
+      result.stage_median_ms[stage] = median(times);
+    }
+    results.push_back(std::move(result));
+  }
+
+  std::sort(results.begin(), results.end(), [](const auto & a, const auto & b) {
+    return a.median_ms > b.median_ms;
+  });
+  std::printf("%zu inputs, median of %zu runs\n", results.size(), num_repetitions);
+  for (const auto & result : results) {
+    std::printf(
+      "%-32s %6zu points %10.3f ms\n", result.name.c_str(), result.num_points, result.median_ms);
+    for (const auto & [stage, time_ms] : result.stage_median_ms) {
+      std::printf("  %-30s %10.3f ms\n", stage.c_str(), time_ms);
+    }
+  }
+  rclcpp::shutdown();
+  return 0;
+}
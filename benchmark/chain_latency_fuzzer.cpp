@@ -0,0 +1,184 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// libFuzzer target searching for the inputs that make the optimizer chain slowest. Each input is
+// decoded by decode_cycle() into a candidate and an ego state and run once through OptimizerChain
+// with every stage enabled. Besides code coverage, the fuzzer is guided by run time: the time of
+// each stage and of the whole chain, in buckets of half an octave, is reported as extra coverage
+// counters, so an input reaching a slower bucket of any stage is kept and mutated further.
+//
+// The slowest inputs found are written to CHAIN_FUZZER_SLOWEST_DIR (default chain_fuzzer_slowest),
+// at most CHAIN_FUZZER_NUM_SLOWEST (default 32) of them, named after their run time in
+// microseconds. The directory is a corpus for chain_corpus_benchmark, which times it in a build
+// without coverage instrumentation. CHAIN_FUZZER_MAX_POINTS (default 10000) bounds the candidate
+// length.
+//
+// usage: chain_latency_fuzzer [libFuzzer options] [corpus directory]
+//   e.g. chain_latency_fuzzer -max_total_time=3600 -timeout=5 corpus/
+
+#include "fuzzed_cycle.hpp"
+
+#include "autoware/trajectory_optimizer/cycle_capture.hpp"
+#include "autoware/trajectory_optimizer/optimizer_chain.hpp"
+
+#include <autoware_utils/system/time_keeper.hpp>
+#include <rclcpp/rclcpp.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <set>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace
+{
+using autoware::trajectory_optimizer::OptimizerChain;
+using autoware::trajectory_optimizer::StageTimings;
+using autoware::trajectory_optimizer::TrajectoryOptimizerParams;
+namespace benchmark = autoware::trajectory_optimizer::benchmark;
+
+constexpr size_t num_time_buckets = 64;
+constexpr std::string_view stage_names[] = {
+  "eb_smoother_optimizer", "trajectory_extender", "trajectory_point_fixer",
+  "trajectory_spline_smoother", "trajectory_velocity_optimizer"};
+// the last row is the whole chain
+constexpr size_t num_time_rows = std::size(stage_names) + 1;
+
+// cleared by libFuzzer before every input, like the coverage counters
+__attribute__((used, section("__libfuzzer_extra_counters"))) uint8_t
+  time_counters[num_time_rows * num_time_buckets];
+
+void count_time(const size_t row, const double elapsed_ms)
+{
+  const auto elapsed_us = std::max(elapsed_ms * 1e3, 1.0);
+  const auto bucket = std::min(
+    static_cast<size_t>(2.0 * std::log2(elapsed_us)), num_time_buckets - 1);
+  time_counters[row * num_time_buckets + bucket] = 1;
+}
+
+size_t get_env(const char * name, const size_t default_value)
+{
+  const auto * value = std::getenv(name);
+  return value ? std::strtoull(value, nullptr, 10) : default_value;
+}
+
+/**
+ * @brief Keeps the slowest inputs on disk, dropping the fastest one when full.
+ */
+class SlowestInputs
+{
+public:
+  SlowestInputs(std::filesystem::path directory, const size_t capacity)
+  : directory_(std::move(directory)), capacity_(capacity)
+  {
+    std::filesystem::create_directories(directory_);
+  }
+
+  void offer(const double elapsed_ms, const uint8_t * data, const size_t size)
+  {
+    if (capacity_ == 0 || (inputs_.size() >= capacity_ && elapsed_ms <= inputs_.begin()->first)) {
+      return;
+    }
+    // libFuzzer runs the same input again, e.g. when minimizing, keep its first time only
+    const auto hash = std::hash<std::string_view>{}(
+      std::string_view(reinterpret_cast<const char *>(data), size));
+    if (!hashes_.insert(hash).second) {
+      return;
+    }
+    char name[64];
+    std::snprintf(name, sizeof(name), "%012.0f_%016zx", elapsed_ms * 1e3, hash);
+    const auto path = directory_ / name;
+    std::ofstream(path, std::ios::binary).write(reinterpret_cast<const char *>(data), size);
+    inputs_.emplace(elapsed_ms, path);
+    if (inputs_.size() > capacity_) {
+      std::filesystem::remove(inputs_.begin()->second);
+      inputs_.erase(inputs_.begin());
+    }
+  }
+
+private:
+  std::filesystem::path directory_;
+  size_t capacity_;
+  std::multiset<std::pair<double, std::filesystem::path>> inputs_;
+  std::set<size_t> hashes_;
+};
+
+struct Fuzzer
+{
+  std::shared_ptr<rclcpp::Node> node;
+  std::unique_ptr<OptimizerChain> chain;
+  TrajectoryOptimizerParams params;
+  size_t max_points{10000};
+  std::unique_ptr<SlowestInputs> slowest_inputs;
+};
+
+Fuzzer & get_fuzzer()
+{
+  static Fuzzer fuzzer;
+  return fuzzer;
+}
+}  // namespace
+
+extern "C" int LLVMFuzzerInitialize(int *, char ***)
+{
+  // the libFuzzer options are not ROS arguments
+  rclcpp::init(0, nullptr);
+  auto & fuzzer = get_fuzzer();
+  fuzzer.node = benchmark::create_node_with_shipped_config("chain_latency_fuzzer");
+  fuzzer.params = benchmark::create_fuzzing_params(*fuzzer.node);
+  fuzzer.chain = std::make_unique<OptimizerChain>(
+    fuzzer.node.get(), std::make_shared<autoware_utils_debug::TimeKeeper>(), fuzzer.params);
+  fuzzer.max_points = get_env("CHAIN_FUZZER_MAX_POINTS", 10000);
+  const auto * directory = std::getenv("CHAIN_FUZZER_SLOWEST_DIR");
+  fuzzer.slowest_inputs = std::make_unique<SlowestInputs>(
+    directory ? directory : "chain_fuzzer_slowest", get_env("CHAIN_FUZZER_NUM_SLOWEST", 32));
+  return 0;
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t * data, size_t size)
+{
+  auto & fuzzer = get_fuzzer();
+  auto cycle = benchmark::decode_cycle(data, size, fuzzer.max_points);
+  auto params = fuzzer.params;
+  params.current_odometry = cycle.odometry;
+  params.current_acceleration = cycle.acceleration;
+  params.ego_history_points = std::move(cycle.ego_history_points);
+  StageTimings stage_timings;
+  params.stage_timings = &stage_timings;
+
+  const auto start = std::chrono::steady_clock::now();
+  fuzzer.chain->optimize_trajectory(cycle.points, params);
+  const auto elapsed_ms =
+    std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+  for (const auto & [stage, time] : stage_timings.take()) {
+    const auto it = std::find(std::begin(stage_names), std::end(stage_names), stage);
+    if (it != std::end(stage_names)) {
+      count_time(static_cast<size_t>(it - std::begin(stage_names)), time.total_ms);
+    }
+  }
+  count_time(num_time_rows - 1, elapsed_ms);
+  fuzzer.slowest_inputs->offer(elapsed_ms, data, size);
+  return 0;
+}
@@ -0,0 +1,242 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef FUZZED_CYCLE_HPP_
+#define FUZZED_CYCLE_HPP_
+
+#include "shipped_config.hpp"
+
+#include "autoware/trajectory_optimizer/trajectory_optimizer_structs.hpp"
+
+#include <rclcpp/rclcpp.hpp>
+
+#include <autoware_planning_msgs/msg/trajectory_point.hpp>
+#include <geometry_msgs/msg/accel_with_covariance_stamped.hpp>
+#include <nav_msgs/msg/odometry.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <vector>
+
+namespace autoware::trajectory_optimizer::benchmark
+{
+using autoware_planning_msgs::msg::TrajectoryPoint;
+
+/**
+ * @brief The inputs of the chain for one candidate.
+ */
+struct FuzzedCycle
+{
+  std::vector<TrajectoryPoint> points;
+  nav_msgs::msg::Odometry odometry;
+  geometry_msgs::msg::AccelWithCovarianceStamped acceleration;
+  std::vector<TrajectoryPoint> ego_history_points;
+};
+
+/**
+ * @brief Reads values from fuzzer bytes, zero once they run out.
+ */
+class ByteReader
+{
+public:
+  ByteReader(const uint8_t * data, const size_t size) : data_(data), size_(size) {}
+
+  template <typename T>
+  T read()
+  {
+    T value{};
+    const auto n = std::min(sizeof(T), size_ - position_);
+    std::memcpy(&value, data_ + position_, n);
+    position_ += n;
+    return value;
+  }
+
+  // in [min, max]
+  double read_range(const double min, const double max)
+  {
+    return min + (max - min) * static_cast<double>(read<uint16_t>()) / 65535.0;
+  }
+
+  bool empty() const { return position_ >= size_; }
+
+private:
+  const uint8_t * data_;
+  size_t size_;
+  size_t position_{0};
+};
+
+/**
+ * @brief Decodes fuzzer bytes into the inputs of the chain.
+ * @details The bytes are an ego state followed by a program of segments that grow the trajectory,
+ * so that short inputs can describe long candidates: straight lines and arcs (with steps down to
+ * 0, i.e. duplicated points), hairpins, reversals, clusters of near-duplicate points, velocity
+ * changes and non-finite or extreme values written to the first or the last point.
+ *
+ * @param data The fuzzer bytes.
+ * @param size The number of bytes.
+ * @param max_points The trajectory stops growing at this many points.
+ * @return The decoded inputs.
+ */
+inline FuzzedCycle decode_cycle(const uint8_t * data, const size_t size, const size_t max_points)
+{
+  ByteReader reader(data, size);
+  FuzzedCycle cycle;
+
+  // ego state, relative to the start of the trajectory
+  const auto ego_x = reader.read_range(-20.0, 20.0);
+  const auto ego_y = reader.read_range(-20.0, 20.0);
+  const auto ego_yaw = reader.read_range(-M_PI, M_PI);
+  cycle.odometry.header.frame_id = "map";
+  cycle.odometry.pose.pose.position.x = ego_x;
+  cycle.odometry.pose.pose.position.y = ego_y;
+  cycle.odometry.pose.pose.orientation.z = std::sin(ego_yaw / 2.0);
+  cycle.odometry.pose.pose.orientation.w = std::cos(ego_yaw / 2.0);
+  cycle.odometry.twist.twist.linear.x = reader.read_range(-5.0, 30.0);
+  cycle.acceleration.accel.accel.linear.x = reader.read_range(-10.0, 10.0);
+  const auto num_history_points = reader.read<uint8_t>() % 32;
+  for (size_t i = 0; i < num_history_points; ++i) {
+    TrajectoryPoint point;
+    point.pose = cycle.odometry.pose.pose;
+    point.pose.position.x -= std::cos(ego_yaw) * static_cast<double>(num_history_points - i);
+    point.pose.position.y -= std::sin(ego_yaw) * static_cast<double>(num_history_points - i);
+    cycle.ego_history_points.push_back(point);
+  }
+
+  double x = 0.0;
+  double y = 0.0;
+  double yaw = 0.0;
+  double time_s = 0.0;
+  float velocity = static_cast<float>(reader.read_range(0.0, 20.0));
+  const auto add_point = [&](const double step) {
+    x += step * std::cos(yaw);
+    y += step * std::sin(yaw);
+    time_s += std::abs(step) / std::max(std::abs(static_cast<double>(velocity)), 0.1);
+    TrajectoryPoint point;
+    point.pose.position.x = x;
+    point.pose.position.y = y;
+    point.pose.orientation.z = std::sin(yaw / 2.0);
+    point.pose.orientation.w = std::cos(yaw / 2.0);
+    point.longitudinal_velocity_mps = velocity;
+    point.time_from_start = rclcpp::Duration::from_seconds(time_s);
+    cycle.points.push_back(point);
+  };
+
+  while (!reader.empty() && cycle.points.size() < max_points) {
+    const auto op = reader.read<uint8_t>() % 7;
+    const auto count =
+      std::min<size_t>(1 + reader.read<uint16_t>() % 1024, max_points - cycle.points.size());
+    switch (op) {
+      case 0: {  // straight line
+        const auto step = reader.read_range(0.0, 4.0);
+        for (size_t i = 0; i < count; ++i) {
+          add_point(step);
+        }
+        break;
+      }
+      case 1: {  // arc
+        const auto step = reader.read_range(0.0, 4.0);
+        const auto curvature = reader.read_range(-0.5, 0.5);
+        for (size_t i = 0; i < count; ++i) {
+          yaw += curvature * step;
+          add_point(step);
+        }
+        break;
+      }
+      case 2: {  // hairpin
+        yaw += M_PI;
+        const auto step = reader.read_range(0.0, 4.0);
+        for (size_t i = 0; i < count; ++i) {
+          add_point(step);
+        }
+        break;
+      }
+      case 3: {  // reversal, backwards without turning
+        velocity = -velocity;
+        const auto step = reader.read_range(0.0, 4.0);
+        for (size_t i = 0; i < count; ++i) {
+          add_point(-step);
+        }
+        break;
+      }
+      case 4: {  // near-duplicate points
+        const auto jitter = reader.read_range(0.0, 1e-6);
+        for (size_t i = 0; i < count; ++i) {
+          add_point(jitter);
+        }
+        break;
+      }
+      case 5: {  // velocity change
+        velocity = static_cast<float>(reader.read_range(-30.0, 30.0));
+        break;
+      }
+      default: {  // special value at a boundary
+        if (cycle.points.empty()) {
+          break;
+        }
+        constexpr double special_values[] = {
+          std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::infinity(),
+          -std::numeric_limits<double>::infinity(), 1e12, -1e12,
+          std::numeric_limits<double>::denorm_min()};
+        const auto value = special_values[reader.read<uint8_t>() % std::size(special_values)];
+        const auto field = reader.read<uint8_t>();
+        auto & point = (field & 0x80) != 0 ? cycle.points.back() : cycle.points.front();
+        switch (field % 6) {
+          case 0:
+            point.pose.position.x = value;
+            break;
+          case 1:
+            point.pose.position.y = value;
+            break;
+          case 2:
+            point.pose.position.z = value;
+            break;
+          case 3:
+            point.pose.orientation.w = value;
+            break;
+          case 4:
+            point.longitudinal_velocity_mps = static_cast<float>(value);
+            break;
+          default:
+            point.acceleration_mps2 = static_cast<float>(value);
+            break;
+        }
+        break;
+      }
+    }
+  }
+  return cycle;
+}
+
+/**
+ * @brief Reads the chain parameters from the node, with every stage enabled.
+ */
+inline TrajectoryOptimizerParams create_fuzzing_params(rclcpp::Node & node)
+{
+  auto params = read_chain_params(node);
+  params.use_akima_spline_interpolation = true;
+  params.smooth_velocities = true;
+  params.smooth_trajectories = true;
+  params.limit_speed = true;
+  params.set_engage_speed = true;
+  params.fix_invalid_points = true;
+  params.extend_trajectory_backward = true;
+  return params;
+}
+}  // namespace autoware::trajectory_optimizer::benchmark
+
+#endif  // FUZZED_CYCLE_HPP_
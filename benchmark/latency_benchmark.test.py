@@ -0,0 +1,168 @@
+# Copyright 2025 TIER IV, Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# End-to-end latency of the optimizer started with the shipped configuration, driven by
+# synthetic_trajectory_generator. Each combination of worker threads, process layout and input rate
+# is a separate launch; the generator reports the publish-to-receive latency distribution and the
+# number of inputs without output, which are printed and written next to the test results.
+#
+# The candidate shape can be changed with the environment variables
+# LATENCY_BENCHMARK_{NUM_CANDIDATES,NUM_POINTS,DURATION_S}, and the p99 latency every combination
+# must stay below with LATENCY_BENCHMARK_MAX_P99_MS.
+
+import json
+import os
+import tempfile
+import unittest
+
+from ament_index_python.packages import get_package_share_directory
+import launch
+from launch_ros.actions import ComposableNodeContainer
+from launch_ros.descriptions import ComposableNode
+import launch_testing
+import launch_testing.actions
+import pytest
+
+PACKAGE = "autoware_trajectory_optimizer"
+OPTIMIZER_NAMESPACE = "/trajectory_optimizer"
+
+
+def generate_parameter_files():
+    share = get_package_share_directory(PACKAGE)
+    return [
+        os.path.join(share, "config", "trajectory_optimizer.param.yaml"),
+        os.path.join(share, "config", "velocity_smoothing", "default_velocity_smoother.param.yaml"),
+        os.path.join(share, "config", "velocity_smoothing", "JerkFiltered.param.yaml"),
+        os.path.join(share, "config", "velocity_smoothing", "default_common.param.yaml"),
+        os.path.join(share, "config", "trajectory_smoothing", "elastic_band_smoother.param.yaml"),
+        os.path.join(
+            get_package_share_directory("autoware_vehicle_info_utils"),
+            "config",
+            "vehicle_info.param.yaml",
+        ),
+    ]
+
+
+@pytest.mark.launch_test
+@launch_testing.parametrize(
+    "num_worker_threads, intra_process, rate_hz",
+    [
+        (1, False, 10.0),
+        (4, False, 10.0),
+        (1, True, 10.0),
+        (4, True, 10.0),
+        (1, False, 50.0),
+        (4, False, 50.0),
+        (1, True, 50.0),
+        (4, True, 50.0),
+    ],
+)
+def generate_test_description(num_worker_threads, intra_process, rate_hz):
+    result_path = os.path.join(
+        tempfile.mkdtemp(prefix="trajectory_optimizer_latency_"), "result.json"
+    )
+    optimizer = ComposableNode(
+        package=PACKAGE,
+        plugin="autoware::trajectory_optimizer::TrajectoryInterpolator",
+        name="trajectory_optimizer",
+        parameters=[
+            *generate_parameter_files(),
+            {"num_worker_threads": num_worker_threads},
+        ],
+        extra_arguments=[{"use_intra_process_comms": intra_process}],
+    )
+    generator = ComposableNode(
+        package=PACKAGE,
+        plugin="autoware::trajectory_optimizer::benchmark::SyntheticTrajectoryGenerator",
+        name="synthetic_trajectory_generator",
+        parameters=[
+            {
+                "rate_hz": rate_hz,
+                "num_candidates": int(os.environ.get("LATENCY_BENCHMARK_NUM_CANDIDATES", "8")),
+                "num_points": int(os.environ.get("LATENCY_BENCHMARK_NUM_POINTS", "200")),
+                "duration_s": float(os.environ.get("LATENCY_BENCHMARK_DURATION_S", "10.0")),
+                "result_path": result_path,
+            }
+        ],
+        remappings=[
+            ("output/odometry", OPTIMIZER_NAMESPACE + "/input/odometry"),
+            ("output/acceleration", OPTIMIZER_NAMESPACE + "/input/acceleration"),
+            ("output/previous_trajectory", OPTIMIZER_NAMESPACE + "/input/previous_trajectory"),
+            ("output/trajectories", OPTIMIZER_NAMESPACE + "/input/trajectories"),
+            ("input/optimized_trajectories", OPTIMIZER_NAMESPACE + "/output/trajectories"),
+        ],
+        extra_arguments=[{"use_intra_process_comms": intra_process}],
+    )
+
+    # intra-process communication needs both nodes in one process
+    if intra_process:
+        containers = [
+            ComposableNodeContainer(
+                name="latency_benchmark_container",
+                namespace="",
+                package="rclcpp_components",
+                executable="component_container_mt",
+                composable_node_descriptions=[optimizer, generator],
+                output="screen",
+            )
+        ]
+    else:
+        containers = [
+            ComposableNodeContainer(
+                name=name + "_container",
+                namespace="",
+                package="rclcpp_components",
+                executable="component_container_mt",
+                composable_node_descriptions=[node],
+                output="screen",
+            )
+            for name, node in (("optimizer", optimizer), ("generator", generator))
+        ]
+
+    return (
+        launch.LaunchDescription([*containers, launch_testing.actions.ReadyToTest()]),
+        {"result_path": result_path},
+    )
+
+
+class TestLatency(unittest.TestCase):
+    def test_latency(self, proc_output, num_worker_threads, intra_process, rate_hz, result_path):
+        duration_s = float(os.environ.get("LATENCY_BENCHMARK_DURATION_S", "10.0"))
+        max_p99_ms = float(os.environ.get("LATENCY_BENCHMARK_MAX_P99_MS", "100.0"))
+        # start up, warm up, the run and the grace period for outputs in flight; the generator
+        # renames the complete results into place before it logs their path
+        proc_output.assertWaitFor(
+            "results in " + result_path, timeout=duration_s + 30.0, stream="stderr"
+        )
+        with open(result_path) as file:
+            result = json.load(file)
+
+        layout = "intra-process" if intra_process else "inter-process"
+        latency = result["latency_ms"]
+        print(
+            f"{num_worker_threads} worker thread(s), {layout}, {rate_hz:.0f} Hz: "
+            f"sent {result['sent']}, received {result['received']}, dropped {result['dropped']}, "
+            f"latency mean {latency['mean']:.2f} p50 {latency['p50']:.2f} "
+            f"p90 {latency['p90']:.2f} p99 {latency['p99']:.2f} max {latency['max']:.2f} ms"
+        )
+        # every measured input is either received or dropped
+        self.assertGreater(result["received"], 0)
+        self.assertEqual(result["received"] + result["dropped"], result["sent"])
+        # a latency distribution, measured forward in time
+        self.assertGreater(latency["p50"], 0.0)
+        self.assertLessEqual(latency["p50"], latency["p90"])
+        self.assertLessEqual(latency["p90"], latency["p99"])
+        self.assertLessEqual(latency["p99"], latency["max"])
+        self.assertLessEqual(latency["mean"], latency["max"])
+        self.assertLessEqual(latency["p99"], max_p99_ms)
@@ -0,0 +1,89 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SHIPPED_CONFIG_HPP_
+#define SHIPPED_CONFIG_HPP_
+
+#include "autoware/trajectory_optimizer/trajectory_optimizer_structs.hpp"
+
+#include <ament_index_cpp/get_package_share_directory.hpp>
+#include <autoware_utils/ros/parameter.hpp>
+#include <rclcpp/rclcpp.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace autoware::trajectory_optimizer::benchmark
+{
+
+/**
+ * @brief Creates a node holding the shipped configuration and the vehicle info, which an
+ * OptimizerChain created on it reads its parameters from.
+ */
+inline std::shared_ptr<rclcpp::Node> create_node_with_shipped_config(const std::string & name)
+{
+  const auto share = ament_index_cpp::get_package_share_directory("autoware_trajectory_optimizer");
+  const auto vehicle_info_share =
+    ament_index_cpp::get_package_share_directory("autoware_vehicle_info_utils");
+  std::vector<std::string> arguments{"--ros-args"};
+  for (const auto & path :
+       {share + "/config/trajectory_optimizer.param.yaml",
+        share + "/config/velocity_smoothing/default_velocity_smoother.param.yaml",
+        share + "/config/velocity_smoothing/JerkFiltered.param.yaml",
+        share + "/config/velocity_smoothing/default_common.param.yaml",
+        share + "/config/trajectory_smoothing/elastic_band_smoother.param.yaml",
+        vehicle_info_share + "/config/vehicle_info.param.yaml"}) {
+    arguments.insert(arguments.end(), {"--params-file", path});
+  }
+  return std::make_shared<rclcpp::Node>(
+    name, rclcpp::NodeOptions().use_global_arguments(false).arguments(arguments));
+}
+
+/**
+ * @brief Reads the chain parameters from the node, as TrajectoryInterpolator::set_up_params().
+ */
+inline TrajectoryOptimizerParams read_chain_params(rclcpp::Node & node)
+{
+  using autoware_utils::get_or_declare_parameter;
+
+  TrajectoryOptimizerParams params;
+  params.nearest_dist_threshold_m =
+    get_or_declare_parameter<double>(node, "nearest_dist_threshold_m");
+  params.nearest_yaw_threshold_rad =
+    get_or_declare_parameter<double>(node, "nearest_yaw_threshold_rad");
+  params.target_pull_out_speed_mps =
+    get_or_declare_parameter<double>(node, "target_pull_out_speed_mps");
+  params.target_pull_out_acc_mps2 =
+    get_or_declare_parameter<double>(node, "target_pull_out_acc_mps2");
+  params.max_speed_mps = get_or_declare_parameter<double>(node, "max_speed_mps");
+  params.spline_interpolation_resolution_m =
+    get_or_declare_parameter<double>(node, "spline_interpolation_resolution_m");
+  params.backward_trajectory_extension_m =
+    get_or_declare_parameter<double>(node, "backward_trajectory_extension_m");
+  params.use_akima_spline_interpolation =
+    get_or_declare_parameter<bool>(node, "use_akima_spline_interpolation");
+  params.smooth_velocities = get_or_declare_parameter<bool>(node, "smooth_velocities");
+  params.smooth_trajectories = get_or_declare_parameter<bool>(node, "smooth_trajectories");
+  params.limit_speed = get_or_declare_parameter<bool>(node, "limit_speed");
+  params.set_engage_speed = get_or_declare_parameter<bool>(node, "set_engage_speed");
+  params.fix_invalid_points = get_or_declare_parameter<bool>(node, "fix_invalid_points");
+  params.extend_trajectory_backward =
+    get_or_declare_parameter<bool>(node, "extend_trajectory_backward");
+  params.detailed_timing = false;
+  return params;
+}
+}  // namespace autoware::trajectory_optimizer::benchmark
+
+#endif  // SHIPPED_CONFIG_HPP_
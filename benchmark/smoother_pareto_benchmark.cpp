@@ -0,0 +1,397 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Runs the optimizer chain of the shipped configuration with every combination of the smoother
+// settings (Akima spline on at each resolution or off, EB off or at each delta_arc_length,
+// velocity smoother on or off) over a corpus of generated scenarios, and reports the latency of
+// each combination next to the quality of its output:
+//   - max curvature and curvature rate,
+//   - max lateral and longitudinal jerk,
+//   - max lateral deviation from the input (and the ego history the chain extends it with),
+//   - feasibility violations: points over the lateral acceleration limit, the acceleration and
+//     jerk limits of the velocity smoother, or the curvature the vehicle can steer.
+// Quality values are the mean over the corpus of the per-scenario maximum. A combination is on the
+// Pareto front if no other one is at least as good in latency and in every quality value; the
+// table is sorted by latency, so the first front row meeting a quality bar is the cheapest one.
+//
+// usage: smoother_pareto_benchmark [num_seeds] [num_points] [num_repetitions] [csv_path]
+
+#include "shipped_config.hpp"
+
+#include "autoware/trajectory_optimizer/optimizer_chain.hpp"
+#include "autoware/trajectory_optimizer/scenario_generator.hpp"
+
+#include <autoware_utils/system/time_keeper.hpp>
+#include <autoware_vehicle_info_utils/vehicle_info_utils.hpp>
+#include <rclcpp/rclcpp.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <exception>
+#include <limits>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+using autoware::trajectory_optimizer::OptimizerChain;
+using autoware::trajectory_optimizer::TrajectoryPoints;
+namespace benchmark = autoware::trajectory_optimizer::benchmark;
+namespace scenarios = autoware::trajectory_optimizer::scenarios;
+
+struct Configuration
+{
+  bool use_akima_spline_interpolation{false};
+  // 0 for EB off
+  double eb_delta_arc_length_m{0.0};
+  bool smooth_velocities{false};
+  // only used by the spline
+  double spline_interpolation_resolution_m{0.5};
+
+  std::string label() const
+  {
+    char eb[16] = "eb off";
+    if (eb_delta_arc_length_m > 0.0) {
+      std::snprintf(eb, sizeof(eb), "eb %.2f", eb_delta_arc_length_m);
+    }
+    char spline[16] = "no spline";
+    if (use_akima_spline_interpolation) {
+      std::snprintf(spline, sizeof(spline), "akima %.2f", spline_interpolation_resolution_m);
+    }
+    char buffer[64];
+    std::snprintf(
+      buffer, sizeof(buffer), "%-10s %-7s vel %-3s", spline, eb, smooth_velocities ? "on" : "off");
+    return buffer;
+  }
+};
+
+struct Limits
+{
+  double max_lateral_acc_mps2;
+  double min_acc_mps2;
+  double max_acc_mps2;
+  double min_jerk_mps3;
+  double max_jerk_mps3;
+  double max_curvature;
+};
+
+// lower is better for all of them
+constexpr size_t num_quality_values = 6;
+constexpr std::array<const char *, num_quality_values> quality_names{
+  "curv", "curv_rate", "lat_jerk", "lon_jerk", "deviation", "violations"};
+using Quality = std::array<double, num_quality_values>;
+
+struct Result
+{
+  Configuration configuration;
+  double latency_p50_ms{0.0};
+  double latency_p99_ms{0.0};
+  Quality quality{};
+  size_t num_failures{0};
+  bool pareto{false};
+};
+
+double percentile(std::vector<double> values, const double p)
+{
+  if (values.empty()) {
+    return std::numeric_limits<double>::quiet_NaN();
+  }
+  const auto index = static_cast<size_t>(p * static_cast<double>(values.size() - 1));
+  std::nth_element(values.begin(), values.begin() + index, values.end());
+  return values[index];
+}
+
+double get_distance_to_segment(
+  const geometry_msgs::msg::Point & p, const geometry_msgs::msg::Point & a,
+  const geometry_msgs::msg::Point & b)
+{
+  const auto dx = b.x - a.x;
+  const auto dy = b.y - a.y;
+  const auto length2 = dx * dx + dy * dy;
+  const auto t =
+    length2 > 0.0 ? std::clamp(((p.x - a.x) * dx + (p.y - a.y) * dy) / length2, 0.0, 1.0) : 0.0;
+  return std::hypot(p.x - (a.x + t * dx), p.y - (a.y + t * dy));
+}
+
+/**
+ * @brief Measures the quality of an output trajectory.
+ *
+ * @param output The output of the chain.
+ * @param reference The input of the chain, preceded by the ego history.
+ * @param limits The feasibility limits.
+ * @return The quality values, in the order of quality_names.
+ */
+Quality measure_quality(
+  const TrajectoryPoints & output, const TrajectoryPoints & reference, const Limits & limits)
+{
+  Quality quality{};
+  auto & [max_curvature, max_curvature_rate, max_lateral_jerk, max_longitudinal_jerk,
+          max_deviation, violations] = quality;
+
+  // per point, 0 at both ends
+  const auto n = output.size();
+  std::vector<double> curvatures(n, 0.0);
+  std::vector<double> intervals(n, 0.0);
+  for (size_t i = 0; i + 1 < n; ++i) {
+    const auto & a = output[i].pose.position;
+    const auto & b = output[i + 1].pose.position;
+    intervals[i] = std::hypot(b.x - a.x, b.y - a.y);
+  }
+  for (size_t i = 1; i + 1 < n; ++i) {
+    const auto & a = output[i - 1].pose.position;
+    const auto & b = output[i].pose.position;
+    const auto & c = output[i + 1].pose.position;
+    const auto denominator = intervals[i - 1] * intervals[i] * std::hypot(c.x - a.x, c.y - a.y);
+    if (denominator > 1e-9) {
+      curvatures[i] = 2.0 * ((b.x - a.x) * (c.y - b.y) - (b.y - a.y) * (c.x - b.x)) / denominator;
+    }
+  }
+
+  std::vector<double> lateral_accs(n);
+  std::vector<double> longitudinal_accs(n, 0.0);
+  for (size_t i = 0; i < n; ++i) {
+    const auto v = static_cast<double>(output[i].longitudinal_velocity_mps);
+    lateral_accs[i] = curvatures[i] * v * v;
+    if (i + 1 < n && intervals[i] > 1e-6) {
+      const auto v_next = static_cast<double>(output[i + 1].longitudinal_velocity_mps);
+      longitudinal_accs[i] = (v_next * v_next - v * v) / (2.0 * intervals[i]);
+    }
+  }
+
+  for (size_t i = 0; i < n; ++i) {
+    const auto & point = output[i];
+    max_curvature = std::max(max_curvature, std::abs(curvatures[i]));
+    bool violation = std::abs(lateral_accs[i]) > limits.max_lateral_acc_mps2 ||
+                     longitudinal_accs[i] < limits.min_acc_mps2 ||
+                     longitudinal_accs[i] > limits.max_acc_mps2 ||
+                     std::abs(curvatures[i]) > limits.max_curvature;
+    if (i + 1 < n && intervals[i] > 1e-6) {
+      const auto mean_speed = std::max(
+        std::abs(point.longitudinal_velocity_mps + output[i + 1].longitudinal_velocity_mps) / 2.0,
+        0.1);
+      const auto dt = intervals[i] / mean_speed;
+      max_curvature_rate =
+        std::max(max_curvature_rate, std::abs(curvatures[i + 1] - curvatures[i]) / intervals[i]);
+      max_lateral_jerk =
+        std::max(max_lateral_jerk, std::abs(lateral_accs[i + 1] - lateral_accs[i]) / dt);
+      const auto longitudinal_jerk = (longitudinal_accs[i + 1] - longitudinal_accs[i]) / dt;
+      max_longitudinal_jerk = std::max(max_longitudinal_jerk, std::abs(longitudinal_jerk));
+      violation = violation || longitudinal_jerk < limits.min_jerk_mps3 ||
+                  longitudinal_jerk > limits.max_jerk_mps3;
+    }
+    violations += violation ? 1.0 : 0.0;
+
+    auto deviation = std::numeric_limits<double>::max();
+    for (size_t j = 0; j + 1 < reference.size(); ++j) {
+      deviation = std::min(
+        deviation, get_distance_to_segment(
+                     point.pose.position, reference[j].pose.position,
+                     reference[j + 1].pose.position));
+    }
+    max_deviation = std::max(max_deviation, deviation);
+  }
+  return quality;
+}
+
+double get_override(rclcpp::Node & node, const std::string & name)
+{
+  // not declared here: the velocity smoother declares its parameters when it is created
+  return node.get_node_parameters_interface()->get_parameter_overrides().at(name).get<double>();
+}
+
+void mark_pareto_front(std::vector<Result> & results)
+{
+  const auto values = [](const Result & result) {
+    std::array<double, num_quality_values + 1> values{};
+    values[0] = result.latency_p50_ms;
+    std::copy(result.quality.begin(), result.quality.end(), values.begin() + 1);
+    return values;
+  };
+  for (auto & result : results) {
+    const auto a = values(result);
+    result.pareto =
+      result.num_failures == 0 &&
+      std::none_of(results.begin(), results.end(), [&](const Result & other) {
+        const auto b = values(other);
+        bool strictly_better = false;
+        for (size_t i = 0; i < a.size(); ++i) {
+          if (b[i] > a[i]) {
+            return false;
+          }
+          strictly_better = strictly_better || b[i] < a[i];
+        }
+        return other.num_failures == 0 && strictly_better;
+      });
+  }
+}
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  rclcpp::init(1, argv);
+  const size_t num_seeds = argc > 1 ? std::stoul(argv[1]) : 3;
+  const size_t num_points = argc > 2 ? std::stoul(argv[2]) : 200;
+  const size_t num_repetitions = std::max<size_t>(argc > 3 ? std::stoul(argv[3]) : 5, 1);
+  const std::string csv_path = argc > 4 ? argv[4] : "";
+
+  auto node = benchmark::create_node_with_shipped_config("smoother_pareto_benchmark");
+  const auto base_params = benchmark::read_chain_params(*node);
+  OptimizerChain chain(
+    node.get(), std::make_shared<autoware_utils_debug::TimeKeeper>(), base_params);
+  const auto vehicle_info = autoware::vehicle_info_utils::VehicleInfoUtils(*node).getVehicleInfo();
+  const Limits limits{
+    get_override(*node, "max_lateral_accel"),
+    get_override(*node, "limit.min_acc"),
+    get_override(*node, "limit.max_acc"),
+    get_override(*node, "limit.min_jerk"),
+    get_override(*node, "limit.max_jerk"),
+    std::tan(vehicle_info.max_steer_angle_rad) / vehicle_info.wheel_base_m};
+
+  // slightly noisy, as planner output
+  std::vector<scenarios::Scenario> corpus;
+  for (const auto type : scenarios::all_scenario_types()) {
+    for (size_t seed = 0; seed < num_seeds; ++seed) {
+      scenarios::ScenarioParams scenario_params;
+      scenario_params.type = type;
+      scenario_params.num_points = num_points;
+      scenario_params.defects.position_noise_stddev_m = 0.05;
+      scenario_params.defects.yaw_noise_stddev_rad = 0.01;
+      corpus.push_back(scenarios::ScenarioGenerator(seed).generate(scenario_params));
+    }
+  }
+
+  // without the spline, the resolution has no effect and is not swept
+  std::vector<std::pair<bool, double>> splines{
+    {false, base_params.spline_interpolation_resolution_m}};
+  for (const auto resolution_m : {0.25, 0.5, 1.0}) {
+    splines.emplace_back(true, resolution_m);
+  }
+  std::vector<Configuration> configurations;
+  for (const auto & [akima, resolution_m] : splines) {
+    for (const auto eb_delta_arc_length_m : {0.0, 0.5, 1.0}) {
+      for (const auto smooth_velocities : {false, true}) {
+        configurations.push_back({akima, eb_delta_arc_length_m, smooth_velocities, resolution_m});
+      }
+    }
+  }
+
+  std::vector<Result> results;
+  for (const auto & configuration : configurations) {
+    auto params = base_params;
+    params.use_akima_spline_interpolation = configuration.use_akima_spline_interpolation;
+    params.smooth_trajectories = configuration.eb_delta_arc_length_m > 0.0;
+    params.smooth_velocities = configuration.smooth_velocities;
+    params.spline_interpolation_resolution_m = configuration.spline_interpolation_resolution_m;
+    if (params.smooth_trajectories) {
+      chain.on_parameter(
+        {rclcpp::Parameter(
+          "elastic_band.common.delta_arc_length", configuration.eb_delta_arc_length_m)});
+    }
+
+    Result result;
+    result.configuration = configuration;
+    std::vector<double> latencies_ms;
+    for (const auto & scenario : corpus) {
+      params.current_odometry = scenario.odometry;
+      params.current_acceleration = scenario.acceleration;
+      params.ego_history_points = scenario.ego_history_points;
+      TrajectoryPoints points;
+      try {
+        for (size_t i = 0; i < num_repetitions; ++i) {
+          // every scenario starts without the EB warm start of the previous one
+          chain.on_parameter({});
+          points = scenario.trajectory;
+          const auto start = std::chrono::steady_clock::now();
+          chain.optimize_trajectory(points, params);
+          latencies_ms.push_back(
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+              .count());
+        }
+      } catch (const std::exception & e) {
+        std::fprintf(stderr, "%s: %s\n", configuration.label().c_str(), e.what());
+        ++result.num_failures;
+        continue;
+      }
+      auto reference = scenario.ego_history_points;
+      reference.insert(reference.end(), scenario.trajectory.begin(), scenario.trajectory.end());
+      const auto quality = measure_quality(points, reference, limits);
+      for (size_t i = 0; i < num_quality_values; ++i) {
+        result.quality[i] += quality[i] / static_cast<double>(corpus.size());
+      }
+    }
+    result.latency_p50_ms = percentile(latencies_ms, 0.5);
+    result.latency_p99_ms = percentile(latencies_ms, 0.99);
+    results.push_back(result);
+  }
+
+  mark_pareto_front(results);
+  std::sort(results.begin(), results.end(), [](const auto & a, const auto & b) {
+    return a.latency_p50_ms < b.latency_p50_ms;
+  });
+
+  std::printf(
+    "%zu scenarios of %zu points, %zu runs each; * marks the Pareto front\n", corpus.size(),
+    num_points, num_repetitions);
+  std::printf("  %-33s %8s %8s", "configuration", "p50_ms", "p99_ms");
+  for (const auto * name : quality_names) {
+    std::printf(" %10s", name);
+  }
+  std::printf(" %8s\n", "failures");
+  for (const auto & result : results) {
+    std::printf(
+      "%c %-33s %8.3f %8.3f", result.pareto ? '*' : ' ', result.configuration.label().c_str(),
+      result.latency_p50_ms, result.latency_p99_ms);
+    for (const auto value : result.quality) {
+      std::printf(" %10.4f", value);
+    }
+    std::printf(" %8zu\n", result.num_failures);
+  }
+
+  if (!csv_path.empty()) {
+    auto * file = std::fopen(csv_path.c_str(), "w");
+    if (file) {
+      std::fprintf(
+        file,
+        "akima,eb_delta_arc_length_m,smooth_velocities,spline_interpolation_resolution_m,"
+        "latency_p50_ms,latency_p99_ms");
+      for (const auto * name : quality_names) {
+        std::fprintf(file, ",%s", name);
+      }
+      std::fprintf(file, ",failures,pareto\n");
+      for (const auto & result : results) {
+        const auto & configuration = result.configuration;
+        // the resolution is left empty without the spline
+        std::fprintf(
+          file, "%d,%.2f,%d,", configuration.use_akima_spline_interpolation,
+          configuration.eb_delta_arc_length_m, configuration.smooth_velocities);
+        if (configuration.use_akima_spline_interpolation) {
+          std::fprintf(file, "%.2f", configuration.spline_interpolation_resolution_m);
+        }
+        std::fprintf(file, ",%.4f,%.4f", result.latency_p50_ms, result.latency_p99_ms);
+        for (const auto value : result.quality) {
+          std::fprintf(file, ",%.6f", value);
+        }
+        std::fprintf(file, ",%zu,%d\n", result.num_failures, result.pareto);
+      }
+      std::fclose(file);
+    }
+  }
+  rclcpp::shutdown();
+  return 0;
+}
@@ -0,0 +1,231 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Drives the optimizer with synthetic candidates and ego state at a fixed rate and measures the
+// publish-to-receive latency of its output. Candidates fan out from the ego pose with curvatures
+// spread over [-max_curvature, max_curvature]. Outputs are matched to inputs by the stamp of their
+// first candidate, which the optimizer keeps. Once the run is over, the latency distribution and
+// the number of inputs without output are written as JSON to result_path.
+
+#include <rclcpp/rclcpp.hpp>
+
+#include <autoware_new_planning_msgs/msg/trajectories.hpp>
+#include <autoware_planning_msgs/msg/trajectory.hpp>
+#include <geometry_msgs/msg/accel_with_covariance_stamped.hpp>
+#include <nav_msgs/msg/odometry.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace autoware::trajectory_optimizer::benchmark
+{
+using autoware_new_planning_msgs::msg::Trajectories;
+using autoware_planning_msgs::msg::Trajectory;
+using autoware_planning_msgs::msg::TrajectoryPoint;
+using geometry_msgs::msg::AccelWithCovarianceStamped;
+using nav_msgs::msg::Odometry;
+
+class SyntheticTrajectoryGenerator : public rclcpp::Node
+{
+public:
+  explicit SyntheticTrajectoryGenerator(const rclcpp::NodeOptions & options)
+  : Node("synthetic_trajectory_generator", options)
+  {
+    const auto rate_hz = declare_parameter<double>("rate_hz", 10.0);
+    num_candidates_ = static_cast<size_t>(declare_parameter<int64_t>("num_candidates", 8));
+    num_points_ = static_cast<size_t>(declare_parameter<int64_t>("num_points", 200));
+    point_interval_m_ = declare_parameter<double>("point_interval_m", 1.0);
+    max_curvature_ = declare_parameter<double>("max_curvature", 0.02);
+    speed_mps_ = declare_parameter<double>("speed_mps", 5.0);
+    warmup_s_ = declare_parameter<double>("warmup_s", 2.0);
+    duration_s_ = declare_parameter<double>("duration_s", 10.0);
+    result_path_ = declare_parameter<std::string>("result_path", "latency_benchmark.json");
+
+    // the optimizer polls the ego state with take(), which does not see intra-process messages
+    rclcpp::PublisherOptions inter_process_options;
+    inter_process_options.use_intra_process_comm = rclcpp::IntraProcessSetting::Disable;
+    odometry_pub_ = create_publisher<Odometry>("output/odometry", 1, inter_process_options);
+    acceleration_pub_ = create_publisher<AccelWithCovarianceStamped>(
+      "output/acceleration", 1, inter_process_options);
+    previous_trajectory_pub_ =
+      create_publisher<Trajectory>("output/previous_trajectory", 1, inter_process_options);
+    trajectories_pub_ = create_publisher<Trajectories>("output/trajectories", 1);
+    optimized_sub_ = create_subscription<Trajectories>(
+      "input/optimized_trajectories", rclcpp::QoS(10),
+      [this](const Trajectories::ConstSharedPtr msg) { on_optimized(*msg); });
+
+    start_time_ = now();
+    timer_ = rclcpp::create_timer(
+      this, get_clock(), rclcpp::Duration::from_seconds(1.0 / std::max(rate_hz, 1e-3)),
+      [this]() { on_timer(); });
+  }
+
+private:
+  std::vector<TrajectoryPoint> create_points(
+    const double x0, const double curvature, const rclcpp::Duration & offset) const
+  {
+    std::vector<TrajectoryPoint> points(num_points_);
+    for (size_t i = 0; i < num_points_; ++i) {
+      const auto s = static_cast<double>(i) * point_interval_m_;
+      const auto yaw = curvature * s;
+      auto & point = points[i];
+      if (std::abs(curvature) < 1e-9) {
+        point.pose.position.x = x0 + s;
+      } else {
+        point.pose.position.x = x0 + std::sin(yaw) / curvature;
+        point.pose.position.y = (1.0 - std::cos(yaw)) / curvature;
+      }
+      point.pose.orientation.z = std::sin(yaw / 2.0);
+      point.pose.orientation.w = std::cos(yaw / 2.0);
+      point.longitudinal_velocity_mps = static_cast<float>(speed_mps_);
+      point.time_from_start =
+        offset + rclcpp::Duration::from_seconds(s / std::max(speed_mps_, 0.1));
+    }
+    return points;
+  }
+
+  void on_timer()
+  {
+    const auto stamp = now();
+    const auto elapsed_s = (stamp - start_time_).seconds();
+    if (elapsed_s > warmup_s_ + duration_s_) {
+      timer_->cancel();
+      // outputs still in flight are given a second before the results are written
+      result_timer_ = rclcpp::create_timer(
+        this, get_clock(), rclcpp::Duration::from_seconds(1.0), [this]() {
+          result_timer_->cancel();
+          write_results();
+        });
+      return;
+    }
+    const auto ego_x = speed_mps_ * elapsed_s;
+
+    // the ego state is published ahead of the candidates that use it
+    Odometry odometry;
+    odometry.header.stamp = stamp;
+    odometry.header.frame_id = "map";
+    odometry.pose.pose.position.x = ego_x;
+    odometry.pose.pose.orientation.w = 1.0;
+    odometry.twist.twist.linear.x = speed_mps_;
+    odometry_pub_->publish(odometry);
+    AccelWithCovarianceStamped acceleration;
+    acceleration.header.stamp = stamp;
+    acceleration.header.frame_id = "base_link";
+    acceleration_pub_->publish(acceleration);
+    Trajectory previous_trajectory;
+    previous_trajectory.header = odometry.header;
+    previous_trajectory.points = create_points(ego_x, 0.0, rclcpp::Duration(0, 0));
+    previous_trajectory_pub_->publish(previous_trajectory);
+
+    auto trajectories = std::make_unique<Trajectories>();
+    trajectories->trajectories.resize(num_candidates_);
+    for (size_t i = 0; i < num_candidates_; ++i) {
+      const auto ratio =
+        num_candidates_ > 1 ? static_cast<double>(i) / static_cast<double>(num_candidates_ - 1)
+                            : 0.5;
+      auto & candidate = trajectories->trajectories[i];
+      candidate.header = odometry.header;
+      candidate.generator_id.uuid[0] = static_cast<uint8_t>(i);
+      candidate.score = 1.0 - ratio;
+      candidate.points =
+        create_points(ego_x, max_curvature_ * (2.0 * ratio - 1.0), rclcpp::Duration(0, 0));
+    }
+    if (elapsed_s >= warmup_s_) {
+      pending_stamps_.insert(stamp.nanoseconds());
+      ++num_sent_;
+    }
+    trajectories_pub_->publish(std::move(trajectories));
+  }
+
+  void on_optimized(const Trajectories & msg)
+  {
+    const auto receive_time = now();
+    if (msg.trajectories.empty()) {
+      return;
+    }
+    const rclcpp::Time stamp(msg.trajectories.front().header.stamp, receive_time.get_clock_type());
+    // outputs of the warm up are not in the set
+    if (pending_stamps_.erase(stamp.nanoseconds()) == 0) {
+      return;
+    }
+    latencies_ms_.push_back((receive_time - stamp).seconds() * 1e3);
+  }
+
+  void write_results()
+  {
+    std::sort(latencies_ms_.begin(), latencies_ms_.end());
+    const auto percentile = [this](const double p) {
+      if (latencies_ms_.empty()) {
+        return 0.0;
+      }
+      return latencies_ms_[static_cast<size_t>(p * static_cast<double>(latencies_ms_.size() - 1))];
+    };
+    double sum = 0.0;
+    for (const auto latency : latencies_ms_) {
+      sum += latency;
+    }
+    const auto mean = latencies_ms_.empty() ? 0.0 : sum / static_cast<double>(latencies_ms_.size());
+
+    // written aside and renamed, so that the results appear complete or not at all
+    const auto temporary_path = result_path_ + ".tmp";
+    {
+      std::ofstream file(temporary_path);
+      file << "{\"sent\": " << num_sent_ << ", \"received\": " << latencies_ms_.size()
+           << ", \"dropped\": " << pending_stamps_.size()
+           << ", \"latency_ms\": {\"mean\": " << mean << ", \"p50\": " << percentile(0.5)
+           << ", \"p90\": " << percentile(0.9) << ", \"p99\": " << percentile(0.99)
+           << ", \"max\": " << percentile(1.0) << "}}\n";
+    }
+    std::filesystem::rename(temporary_path, result_path_);
+    RCLCPP_INFO(
+      get_logger(), "sent %zu, received %zu, latency mean %.2f ms, p99 %.2f ms, results in %s",
+      num_sent_, latencies_ms_.size(), mean, percentile(0.99), result_path_.c_str());
+  }
+
+  size_t num_candidates_;
+  size_t num_points_;
+  double point_interval_m_;
+  double max_curvature_;
+  double speed_mps_;
+  double warmup_s_;
+  double duration_s_;
+  std::string result_path_;
+
+  rclcpp::Publisher<Odometry>::SharedPtr odometry_pub_;
+  rclcpp::Publisher<AccelWithCovarianceStamped>::SharedPtr acceleration_pub_;
+  rclcpp::Publisher<Trajectory>::SharedPtr previous_trajectory_pub_;
+  rclcpp::Publisher<Trajectories>::SharedPtr trajectories_pub_;
+  rclcpp::Subscription<Trajectories>::SharedPtr optimized_sub_;
+  rclcpp::TimerBase::SharedPtr timer_;
+  rclcpp::TimerBase::SharedPtr result_timer_;
+
+  rclcpp::Time start_time_;
+  // stamps of the measured inputs whose output has not been received yet
+  std::unordered_set<int64_t> pending_stamps_;
+  size_t num_sent_{0};
+  std::vector<double> latencies_ms_;
+};
+}  // namespace autoware::trajectory_optimizer::benchmark
+
+#include <rclcpp_components/register_node_macro.hpp>
+RCLCPP_COMPONENTS_REGISTER_NODE(
+  autoware::trajectory_optimizer::benchmark::SyntheticTrajectoryGenerator)
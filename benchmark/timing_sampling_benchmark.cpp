@@ -0,0 +1,164 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Measures the cost of the processing time detail on the optimizer chain, configured as shipped:
+// every candidate of a cycle is optimized by the chain, with the detail recorded on every cycle,
+// on one in N cycles, or never. As in the node, a sampled cycle opens the root scope, each
+// candidate a scope under it and the chain a scope per stage, and the tree is published on a real
+// publisher.
+// The modes take turns over several rounds and the median round is reported, so that drift of the
+// machine and of the smoothers' warm starts does not favour one of them.
+//
+// The defaults are the 64-candidate workload and the shipped profiling.sample_period; pass a
+// larger sample_period to see what sampling saves.
+//
+// usage: timing_sampling_benchmark [num_cycles] [num_candidates] [num_points] [sample_period]
+//                                  [num_rounds]
+
+#include "shipped_config.hpp"
+
+#include "autoware/trajectory_optimizer/optimizer_chain.hpp"
+#include "autoware/trajectory_optimizer/scenario_generator.hpp"
+#include "autoware/trajectory_optimizer/timing_sampler.hpp"
+
+#include <autoware_utils/system/time_keeper.hpp>
+#include <rclcpp/rclcpp.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace
+{
+using autoware::trajectory_optimizer::OptimizerChain;
+using autoware::trajectory_optimizer::TimingSampler;
+using autoware::trajectory_optimizer::TrajectoryOptimizerParams;
+namespace benchmark = autoware::trajectory_optimizer::benchmark;
+namespace scenarios = autoware::trajectory_optimizer::scenarios;
+
+// the overhead budget of the sampled detail
+constexpr double target_overhead_percent = 1.0;
+
+/**
+ * @brief Runs every candidate of num_cycles cycles through the chain.
+ * @param sample_period 1 in sample_period cycles records the detail, 0 none.
+ * @return The mean time per cycle in microseconds.
+ */
+double run(
+  OptimizerChain & chain, const TrajectoryOptimizerParams & base_params,
+  const std::vector<scenarios::Scenario> & candidates, const size_t num_cycles,
+  const size_t sample_period, autoware_utils::TimeKeeper & time_keeper)
+{
+  TimingSampler sampler(sample_period);
+  auto params = base_params;
+
+  const auto start = std::chrono::steady_clock::now();
+  for (size_t cycle = 0; cycle < num_cycles; ++cycle) {
+    params.detailed_timing = sampler.sample_cycle();
+    // same scopes as TrajectoryInterpolator::run_cycle() and optimize_candidate()
+    std::optional<autoware_utils::ScopedTimeTrack> cycle_track;
+    if (params.detailed_timing) {
+      cycle_track.emplace("run_cycle", time_keeper);
+    }
+    for (const auto & candidate : candidates) {
+      std::optional<autoware_utils::ScopedTimeTrack> candidate_track;
+      if (params.detailed_timing) {
+        candidate_track.emplace("optimize_candidate", time_keeper);
+      }
+      params.current_odometry = candidate.odometry;
+      params.current_acceleration = candidate.acceleration;
+      params.ego_history_points = candidate.ego_history_points;
+      auto points = candidate.trajectory;
+      chain.optimize_trajectory(points, params);
+    }
+  }
+  return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start)
+           .count() /
+         static_cast<double>(num_cycles);
+}
+
+double median(std::vector<double> values)
+{
+  std::nth_element(values.begin(), values.begin() + values.size() / 2, values.end());
+  return values[values.size() / 2];
+}
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  rclcpp::init(1, argv);
+  const size_t num_cycles = argc > 1 ? std::stoul(argv[1]) : 100;
+  const size_t num_candidates = argc > 2 ? std::stoul(argv[2]) : 64;
+  const size_t num_points = argc > 3 ? std::stoul(argv[3]) : 200;
+  const size_t num_rounds = std::max<size_t>(argc > 5 ? std::stoul(argv[5]) : 5, 1);
+
+  auto node = benchmark::create_node_with_shipped_config("timing_sampling_benchmark");
+  const size_t sample_period =
+    argc > 4 ? std::stoul(argv[4])
+             : static_cast<size_t>(std::max<int64_t>(
+                 autoware_utils::get_or_declare_parameter<int64_t>(
+                   *node, "profiling.sample_period"),
+                 0));
+  const auto params = benchmark::read_chain_params(*node);
+  auto time_keeper = std::make_shared<autoware_utils::TimeKeeper>(
+    node->create_publisher<autoware_utils::ProcessingTimeDetail>(
+      "~/debug/processing_time_detail_ms", 1));
+  OptimizerChain chain(node.get(), time_keeper, params);
+
+  // the candidates cycle through the scenario types
+  scenarios::ScenarioGenerator generator;
+  std::vector<scenarios::Scenario> candidates;
+  for (size_t i = 0; i < num_candidates; ++i) {
+    scenarios::ScenarioParams scenario_params;
+    const auto & types = scenarios::all_scenario_types();
+    scenario_params.type = types[i % types.size()];
+    scenario_params.num_points = num_points;
+    scenario_params.point_interval_m = 0.5;
+    candidates.push_back(generator.generate(scenario_params));
+  }
+
+  // warm up caches, the allocator and the smoothers before measuring
+  run(chain, params, candidates, 10, 1, *time_keeper);
+  std::vector<double> baseline_us;
+  std::vector<double> full_us;
+  std::vector<double> sampled_us;
+  for (size_t round = 0; round < num_rounds; ++round) {
+    baseline_us.push_back(run(chain, params, candidates, num_cycles, 0, *time_keeper));
+    full_us.push_back(run(chain, params, candidates, num_cycles, 1, *time_keeper));
+    sampled_us.push_back(run(chain, params, candidates, num_cycles, sample_period, *time_keeper));
+  }
+
+  const auto baseline = median(baseline_us);
+  const auto overhead = [baseline](const double us) { return 100.0 * (us - baseline) / baseline; };
+  const auto full = median(full_us);
+  const auto sampled = median(sampled_us);
+  std::printf(
+    "%zu cycles of %zu candidates x %zu points, median of %zu rounds\n", num_cycles,
+    num_candidates, num_points, num_rounds);
+  std::printf("no detail        %10.1f us/cycle\n", baseline);
+  std::printf(
+    "every cycle      %10.1f us/cycle, ratio %.4f, overhead %+.2f %%\n", full, full / baseline,
+    overhead(full));
+  std::printf(
+    "1 in %-4zu cycles %10.1f us/cycle, ratio %.4f, overhead %+.2f %% (target < %.0f %%: %s)\n",
+    sample_period, sampled, sampled / baseline, overhead(sampled), target_overhead_percent,
+    overhead(sampled) < target_overhead_percent ? "met" : "missed");
+  rclcpp::shutdown();
+  return 0;
+}
@@ -0,0 +1,48 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__TRAJECTORY_OPTIMIZER_BOUNDED_TRAJECTORIES_HPP_
+#define AUTOWARE__TRAJECTORY_OPTIMIZER_BOUNDED_TRAJECTORIES_HPP_
+
+#include "autoware_trajectory_optimizer/msg/bounded_trajectories.hpp"
+
+#include <autoware_new_planning_msgs/msg/trajectories.hpp>
+
+namespace autoware::trajectory_optimizer
+{
+using autoware_new_planning_msgs::msg::Trajectories;
+using autoware_trajectory_optimizer::msg::BoundedTrajectories;
+
+/**
+ * @brief Copies trajectories into the fixed-size message.
+ * @details Candidates, points and generator info beyond the capacity of the bounded message are
+ * dropped, and frame ids and generator names that do not fit are cut.
+ *
+ * @param trajectories The trajectories to be converted.
+ * @param bounded_trajectories Output message, e.g. a loaned one. Only the valid entries are
+ * written.
+ * @return False if anything had to be truncated.
+ */
+bool to_bounded(const Trajectories & trajectories, BoundedTrajectories & bounded_trajectories);
+
+/**
+ * @brief Copies the valid entries of the fixed-size message into trajectories.
+ *
+ * @param bounded_trajectories The message to be converted.
+ * @param trajectories Output trajectories; their point buffers are reused.
+ */
+void from_bounded(const BoundedTrajectories & bounded_trajectories, Trajectories & trajectories);
+}  // namespace autoware::trajectory_optimizer
+
+#endif  // AUTOWARE__TRAJECTORY_OPTIMIZER_BOUNDED_TRAJECTORIES_HPP_
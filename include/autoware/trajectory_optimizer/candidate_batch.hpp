@@ -0,0 +1,131 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__TRAJECTORY_OPTIMIZER_CANDIDATE_BATCH_HPP_
+#define AUTOWARE__TRAJECTORY_OPTIMIZER_CANDIDATE_BATCH_HPP_
+
+#include <autoware_new_planning_msgs/msg/trajectory.hpp>
+#include <autoware_planning_msgs/msg/trajectory_point.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace autoware::trajectory_optimizer
+{
+using autoware_planning_msgs::msg::TrajectoryPoint;
+using NewTrajectory = autoware_new_planning_msgs::msg::Trajectory;
+
+/**
+ * @brief Points of every candidate of a cycle packed into one contiguous buffer.
+ * @details Candidate i holds the points [offsets()[i], offsets()[i + 1]) of the buffer, as in the
+ * compressed sparse row layout. Element-wise work then runs as one loop over all candidates instead
+ * of one loop per candidate allocation, which pays off for many short candidates. The buffers are
+ * kept between cycles, so steady-state cycles do not allocate.
+ */
+class CandidateBatch
+{
+public:
+  /**
+   * @brief Packs the points of the trajectories, replacing the previous content.
+   *
+   * @param trajectories The candidates.
+   */
+  void assign(const std::vector<NewTrajectory> & trajectories);
+
+  /**
+   * @brief Copies the points of each candidate back into its trajectory, reusing its buffer.
+   *
+   * @param trajectories The candidates the batch was assigned from; only their points are written.
+   */
+  void copy_to(std::vector<NewTrajectory> & trajectories) const;
+
+  size_t num_candidates() const { return offsets_.size() - 1; }
+  size_t num_points() const { return points_.size(); }
+  const std::vector<size_t> & offsets() const { return offsets_; }
+  TrajectoryPoint * data() { return points_.data(); }
+  const TrajectoryPoint * data() const { return points_.data(); }
+
+  /**
+   * @brief Gets the number of points of a candidate.
+   *
+   * @param candidate The candidate index.
+   * @return The number of points.
+   */
+  size_t size(const size_t candidate) const
+  {
+    return offsets_[candidate + 1] - offsets_[candidate];
+  }
+
+  /**
+   * @brief Erases the points matching a predicate, keeping the order of the others.
+   *
+   * @param predicate Called on every point in order, returns true to erase it. It may modify the
+   * point.
+   */
+  template <typename Predicate>
+  void erase_if(Predicate && predicate)
+  {
+    size_t num_kept = 0;
+    size_t begin = 0;
+    for (size_t candidate = 0; candidate < num_candidates(); ++candidate) {
+      const size_t end = offsets_[candidate + 1];
+      for (size_t i = begin; i < end; ++i) {
+        if (predicate(points_[i])) {
+          continue;
+        }
+        if (num_kept != i) {
+          points_[num_kept] = std::move(points_[i]);
+        }
+        ++num_kept;
+      }
+      offsets_[candidate + 1] = num_kept;
+      begin = end;
+    }
+    points_.resize(num_kept);
+  }
+
+  /**
+   * @brief Removes the points with nan or inf values, as utils::validate_point.
+   * @details Unlike utils::remove_invalid_points, close points and points of invalid orientation
+   * are kept.
+   */
+  void remove_non_finite_points();
+
+  /**
+   * @brief Raises the velocity and acceleration of every point to a minimum, as
+   * utils::clamp_velocities.
+   *
+   * @param min_velocity The minimum velocity.
+   * @param min_acceleration The minimum acceleration.
+   */
+  void clamp_velocities(const float min_velocity, const float min_acceleration);
+
+  /**
+   * @brief Caps the velocity of every point, as utils::set_max_velocity.
+   *
+   * @param max_velocity The maximum velocity.
+   */
+  void set_max_velocity(const float max_velocity);
+
+private:
+  std::vector<TrajectoryPoint> points_;
+  std::vector<size_t> offsets_{0};
+  // scratch of remove_non_finite_points
+  std::vector<uint8_t> flags_;
+};
+}  // namespace autoware::trajectory_optimizer
+
+#endif  // AUTOWARE__TRAJECTORY_OPTIMIZER_CANDIDATE_BATCH_HPP_
@@ -0,0 +1,92 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__TRAJECTORY_OPTIMIZER_CANDIDATE_CLUSTERING_HPP_
+#define AUTOWARE__TRAJECTORY_OPTIMIZER_CANDIDATE_CLUSTERING_HPP_
+
+#include <autoware_new_planning_msgs/msg/trajectory.hpp>
+#include <autoware_planning_msgs/msg/trajectory_point.hpp>
+
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace autoware::trajectory_optimizer
+{
+using autoware_planning_msgs::msg::TrajectoryPoint;
+using NewTrajectory = autoware_new_planning_msgs::msg::Trajectory;
+
+/**
+ * @brief Largest distance of the points of either path to the other path, in the x-y plane.
+ * @details Each point is compared with the nearest segment found by walking forward along the
+ * other path from the segment of the previous point, so the cost is linear in the number of points.
+ * On a path that folds back onto itself the walk may stop at a farther segment: the result is then
+ * larger than the exact distance, never smaller, so near-identical paths may be missed but distinct
+ * ones are never taken for near-identical.
+ *
+ * @param a The points of the first path.
+ * @param b The points of the second path.
+ * @param bound The comparison stops as soon as a distance exceeds it.
+ * @return The largest distance, or a value larger than bound if the comparison stopped early;
+ * infinity if either path is empty.
+ */
+double compute_max_deviation(
+  const std::vector<TrajectoryPoint> & a, const std::vector<TrajectoryPoint> & b,
+  const double bound = std::numeric_limits<double>::infinity());
+
+/**
+ * @brief Grouping of the candidates of a cycle into bundles of near-identical paths.
+ * @details The buffer is kept by the caller so steady-state cycles do not allocate.
+ */
+struct CandidateClusters
+{
+  // index of the representative of each candidate, its own index for a representative
+  std::vector<size_t> representative_of;
+  size_t num_clusters{0};
+
+  bool is_representative(const size_t index) const { return representative_of[index] == index; }
+};
+
+/**
+ * @brief Groups the candidates whose paths are within a tolerance of each other.
+ * @details Greedy, in input order: a candidate joins the first representative within tolerance_m
+ * of it, or becomes a representative. Generators emit their best candidates first, so the
+ * representative of a cluster is its best candidate, and members always come after it. Candidates
+ * of fewer than two points are never grouped.
+ *
+ * @param candidates The candidates of the cycle, before optimization.
+ * @param tolerance_m The largest compute_max_deviation between a member and its representative.
+ * @param clusters Output, sized to the candidates.
+ */
+void cluster_candidates(
+  const std::vector<NewTrajectory> & candidates, const double tolerance_m,
+  CandidateClusters & clusters);
+
+/**
+ * @brief Replaces the path of a cluster member with the optimized path of its representative,
+ * keeping the member's own velocity profile.
+ * @details The output has the points of the representative. Each of them takes the longitudinal
+ * and lateral velocity and the acceleration of the member interpolated at its projection on the
+ * member's path. Points before the start of the member's path, such as the ego history the chain
+ * prepends, keep the values of the representative. Velocity limits and time_from_start are left
+ * to the caller. The points are written in place, reusing the member's buffer.
+ *
+ * @param representative The optimized points of the representative.
+ * @param member The points of the member before optimization, replaced by the output.
+ */
+void project_onto_representative(
+  const std::vector<TrajectoryPoint> & representative, std::vector<TrajectoryPoint> & member);
+}  // namespace autoware::trajectory_optimizer
+
+#endif  // AUTOWARE__TRAJECTORY_OPTIMIZER_CANDIDATE_CLUSTERING_HPP_
@@ -0,0 +1,196 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__TRAJECTORY_OPTIMIZER_COST_MODEL_HPP_
+#define AUTOWARE__TRAJECTORY_OPTIMIZER_COST_MODEL_HPP_
+
+#include <autoware_new_planning_msgs/msg/trajectory.hpp>
+#include <autoware_planning_msgs/msg/trajectory_point.hpp>
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace autoware::trajectory_optimizer
+{
+using autoware_planning_msgs::msg::TrajectoryPoint;
+using NewTrajectory = autoware_new_planning_msgs::msg::Trajectory;
+
+/**
+ * @brief Shape of a candidate, from which its optimization time is predicted.
+ */
+struct CandidateFeatures
+{
+  size_t num_points{0};
+  double arc_length_m{0.0};
+  // sum of the absolute heading changes between consecutive segments
+  double total_turning_rad{0.0};
+  // largest heading change over the length of the segments around it, up to max_curvature_cap
+  double max_curvature{0.0};
+
+  static constexpr double max_curvature_cap = 10.0;
+};
+
+/**
+ * @brief Computes the features of a candidate in one pass over its points.
+ * @details Segments shorter than 1 mm are skipped for the heading, so duplicated points do not
+ * turn the curvature into noise.
+ *
+ * @param points The points of the candidate.
+ * @return The features.
+ */
+CandidateFeatures compute_candidate_features(const std::vector<TrajectoryPoint> & points);
+
+/**
+ * @brief Linear model of a cost from candidate features, fitted online by exponentially weighted
+ * least squares.
+ * @details The cost is modeled as w0 + w1 * num_points + w2 * arc_length + w3 * turning
+ * + w4 * max_curvature, with the features scaled to similar magnitudes. Forgetting lets the model
+ * follow parameter changes, e.g. a smoother being enabled at runtime. The weighted normal
+ * equations are kept and solved with a small ridge term at every update, so the features a
+ * workload does not vary, e.g. the curvature of straight candidates only, stay well-posed instead
+ * of winding up as in plain recursive least squares.
+ */
+class OnlineCostRegression
+{
+public:
+  static constexpr size_t num_terms = 5;
+
+  /**
+   * @param forgetting_factor Weight of the past samples at every update, in (0, 1].
+   */
+  explicit OnlineCostRegression(const double forgetting_factor = 0.99);
+
+  /**
+   * @brief Predicts the cost of a candidate.
+   *
+   * @param features The features of the candidate.
+   * @return The predicted cost, at least 0; 0 until the first update.
+   */
+  double predict(const CandidateFeatures & features) const;
+
+  /**
+   * @brief Fits the model to one measured cost.
+   *
+   * @param features The features of the candidate.
+   * @param cost The measured cost.
+   */
+  void update(const CandidateFeatures & features, const double cost);
+
+  size_t num_samples() const { return num_samples_; }
+
+private:
+  using Terms = std::array<double, num_terms>;
+  static Terms to_terms(const CandidateFeatures & features);
+
+  double forgetting_factor_;
+  Terms weights_{};
+  // weighted sums of x x^T and of x * cost
+  std::array<Terms, num_terms> information_{};
+  Terms moments_{};
+  size_t num_samples_{0};
+};
+
+/**
+ * @brief Features, predicted and measured times and dispatch order of the candidates of a cycle.
+ * @details Kept by the caller so steady-state cycles do not allocate. actual_ms is written by the
+ * thread optimizing each candidate.
+ */
+struct CandidateSchedule
+{
+  std::vector<CandidateFeatures> features;
+  std::vector<double> predicted_ms;
+  std::vector<double> actual_ms;
+  // candidate indices, longest predicted first
+  std::vector<size_t> order;
+};
+
+/**
+ * @brief Online model of the optimization time of a candidate, one regression per chain stage.
+ * @details The predicted time of a candidate is the sum of the stage predictions. Stages are
+ * learned separately since they scale with different features: the point fixer with the number
+ * of points, the smoothers with the length and the curvature. Thread-safe, updates come from the
+ * worker threads.
+ */
+class CandidateCostModel
+{
+public:
+  /**
+   * @param forgetting_factor Forgetting factor of every stage regression, in (0, 1].
+   */
+  explicit CandidateCostModel(const double forgetting_factor);
+
+  /**
+   * @brief Predicts the optimization time of a candidate.
+   *
+   * @param features The features of the candidate.
+   * @return The predicted time in milliseconds, 0 before any update.
+   */
+  double predict_ms(const CandidateFeatures & features) const;
+
+  /**
+   * @brief Fits the model of a stage to the time it took on a candidate.
+   *
+   * @param stage The stage name.
+   * @param features The features of the candidate.
+   * @param elapsed_ms The wall time of the stage.
+   */
+  void update(
+    const std::string_view stage, const CandidateFeatures & features, const double elapsed_ms);
+
+  /**
+   * @brief Computes the features and predicted time of every candidate and orders them longest
+   * predicted first.
+   * @details Dispatched in this order onto workers that each take the next candidate when they
+   * become idle, this is the longest processing time first list schedule, whose makespan is
+   * within 4/3 of the optimum for exact times. Equal predictions keep the input order.
+   *
+   * @param candidates The candidates of the cycle, before optimization.
+   * @param schedule Output, sized to the candidates; actual_ms is reset to NaN.
+   */
+  void schedule(const std::vector<NewTrajectory> & candidates, CandidateSchedule & schedule) const;
+
+private:
+  double forgetting_factor_;
+  mutable std::mutex mutex_;
+  std::map<std::string, OnlineCostRegression, std::less<>> stages_;
+};
+
+/**
+ * @brief Sorts candidate indices by decreasing cost, keeping the input order of equal costs.
+ *
+ * @param costs The cost of each candidate.
+ * @param order Output, the candidate indices.
+ */
+void order_longest_first(const std::vector<double> & costs, std::vector<size_t> & order);
+
+/**
+ * @brief Makespan of a list schedule: each task in order goes to the worker that becomes idle
+ * first.
+ *
+ * @param costs The cost of each task.
+ * @param order The dispatch order.
+ * @param num_workers The number of workers, at least 1.
+ * @return The time the last worker finishes.
+ */
+double list_schedule_makespan(
+  const std::vector<double> & costs, const std::vector<size_t> & order, const size_t num_workers);
+}  // namespace autoware::trajectory_optimizer
+
+#endif  // AUTOWARE__TRAJECTORY_OPTIMIZER_COST_MODEL_HPP_
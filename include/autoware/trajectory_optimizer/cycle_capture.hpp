@@ -0,0 +1,215 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__TRAJECTORY_OPTIMIZER_CYCLE_CAPTURE_HPP_
+#define AUTOWARE__TRAJECTORY_OPTIMIZER_CYCLE_CAPTURE_HPP_
+
+#include <rclcpp/logger.hpp>
+#include <rclcpp/parameter.hpp>
+#include <rclcpp/serialized_message.hpp>
+#include <rclcpp/time.hpp>
+
+#include <autoware_new_planning_msgs/msg/trajectories.hpp>
+#include <autoware_planning_msgs/msg/trajectory.hpp>
+#include <autoware_planning_msgs/msg/trajectory_point.hpp>
+#include <geometry_msgs/msg/accel_with_covariance_stamped.hpp>
+#include <nav_msgs/msg/odometry.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace autoware::trajectory_optimizer
+{
+
+/**
+ * @brief Per-stage wall time of the cycles of one stream. Thread-safe.
+ */
+class StageTimings
+{
+public:
+  struct StageTime
+  {
+    uint64_t calls{0};
+    double total_ms{0.0};
+  };
+
+  void add(const std::string_view stage, const double elapsed_ms);
+
+  /**
+   * @brief Adds the calls and time of a stage accumulated elsewhere.
+   *
+   * @param stage The stage name.
+   * @param time The calls and time to be added.
+   */
+  void add(const std::string_view stage, const StageTime & time);
+
+  /**
+   * @brief Calls visitor(stage, time) for every stage called since the last call and starts
+   * over, without allocating once every stage has been seen.
+   *
+   * @param visitor Called under the lock, must not use the timings.
+   */
+  template <typename Visitor>
+  void take_each(Visitor && visitor)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto & [stage, time] : stages_) {
+      if (time.calls > 0) {
+        visitor(std::string_view(stage), time);
+        time = StageTime{};
+      }
+    }
+  }
+
+  /**
+   * @brief Gets the times accumulated since the last call and starts over.
+   *
+   * @return The time of each stage, sorted by stage name.
+   */
+  std::vector<std::pair<std::string, StageTime>> take();
+
+private:
+  std::mutex mutex_;
+  std::map<std::string, StageTime, std::less<>> stages_;
+};
+
+/**
+ * @brief Adds its lifetime to a stage of the timings. Does nothing if the timings are null.
+ */
+class ScopedStageTimer
+{
+public:
+  ScopedStageTimer(StageTimings * timings, const std::string_view stage);
+  ~ScopedStageTimer();
+  ScopedStageTimer(const ScopedStageTimer &) = delete;
+  ScopedStageTimer & operator=(const ScopedStageTimer &) = delete;
+
+private:
+  StageTimings * timings_;
+  std::string_view stage_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+/**
+ * @brief Everything needed to run one cycle again offline.
+ */
+struct CycleCapture
+{
+  // fully qualified prefix of the stream's topics, e.g. /planning/trajectory_optimizer/
+  std::string topic_prefix;
+  uint64_t cycle_id{0};
+  rclcpp::Time stamp;
+  double processing_time_ms{0.0};
+  // the candidates the chain optimized, i.e. the selected ones with lazy deserialization
+  autoware_new_planning_msgs::msg::Trajectories trajectories;
+  // lazy deserialization: the message as received, before selection
+  std::optional<rclcpp::SerializedMessage> serialized_trajectories;
+  nav_msgs::msg::Odometry odometry;
+  geometry_msgs::msg::AccelWithCovarianceStamped acceleration;
+  std::optional<autoware_planning_msgs::msg::Trajectory> previous_trajectory;
+  // past ego states of the backward extension, oldest first, built by the node from the odometry
+  // of earlier cycles
+  std::vector<autoware_planning_msgs::msg::TrajectoryPoint> ego_history_points;
+  std::vector<rclcpp::Parameter> parameters;
+  std::vector<std::pair<std::string, StageTimings::StageTime>> stage_timings;
+};
+
+struct CycleCaptureParams
+{
+  double threshold_ms{100.0};
+  std::string directory;
+  double min_interval_s{10.0};
+  // 0 for no limit
+  size_t max_captures{20};
+};
+
+/**
+ * @brief Writes the inputs of slow cycles to disk, on a background thread.
+ * @details Each capture is a directory holding a rosbag2 bag of the cycle inputs, a
+ * parameters.yaml that can be passed as --params-file, and a timings.yaml with the processing time
+ * and the per-stage times of the cycle. The bag has the inputs on the node's topics, and all of
+ * them, with the ego history, in one OptimizeTrajectories request on debug/cycle_request. Playing
+ * the bag into a node started with the captured parameters runs the cycle again, but on the ego
+ * history of that node; sending the request to its ~/optimize_trajectories service runs the
+ * captured candidates on the captured ego history.
+ */
+class SlowCycleRecorder
+{
+public:
+  SlowCycleRecorder(
+    const CycleCaptureParams & params, const std::string & node_name,
+    const rclcpp::Logger & logger);
+  ~SlowCycleRecorder();
+  SlowCycleRecorder(const SlowCycleRecorder &) = delete;
+  SlowCycleRecorder & operator=(const SlowCycleRecorder &) = delete;
+
+  /**
+   * @brief Checks whether a cycle is slow enough and the rate limit allows capturing it, in which
+   * case it is counted against the limit.
+   *
+   * @param processing_time_ms The processing time of the cycle.
+   * @param now The current time.
+   * @return True if the cycle should be captured.
+   */
+  bool should_capture(
+    const double processing_time_ms, const std::chrono::steady_clock::time_point now);
+
+  /**
+   * @brief Queues a capture to be written by the background thread.
+   *
+   * @param capture The capture to be written.
+   */
+  void record(CycleCapture capture);
+
+  /**
+   * @brief Writes a capture.
+   *
+   * @param capture The capture to be written.
+   * @param directory The directory the capture directory is created in.
+   * @param node_name The fully qualified node name the parameters are written for.
+   * @return The path of the capture directory.
+   * @throws std::exception if the capture could not be written.
+   */
+  static std::string write_capture(
+    const CycleCapture & capture, const std::string & directory, const std::string & node_name);
+
+private:
+  void run();
+
+  CycleCaptureParams params_;
+  std::string node_name_;
+  rclcpp::Logger logger_;
+
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  std::deque<CycleCapture> queue_;
+  std::optional<std::chrono::steady_clock::time_point> last_capture_time_;
+  size_t num_captures_{0};
+  bool stop_{false};
+  std::thread thread_;
+};
+}  // namespace autoware::trajectory_optimizer
+
+#endif  // AUTOWARE__TRAJECTORY_OPTIMIZER_CYCLE_CAPTURE_HPP_
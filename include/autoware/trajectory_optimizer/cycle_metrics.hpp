@@ -0,0 +1,78 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__TRAJECTORY_OPTIMIZER_CYCLE_METRICS_HPP_
+#define AUTOWARE__TRAJECTORY_OPTIMIZER_CYCLE_METRICS_HPP_
+
+#include "autoware_trajectory_optimizer/msg/cycle_metrics.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <string>
+#include <utility>
+
+namespace autoware::trajectory_optimizer
+{
+using autoware_trajectory_optimizer::msg::CycleMetrics;
+
+/**
+ * @brief Cycle and candidate rates over a sliding time window.
+ */
+class ThroughputMeter
+{
+public:
+  explicit ThroughputMeter(const double window_s = 1.0) : window_s_(window_s) {}
+
+  /**
+   * @brief Records a cycle and drops the cycles that left the window.
+   *
+   * @param now The time the cycle completed.
+   * @param num_candidates The number of candidates the cycle output.
+   */
+  void add(const std::chrono::steady_clock::time_point now, const size_t num_candidates);
+
+  // rates over the whole window, so they ramp up during the first window
+  double cycles_per_second() const;
+  double candidates_per_second() const;
+
+private:
+  double window_s_;
+  std::deque<std::pair<std::chrono::steady_clock::time_point, size_t>> cycles_;
+  size_t num_candidates_{0};
+};
+
+/**
+ * @brief Upper bounds of the cycle metrics, 0 disables a bound.
+ */
+struct CycleMetricsThresholds
+{
+  double max_input_age_ms{0.0};
+  double max_ego_state_age_ms{0.0};
+  double max_queueing_delay_ms{0.0};
+  double max_processing_time_ms{0.0};
+  double max_output_age_ms{0.0};
+};
+
+/**
+ * @brief Sets the level and message of the metrics from the thresholds they exceed.
+ *
+ * @param thresholds The thresholds.
+ * @param metrics The metrics of a cycle, updated in place.
+ * @return True if any threshold was exceeded.
+ */
+bool apply_thresholds(const CycleMetricsThresholds & thresholds, CycleMetrics & metrics);
+}  // namespace autoware::trajectory_optimizer
+
+#endif  // AUTOWARE__TRAJECTORY_OPTIMIZER_CYCLE_METRICS_HPP_
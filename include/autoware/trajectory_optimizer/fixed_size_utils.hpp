@@ -0,0 +1,179 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__TRAJECTORY_OPTIMIZER_FIXED_SIZE_UTILS_HPP_
+#define AUTOWARE__TRAJECTORY_OPTIMIZER_FIXED_SIZE_UTILS_HPP_
+
+#include <autoware_planning_msgs/msg/trajectory_point.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// point counts of the fixed-size generators, largest first, set with the CMake cache variable of
+// the same name
+#ifndef TRAJECTORY_OPTIMIZER_FIXED_TRAJECTORY_SIZES
+#define TRAJECTORY_OPTIMIZER_FIXED_TRAJECTORY_SIZES 80
+#endif
+
+/**
+ * @brief Specializations of the utils for trajectories of a point count known at compile time.
+ * @details Learned-model generators emit candidates with a fixed number of points. The loops below
+ * run over a view of exactly N points, so the compiler unrolls and vectorizes them without bounds
+ * or size checks. The extender prepends the ego history to the candidates, so the view is the last
+ * N points, i.e. the generator's points, and the few points before it take the dynamic path.
+ * Trajectories shorter than every configured size take the dynamic path only.
+ */
+namespace autoware::trajectory_optimizer::utils::fixed_size
+{
+using autoware_planning_msgs::msg::TrajectoryPoint;
+using TrajectoryPoints = std::vector<TrajectoryPoint>;
+using Sizes = std::index_sequence<TRAJECTORY_OPTIMIZER_FIXED_TRAJECTORY_SIZES>;
+
+/**
+ * @brief View of N consecutive points, N known at compile time.
+ */
+template <size_t N, typename Point>
+class PointsView
+{
+public:
+  explicit PointsView(Point * data) : data_(data) {}
+
+  static constexpr size_t size() { return N; }
+  Point & operator[](const size_t i) const { return data_[i]; }
+  Point * begin() const { return data_; }
+  Point * end() const { return data_ + N; }
+
+private:
+  Point * data_;
+};
+
+/**
+ * @brief Calls fixed(head_size, tail) with a view of the last N points for the first of the sizes
+ * that fits in the points, or dynamic() if none does.
+ *
+ * @param data The points.
+ * @param size The number of points.
+ * @param fixed Called with the number of points before the view and the view.
+ * @param dynamic Called if every size is larger than the number of points.
+ */
+template <typename Point, typename Fixed, typename Dynamic>
+void visit_tail(
+  [[maybe_unused]] Point * data, [[maybe_unused]] const size_t size, std::index_sequence<>,
+  [[maybe_unused]] Fixed && fixed, Dynamic && dynamic)
+{
+  dynamic();
+}
+
+template <typename Point, typename Fixed, typename Dynamic, size_t N, size_t... Ns>
+void visit_tail(
+  Point * data, const size_t size, std::index_sequence<N, Ns...>, Fixed && fixed,
+  Dynamic && dynamic)
+{
+  static_assert(N >= 2, "a fixed size has at least one segment");
+  if (size >= N) {
+    fixed(size - N, PointsView<N, Point>(data + size - N));
+    return;
+  }
+  visit_tail(
+    data, size, std::index_sequence<Ns...>{}, std::forward<Fixed>(fixed),
+    std::forward<Dynamic>(dynamic));
+}
+
+inline bool is_finite(const TrajectoryPoint & point)
+{
+  return std::isfinite(point.pose.position.x) && std::isfinite(point.pose.position.y) &&
+         std::isfinite(point.pose.position.z) && std::isfinite(point.pose.orientation.x) &&
+         std::isfinite(point.pose.orientation.y) && std::isfinite(point.pose.orientation.z) &&
+         std::isfinite(point.pose.orientation.w) &&
+         std::isfinite(point.longitudinal_velocity_mps) && std::isfinite(point.acceleration_mps2);
+}
+
+/**
+ * @brief Checks that the points are valid and consecutive points are at least min_dist apart.
+ * @details Squared distances are compared with a margin instead of calling std::hypot, so the check
+ * vectorizes. A pair within the margin of min_dist counts as close: a false result only means the
+ * exact removal has to run.
+ *
+ * @param points The points.
+ * @param min_dist The minimum distance in the x-y plane.
+ * @return True if utils::remove_invalid_points would remove none of the points before reorienting.
+ */
+template <size_t N>
+bool are_valid_and_apart(const PointsView<N, const TrajectoryPoint> points, const double min_dist)
+{
+  const double min_dist2 = min_dist * min_dist * (1.0 + 1e-9);
+  bool valid_and_apart = true;
+  for (size_t i = 0; i < N; ++i) {
+    valid_and_apart &= is_finite(points[i]);
+  }
+  for (size_t i = 1; i < N; ++i) {
+    const double dx = points[i].pose.position.x - points[i - 1].pose.position.x;
+    const double dy = points[i].pose.position.y - points[i - 1].pose.position.y;
+    valid_and_apart &= dx * dx + dy * dy >= min_dist2;
+  }
+  return valid_and_apart;
+}
+
+/**
+ * @brief Raises the velocity and acceleration to a minimum and caps the velocity, in one pass.
+ * @details Matches utils::clamp_velocities followed by utils::set_max_velocity. A limit of -inf
+ * or +inf leaves the values unchanged, NaN included.
+ *
+ * @param points The points, updated in place.
+ * @param min_velocity The minimum velocity.
+ * @param min_acceleration The minimum acceleration.
+ * @param max_velocity The maximum velocity.
+ */
+template <size_t N>
+void clamp_velocities(
+  const PointsView<N, TrajectoryPoint> points, const float min_velocity,
+  const float min_acceleration, const float max_velocity)
+{
+  for (size_t i = 0; i < N; ++i) {
+    auto & point = points[i];
+    point.longitudinal_velocity_mps =
+      std::min(std::max(point.longitudinal_velocity_mps, min_velocity), max_velocity);
+    point.acceleration_mps2 = std::max(point.acceleration_mps2, min_acceleration);
+  }
+}
+
+/**
+ * @brief Checks the points as are_valid_and_apart, on the last N points for the first configured
+ * size N that fits.
+ *
+ * @param points The points.
+ * @param min_dist The minimum distance in the x-y plane.
+ * @return True if none of the points is invalid or closer than min_dist to the previous one, false
+ * if some may be or no configured size fits.
+ */
+bool are_valid_and_apart(const TrajectoryPoints & points, const double min_dist);
+
+/**
+ * @brief Applies clamp_velocities to the last N points for the first configured size N that fits,
+ * and utils::clamp_velocities and utils::set_max_velocity to the other points.
+ *
+ * @param points The points, updated in place.
+ * @param min_velocity The minimum velocity, -inf to leave it unchanged.
+ * @param min_acceleration The minimum acceleration, -inf to leave it unchanged.
+ * @param max_velocity The maximum velocity, +inf to leave it unchanged.
+ */
+void clamp_velocities(
+  TrajectoryPoints & points, const float min_velocity, const float min_acceleration,
+  const float max_velocity);
+}  // namespace autoware::trajectory_optimizer::utils::fixed_size
+
+#endif  // AUTOWARE__TRAJECTORY_OPTIMIZER_FIXED_SIZE_UTILS_HPP_
@@ -0,0 +1,120 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__TRAJECTORY_OPTIMIZER_LAZY_TRAJECTORIES_VIEW_HPP_
+#define AUTOWARE__TRAJECTORY_OPTIMIZER_LAZY_TRAJECTORIES_VIEW_HPP_
+
+#include <rclcpp/serialized_message.hpp>
+
+#include <autoware_new_planning_msgs/msg/trajectories.hpp>
+#include <autoware_planning_msgs/msg/trajectory_point.hpp>
+#include <std_msgs/msg/header.hpp>
+#include <unique_identifier_msgs/msg/uuid.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace autoware::trajectory_optimizer
+{
+using autoware_new_planning_msgs::msg::Trajectories;
+using autoware_planning_msgs::msg::TrajectoryPoint;
+using TrajectoryPoints = std::vector<TrajectoryPoint>;
+
+/**
+ * @brief Read-only view of a serialized Trajectories message that decodes candidate points on
+ * demand.
+ * @details parse() only walks the buffer: it decodes the header, generator id and score of each
+ * candidate and records where its points are, without touching the points themselves. Point
+ * arrays are decoded, or hashed straight from the raw bytes, only for the candidates that are
+ * asked for. The view borrows the buffer, which must outlive it.
+ */
+class LazyTrajectoriesView
+{
+public:
+  struct Candidate
+  {
+    std_msgs::msg::Header header;
+    unique_identifier_msgs::msg::UUID generator_id;
+    double score{0.0};
+    size_t num_points{0};
+    // offset of the first point from the start of the buffer
+    size_t points_offset{0};
+  };
+
+  /**
+   * @brief Indexes the candidates of a serialized message.
+   *
+   * @param serialized_msg The serialized Trajectories message.
+   * @return False if the encoding is not supported or the buffer is malformed, in which case the
+   * message has to be deserialized in full.
+   */
+  bool parse(const rclcpp::SerializedMessage & serialized_msg);
+
+  const std::vector<Candidate> & candidates() const { return candidates_; }
+
+  /**
+   * @brief Decodes the points of one candidate.
+   *
+   * @param index The candidate index.
+   * @param points Output points, resized to the candidate size.
+   */
+  void decode_points(const size_t index, TrajectoryPoints & points) const;
+
+  /**
+   * @brief Decodes the generator info of the message.
+   *
+   * @param generator_info Output generator info.
+   * @return False if the generator info could not be decoded.
+   */
+  bool decode_generator_info(decltype(Trajectories::generator_info) & generator_info) const;
+
+  /**
+   * @brief Hashes the points of one candidate without decoding them.
+   *
+   * @param index The candidate index.
+   * @return The same value as hash_points() on the decoded points.
+   */
+  uint64_t hash_points(const size_t index) const;
+
+private:
+  const uint8_t * data_{nullptr};
+  size_t size_{0};
+  size_t max_alignment_{8};
+  size_t generator_info_offset_{0};
+  std::vector<Candidate> candidates_;
+};
+
+/**
+ * @brief Hashes trajectory points field by field with 64-bit FNV-1a.
+ *
+ * @param points The points to be hashed.
+ * @return The hash value.
+ */
+uint64_t hash_points(const TrajectoryPoints & points);
+
+/**
+ * @brief Selects the candidates to be optimized.
+ *
+ * @param scores The score of each candidate.
+ * @param hashes The point hash of each candidate, or empty to skip deduplication.
+ * @param max_candidates Number of best-scored candidates to keep, 0 to keep all of them.
+ * @return Indices of the selected candidates, in input order.
+ */
+std::vector<size_t> select_candidates(
+  const std::vector<double> & scores, const std::vector<uint64_t> & hashes,
+  const size_t max_candidates);
+}  // namespace autoware::trajectory_optimizer
+
+#endif  // AUTOWARE__TRAJECTORY_OPTIMIZER_LAZY_TRAJECTORIES_VIEW_HPP_
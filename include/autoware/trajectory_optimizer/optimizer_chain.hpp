@@ -0,0 +1,84 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__TRAJECTORY_OPTIMIZER_OPTIMIZER_CHAIN_HPP_
+#define AUTOWARE__TRAJECTORY_OPTIMIZER_OPTIMIZER_CHAIN_HPP_
+
+#include "autoware/trajectory_optimizer/trajectory_optimizer_plugins/trajectory_eb_smoother_optimizer.hpp"
+#include "autoware/trajectory_optimizer/trajectory_optimizer_plugins/trajectory_extender.hpp"
+#include "autoware/trajectory_optimizer/trajectory_optimizer_plugins/trajectory_point_fixer.hpp"
+#include "autoware/trajectory_optimizer/trajectory_optimizer_plugins/trajectory_spline_smoother.hpp"
+#include "autoware/trajectory_optimizer/trajectory_optimizer_plugins/trajectory_velocity_optimizer.hpp"
+#include "autoware/trajectory_optimizer/trajectory_optimizer_structs.hpp"
+
+#include <autoware_utils/system/time_keeper.hpp>
+#include <rclcpp/rclcpp.hpp>
+
+#include <autoware_planning_msgs/msg/trajectory_point.hpp>
+
+#include <memory>
+#include <vector>
+
+namespace autoware::trajectory_optimizer
+{
+using autoware_planning_msgs::msg::TrajectoryPoint;
+using TrajectoryPoints = std::vector<TrajectoryPoint>;
+
+/**
+ * @brief Runtime-configurable chain of optimizer plugins applied to a single trajectory.
+ */
+class OptimizerChain
+{
+public:
+  OptimizerChain(
+    rclcpp::Node * node_ptr, const std::shared_ptr<autoware_utils_debug::TimeKeeper> time_keeper,
+    const TrajectoryOptimizerParams & params);
+
+  /**
+   * @brief Applies every plugin of the chain to the trajectory points.
+   *
+   * @param traj_points The trajectory points to be optimized.
+   * @param params The parameters for trajectory optimization.
+   */
+  void optimize_trajectory(
+    TrajectoryPoints & traj_points, const TrajectoryOptimizerParams & params);
+
+  /**
+   * @brief Applies only the jerk filtered velocity smoothing of the velocity optimizer, timed as
+   * its stage.
+   *
+   * @param traj_points The trajectory points to be smoothed.
+   * @param params The parameters for trajectory optimization.
+   */
+  void smooth_velocity(TrajectoryPoints & traj_points, const TrajectoryOptimizerParams & params);
+
+  /**
+   * @brief Forwards parameter updates to every plugin of the chain.
+   *
+   * @param parameters Vector of updated parameters
+   * @return Set parameters result
+   */
+  rcl_interfaces::msg::SetParametersResult on_parameter(
+    const std::vector<rclcpp::Parameter> & parameters);
+
+private:
+  std::shared_ptr<plugin::TrajectoryEBSmootherOptimizer> eb_smoother_optimizer_ptr_;
+  std::shared_ptr<plugin::TrajectoryExtender> trajectory_extender_ptr_;
+  std::shared_ptr<plugin::TrajectoryPointFixer> trajectory_point_fixer_ptr_;
+  std::shared_ptr<plugin::TrajectorySplineSmoother> trajectory_spline_smoother_ptr_;
+  std::shared_ptr<plugin::TrajectoryVelocityOptimizer> trajectory_velocity_optimizer_ptr_;
+};
+}  // namespace autoware::trajectory_optimizer
+
+#endif  // AUTOWARE__TRAJECTORY_OPTIMIZER_OPTIMIZER_CHAIN_HPP_
@@ -0,0 +1,160 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__TRAJECTORY_OPTIMIZER_PERF_COUNTERS_HPP_
+#define AUTOWARE__TRAJECTORY_OPTIMIZER_PERF_COUNTERS_HPP_
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace autoware::trajectory_optimizer
+{
+
+struct PerfCounterValues
+{
+  uint64_t cycles{0};
+  uint64_t instructions{0};
+  uint64_t cache_misses{0};
+  uint64_t branch_misses{0};
+  // time the group was enabled and actually counting, shorter when the kernel multiplexes it with
+  // other events on the same hardware counters
+  uint64_t time_enabled_ns{0};
+  uint64_t time_running_ns{0};
+
+  PerfCounterValues & operator+=(const PerfCounterValues & other);
+  PerfCounterValues operator-(const PerfCounterValues & other) const;
+};
+
+/**
+ * @brief Extrapolates counts taken while the group was multiplexed to the whole time it was
+ * enabled, as perf stat does.
+ *
+ * @param values The counts and times of a measurement.
+ * @return The scaled counts with the times unchanged, or nullopt if the group never ran.
+ */
+std::optional<PerfCounterValues> scale_to_enabled_time(const PerfCounterValues & values);
+
+/**
+ * @brief Hardware counters of the calling thread, read with perf_event_open.
+ * @details Counters the kernel or the hardware does not provide, e.g. inside a VM or with a
+ * restrictive perf_event_paranoid, read as zero; if none can be opened the group is unavailable.
+ * A group counts the thread that created it only.
+ */
+class PerfCounterGroup
+{
+public:
+  PerfCounterGroup();
+  ~PerfCounterGroup();
+  PerfCounterGroup(const PerfCounterGroup &) = delete;
+  PerfCounterGroup & operator=(const PerfCounterGroup &) = delete;
+
+  bool is_available() const { return leader_fd_ >= 0; }
+
+  /**
+   * @brief Reads the counters accumulated since the group was opened.
+   *
+   * @return The counter values, or nullopt if the group is unavailable or the read failed.
+   */
+  std::optional<PerfCounterValues> read() const;
+
+  /**
+   * @brief Gets the group of the calling thread, opened on first use.
+   *
+   * @return The group of the thread.
+   */
+  static PerfCounterGroup & for_current_thread();
+
+private:
+  int leader_fd_{-1};
+  std::vector<int> fds_;
+  // member of PerfCounterValues filled by each opened counter, in group read order
+  std::vector<uint64_t PerfCounterValues::*> fields_;
+};
+
+/**
+ * @brief Per-stage sums of the counters of every thread. Thread-safe.
+ */
+class PerfCounterAggregator
+{
+public:
+  struct StageTotals
+  {
+    uint64_t calls{0};
+    // calls whose counts were scaled up from a multiplexed measurement
+    uint64_t scaled_calls{0};
+    // calls during which the group never ran, not included in calls
+    uint64_t unmeasured_calls{0};
+    PerfCounterValues values;
+  };
+
+  /**
+   * @brief Adds a measurement, counted as scaled if the group ran for less than it was enabled.
+   *
+   * @param stage The stage name.
+   * @param values The counts, already scaled to the enabled time.
+   */
+  void add(const std::string_view stage, const PerfCounterValues & values);
+
+  /**
+   * @brief Counts a call during which the group never ran, e.g. because other events held every
+   * hardware counter.
+   *
+   * @param stage The stage name.
+   */
+  void add_unmeasured(const std::string_view stage);
+
+  /**
+   * @brief Gets the totals accumulated since the last call and starts over.
+   *
+   * @return The totals of each stage, sorted by stage name.
+   */
+  std::vector<std::pair<std::string, StageTotals>> take();
+
+private:
+  StageTotals & get_stage(const std::string_view stage);
+
+  std::mutex mutex_;
+  // the transparent comparator allows lookups by string_view without allocating
+  std::map<std::string, StageTotals, std::less<>> stages_;
+};
+
+/**
+ * @brief Adds the counters of the calling thread during its lifetime to a stage of the
+ * aggregator, scaled to the enabled time. Does nothing if the aggregator is null or the counters
+ * are unavailable.
+ */
+class ScopedStagePerfCounters
+{
+public:
+  ScopedStagePerfCounters(PerfCounterAggregator * aggregator, const std::string_view stage);
+  ~ScopedStagePerfCounters();
+  ScopedStagePerfCounters(const ScopedStagePerfCounters &) = delete;
+  ScopedStagePerfCounters & operator=(const ScopedStagePerfCounters &) = delete;
+
+private:
+  PerfCounterAggregator * aggregator_;
+  std::string_view stage_;
+  std::optional<PerfCounterValues> start_;
+};
+}  // namespace autoware::trajectory_optimizer
+
+#endif  // AUTOWARE__TRAJECTORY_OPTIMIZER_PERF_COUNTERS_HPP_
@@ -0,0 +1,166 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__TRAJECTORY_OPTIMIZER_PRODUCTION_PIPELINE_HPP_
+#define AUTOWARE__TRAJECTORY_OPTIMIZER_PRODUCTION_PIPELINE_HPP_
+
+#include "autoware/trajectory_optimizer/cycle_capture.hpp"
+#include "autoware/trajectory_optimizer/perf_counters.hpp"
+#include "autoware/trajectory_optimizer/static_pipeline.hpp"
+#include "autoware/trajectory_optimizer/trajectory_optimizer_plugins/trajectory_eb_smoother_optimizer.hpp"
+#include "autoware/trajectory_optimizer/trajectory_optimizer_plugins/trajectory_extender.hpp"
+#include "autoware/trajectory_optimizer/trajectory_optimizer_plugins/trajectory_point_fixer.hpp"
+#include "autoware/trajectory_optimizer/trajectory_optimizer_plugins/trajectory_spline_smoother.hpp"
+#include "autoware/trajectory_optimizer/trajectory_optimizer_plugins/trajectory_velocity_optimizer.hpp"
+
+#include <autoware_utils/system/time_keeper.hpp>
+#include <rclcpp/rclcpp.hpp>
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace autoware::trajectory_optimizer::pipeline
+{
+namespace stages
+{
+template <typename Plugin>
+struct PluginName;
+template <>
+struct PluginName<plugin::TrajectoryEBSmootherOptimizer>
+{
+  static constexpr const char * value = "eb_smoother_optimizer";
+};
+template <>
+struct PluginName<plugin::TrajectoryExtender>
+{
+  static constexpr const char * value = "trajectory_extender";
+};
+template <>
+struct PluginName<plugin::TrajectoryPointFixer>
+{
+  static constexpr const char * value = "trajectory_point_fixer";
+};
+template <>
+struct PluginName<plugin::TrajectorySplineSmoother>
+{
+  static constexpr const char * value = "trajectory_spline_smoother";
+};
+template <>
+struct PluginName<plugin::TrajectoryVelocityOptimizer>
+{
+  static constexpr const char * value = "trajectory_velocity_optimizer";
+};
+
+/**
+ * @brief Whole-trajectory stage running an optimizer plugin it owns.
+ * @details The plugin is called through its concrete type, so the call is not virtual.
+ */
+template <typename Plugin>
+class PluginStage
+{
+public:
+  static constexpr bool is_element_wise = false;
+
+  PluginStage(
+    rclcpp::Node * node_ptr, const std::shared_ptr<autoware_utils_debug::TimeKeeper> & time_keeper,
+    const TrajectoryOptimizerParams & params)
+  : plugin_(std::make_unique<Plugin>(PluginName<Plugin>::value, node_ptr, time_keeper, params))
+  {
+  }
+
+  void optimize_trajectory(TrajectoryPoints & traj_points, const TrajectoryOptimizerParams & params)
+  {
+    std::optional<autoware_utils::ScopedTimeTrack> time_track;
+    if (params.detailed_timing) {
+      time_track.emplace(PluginName<Plugin>::value, *plugin_->get_time_keeper());
+    }
+    const ScopedStageTimer timer(params.stage_timings, PluginName<Plugin>::value);
+    const ScopedStagePerfCounters counters(
+      params.perf_counter_aggregator, PluginName<Plugin>::value);
+    plugin_->Plugin::optimize_trajectory(traj_points, params);
+  }
+  rcl_interfaces::msg::SetParametersResult on_parameter(
+    const std::vector<rclcpp::Parameter> & parameters)
+  {
+    return plugin_->Plugin::on_parameter(parameters);
+  }
+
+protected:
+  std::unique_ptr<Plugin> plugin_;
+};
+
+using Extender = PluginStage<plugin::TrajectoryExtender>;
+using PointFixer = PluginStage<plugin::TrajectoryPointFixer>;
+using EBSmoother = PluginStage<plugin::TrajectoryEBSmootherOptimizer>;
+using SplineSmoother = PluginStage<plugin::TrajectorySplineSmoother>;
+
+/**
+ * @brief The velocity optimizer, with the engage speed clamp and the speed limit run as one fused
+ * pass before the jerk filtered velocity smoothing.
+ * @details Both are timed as the velocity optimizer stage, as in OptimizerChain.
+ */
+class VelocityOptimizer : public PluginStage<plugin::TrajectoryVelocityOptimizer>
+{
+public:
+  using PluginStage::PluginStage;
+
+  void optimize_trajectory(TrajectoryPoints & traj_points, const TrajectoryOptimizerParams & params)
+  {
+    std::optional<autoware_utils::ScopedTimeTrack> time_track;
+    if (params.detailed_timing) {
+      time_track.emplace(stage, *plugin_->get_time_keeper());
+    }
+    const ScopedStageTimer timer(params.stage_timings, stage);
+    const ScopedStagePerfCounters counters(params.perf_counter_aggregator, stage);
+    clamps_.optimize_trajectory(traj_points, params);
+    plugin_->smooth_velocity(traj_points, params);
+  }
+
+  /**
+   * @brief Applies only the jerk filtered velocity smoothing, timed as the stage.
+   *
+   * @param traj_points The trajectory points to be smoothed.
+   * @param params The parameters for trajectory optimization.
+   */
+  void smooth_velocity(TrajectoryPoints & traj_points, const TrajectoryOptimizerParams & params)
+  {
+    std::optional<autoware_utils::ScopedTimeTrack> time_track;
+    if (params.detailed_timing) {
+      time_track.emplace(stage, *plugin_->get_time_keeper());
+    }
+    const ScopedStageTimer timer(params.stage_timings, stage);
+    const ScopedStagePerfCounters counters(params.perf_counter_aggregator, stage);
+    plugin_->smooth_velocity(traj_points, params);
+  }
+
+private:
+  static constexpr const char * stage = PluginName<plugin::TrajectoryVelocityOptimizer>::value;
+
+  Pipeline<EngageSpeedClamp, MaxSpeedLimit> clamps_{};
+};
+}  // namespace stages
+
+/**
+ * @brief Fixed chain used in production, equivalent to OptimizerChain.
+ * @details The engage speed clamp and the speed limit of the velocity optimizer run as one fused
+ * pass. The point fixer keeps its own passes: its proximity and orientation checks depend on
+ * neighboring points.
+ */
+using ProductionPipeline = Pipeline<
+  stages::Extender, stages::PointFixer, stages::VelocityOptimizer, stages::EBSmoother,
+  stages::SplineSmoother, stages::PointFixer>;
+}  // namespace autoware::trajectory_optimizer::pipeline
+
+#endif  // AUTOWARE__TRAJECTORY_OPTIMIZER_PRODUCTION_PIPELINE_HPP_
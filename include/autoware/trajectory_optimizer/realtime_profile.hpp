@@ -0,0 +1,150 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__TRAJECTORY_OPTIMIZER_REALTIME_PROFILE_HPP_
+#define AUTOWARE__TRAJECTORY_OPTIMIZER_REALTIME_PROFILE_HPP_
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace autoware::trajectory_optimizer
+{
+
+struct RealtimeProfileParams
+{
+  bool enable{false};
+  int64_t cpu_affinity_mask{0};  // bit i pins to cpu i, 0 leaves the affinity unchanged
+  int64_t sched_priority{0};     // SCHED_FIFO priority in [1, 99], 0 leaves the policy unchanged
+  bool lock_memory{false};
+  int64_t prefault_stack_size_kb{0};
+  int64_t prefault_trajectory_slots{0};
+  int64_t prefault_trajectory_points{0};
+  int64_t page_fault_warmup_cycles{0};
+};
+
+/**
+ * @brief Opt-in real-time execution settings for the node and its worker threads.
+ * @details Every apply function returns the list of settings that could not be applied, e.g.
+ * because the process lacks CAP_SYS_NICE or CAP_IPC_LOCK, so that the caller can report them.
+ */
+class RealtimeProfile
+{
+public:
+  explicit RealtimeProfile(const RealtimeProfileParams & params) : params_(params) {}
+
+  /**
+   * @brief Applies the process-wide settings: locks current and future memory and stops the
+   * allocator from returning freed memory to the kernel.
+   * @details mlockall and mallopt act on the whole process, including the other nodes of a
+   * component container, not only on the threads of the node.
+   *
+   * @return Error messages of the settings that failed.
+   */
+  std::vector<std::string> apply_to_process() const;
+
+  /**
+   * @brief Applies the per-thread settings to the calling thread: cpu affinity, SCHED_FIFO priority
+   * and stack pre-faulting.
+   *
+   * @return Error messages of the settings that failed.
+   */
+  std::vector<std::string> apply_to_current_thread() const;
+
+  const RealtimeProfileParams & params() const { return params_; }
+
+private:
+  RealtimeProfileParams params_;
+};
+
+/**
+ * @brief Moves the calling thread to SCHED_IDLE, so that it only runs on otherwise idle cpus.
+ * @details Lowering the priority needs no privileges, unlike the settings of RealtimeProfile.
+ *
+ * @return Error messages of the settings that failed.
+ */
+std::vector<std::string> apply_idle_priority_to_current_thread();
+
+struct PageFaults
+{
+  int64_t minor{0};
+  int64_t major{0};
+};
+
+/**
+ * @brief Counts the page faults taken by the calling thread during a cycle.
+ * @details The first cycles are ignored, since buffers are still growing to their steady-state
+ * size. begin_cycle() and end_cycle() must be called from the same thread.
+ */
+class PageFaultMonitor
+{
+public:
+  explicit PageFaultMonitor(const int64_t warmup_cycles) : warmup_cycles_(warmup_cycles) {}
+
+  void begin_cycle();
+
+  /**
+   * @brief Ends the cycle started by the last call to begin_cycle().
+   *
+   * @return The page faults of the cycle, or nullopt while warming up.
+   */
+  std::optional<PageFaults> end_cycle();
+
+private:
+  int64_t warmup_cycles_{0};
+  int64_t cycle_count_{0};
+  PageFaults cycle_start_;
+};
+
+/**
+ * @brief Keeps a cycle of a PageFaultMonitor open for the lifetime of the object.
+ * @details The cycle is ended on every path out of the scope, early returns included, and its page
+ * faults are passed to report once the monitor is past its warm-up cycles.
+ */
+template <typename Report>
+class ScopedPageFaultCycle
+{
+public:
+  /**
+   * @param monitor Monitor of the calling thread, or nullptr to count nothing.
+   * @param report Called with the page faults of the cycle.
+   */
+  ScopedPageFaultCycle(PageFaultMonitor * monitor, Report report)
+  : monitor_(monitor), report_(std::move(report))
+  {
+    if (monitor_) {
+      monitor_->begin_cycle();
+    }
+  }
+  ~ScopedPageFaultCycle()
+  {
+    if (!monitor_) {
+      return;
+    }
+    if (const auto page_faults = monitor_->end_cycle()) {
+      report_(*page_faults);
+    }
+  }
+  ScopedPageFaultCycle(const ScopedPageFaultCycle &) = delete;
+  ScopedPageFaultCycle & operator=(const ScopedPageFaultCycle &) = delete;
+
+private:
+  PageFaultMonitor * monitor_;
+  Report report_;
+};
+}  // namespace autoware::trajectory_optimizer
+
+#endif  // AUTOWARE__TRAJECTORY_OPTIMIZER_REALTIME_PROFILE_HPP_
@@ -0,0 +1,145 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__TRAJECTORY_OPTIMIZER_SCENARIO_GENERATOR_HPP_
+#define AUTOWARE__TRAJECTORY_OPTIMIZER_SCENARIO_GENERATOR_HPP_
+
+#include <autoware_new_planning_msgs/msg/trajectories.hpp>
+#include <autoware_planning_msgs/msg/trajectory_point.hpp>
+#include <geometry_msgs/msg/accel_with_covariance_stamped.hpp>
+#include <nav_msgs/msg/odometry.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace autoware::trajectory_optimizer::scenarios
+{
+using autoware_planning_msgs::msg::TrajectoryPoint;
+using TrajectoryPoints = std::vector<TrajectoryPoint>;
+
+enum class ScenarioType {
+  LANE_FOLLOW,
+  LANE_CHANGE,
+  INTERSECTION_TURN,
+  U_TURN,
+  PULL_OVER,
+  STOP_AND_GO,
+};
+
+const std::vector<ScenarioType> & all_scenario_types();
+std::string to_string(const ScenarioType type);
+
+/**
+ * @brief Noise and defects added to a generated trajectory, all disabled by default.
+ */
+struct DefectParams
+{
+  double position_noise_stddev_m{0.0};
+  double yaw_noise_stddev_rad{0.0};
+  double velocity_noise_stddev_mps{0.0};
+  // fraction of the points followed by a copy of themselves
+  double duplicate_point_ratio{0.0};
+  // fraction of the points with a NaN coordinate
+  double invalid_point_ratio{0.0};
+};
+
+struct ScenarioParams
+{
+  ScenarioType type{ScenarioType::LANE_FOLLOW};
+  size_t num_points{100};
+  double point_interval_m{1.0};
+  double speed_mps{10.0};
+  double lane_width_m{3.5};
+  double turn_radius_m{10.0};
+  double max_lateral_acc_mps2{2.0};
+  double max_acc_mps2{1.5};
+  // positive
+  double max_dec_mps2{2.5};
+  DefectParams defects;
+};
+
+/**
+ * @brief A candidate with the ego state it is optimized for.
+ */
+struct Scenario
+{
+  TrajectoryPoints trajectory;
+  nav_msgs::msg::Odometry odometry;
+  geometry_msgs::msg::AccelWithCovarianceStamped acceleration;
+  // past ego states, oldest first
+  TrajectoryPoints ego_history_points;
+  // the trajectory before the defects, as the previous output of the optimizer
+  TrajectoryPoints previous_trajectory;
+};
+
+/**
+ * @brief Seeded generator of representative trajectories and ego states for tests and benchmarks.
+ * @details The path of each scenario is integrated from a curvature profile over arc length and
+ * its speed profile respects the lateral and longitudinal acceleration limits, so that the shapes
+ * and sizes are the ones the chain sees from a planner. The variations within a scenario type
+ * (turn direction, amplitudes, where a maneuver starts) are drawn from the seed. The random
+ * numbers are derived from std::mt19937_64 without the standard distributions, whose output is
+ * implementation-defined, so a seed generates the same scenarios with every compiler and standard
+ * library.
+ */
+class ScenarioGenerator
+{
+public:
+  explicit ScenarioGenerator(const uint64_t seed = 0) : engine_(seed) {}
+
+  /**
+   * @brief Generates a scenario.
+   *
+   * @param params The scenario parameters.
+   * @return The scenario, in a map frame with the candidate starting at the origin along +x.
+   */
+  Scenario generate(const ScenarioParams & params);
+
+  /**
+   * @brief Generates an MTR-style multimodal candidate set: modes diverging from the same start,
+   * with different curvature and speed, and scores that sum to 1, the highest first.
+   *
+   * @param params The scenario parameters of the first mode, also used for the ego state.
+   * @param num_modes The number of candidates.
+   * @param scenario The generated first mode and ego state, if not null.
+   * @return The candidates, with empty headers.
+   */
+  autoware_new_planning_msgs::msg::Trajectories generate_candidates(
+    const ScenarioParams & params, const size_t num_modes, Scenario * scenario = nullptr);
+
+  /**
+   * @brief Adds noise and defects to trajectory points.
+   *
+   * @param points The points, updated in place.
+   * @param defects The noise and defects.
+   */
+  void apply_defects(TrajectoryPoints & points, const DefectParams & defects);
+
+private:
+  // in [0, 1)
+  double uniform();
+  double uniform(const double min, const double max);
+  double normal(const double stddev);
+
+  TrajectoryPoints generate_path(
+    const ScenarioParams & params, const double curvature_bias, const double speed_factor);
+
+  std::mt19937_64 engine_;
+};
+}  // namespace autoware::trajectory_optimizer::scenarios
+
+#endif  // AUTOWARE__TRAJECTORY_OPTIMIZER_SCENARIO_GENERATOR_HPP_
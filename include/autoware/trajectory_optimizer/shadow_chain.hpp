@@ -0,0 +1,139 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__TRAJECTORY_OPTIMIZER_SHADOW_CHAIN_HPP_
+#define AUTOWARE__TRAJECTORY_OPTIMIZER_SHADOW_CHAIN_HPP_
+
+#include "autoware_trajectory_optimizer/msg/shadow_metrics.hpp"
+
+#include <autoware_planning_msgs/msg/trajectory_point.hpp>
+#include <rclcpp/parameter.hpp>
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace autoware::trajectory_optimizer
+{
+using autoware_trajectory_optimizer::msg::ShadowMetrics;
+
+// parameters under this prefix override the primary parameters of the same name in the shadow
+// chain, e.g. shadow.parameters.spline_interpolation_resolution_m
+constexpr const char * shadow_parameter_prefix = "shadow.parameters.";
+
+/**
+ * @brief Difference of the output of the shadow chain to the primary output of one candidate.
+ * @details Every shadow point is projected on the nearest segment of the primary path, so the
+ * differences do not depend on the resolution of either output. All values are NaN if either
+ * output is empty.
+ */
+struct OutputDifference
+{
+  double max_position_deviation_m{0.0};
+  double mean_position_deviation_m{0.0};
+  // against the primary velocity interpolated at the projection
+  double max_velocity_difference_mps{0.0};
+  // shadow minus primary
+  double length_difference_m{0.0};
+};
+
+/**
+ * @brief Compares the shadow output of a candidate with its primary output.
+ *
+ * @param primary The points output by the primary chain.
+ * @param shadow The points output by the shadow chain.
+ * @return The differences.
+ */
+OutputDifference compare_outputs(
+  const std::vector<autoware_planning_msgs::msg::TrajectoryPoint> & primary,
+  const std::vector<autoware_planning_msgs::msg::TrajectoryPoint> & shadow);
+
+/**
+ * @brief Folds the difference of one candidate into the metrics of a cycle.
+ * @details The metrics must start from NaN differences; the mean is averaged over the candidates
+ * added so far, counted in num_candidates.
+ *
+ * @param difference The difference of the candidate.
+ * @param metrics The metrics of the cycle, updated in place.
+ */
+void add_to_metrics(const OutputDifference & difference, ShadowMetrics & metrics);
+
+/**
+ * @brief Splits the shadow overrides out of a list of parameters.
+ *
+ * @param parameters The parameters, e.g. the overrides given to the node or an update.
+ * @return The parameters under shadow_parameter_prefix, renamed without the prefix.
+ */
+std::vector<rclcpp::Parameter> get_shadow_overrides(
+  const std::vector<rclcpp::Parameter> & parameters);
+
+/**
+ * @brief Single background thread running at most one task at a time, for work that must never
+ * delay the caller.
+ * @details Work is offered rather than queued: try_reserve() fails while a task is running and
+ * the offer is counted as skipped, so a slow task sheds load instead of building a backlog.
+ */
+class ShadowRunner
+{
+public:
+  /**
+   * @brief Starts the thread.
+   *
+   * @param on_start Called on the thread before it runs any task, e.g. to lower its priority.
+   */
+  explicit ShadowRunner(const std::function<void()> & on_start);
+  ~ShadowRunner();
+  ShadowRunner(const ShadowRunner &) = delete;
+  ShadowRunner & operator=(const ShadowRunner &) = delete;
+
+  /**
+   * @brief Reserves the thread for the next task.
+   *
+   * @return False if a task is still reserved or running, the offer is then counted as skipped.
+   */
+  bool try_reserve();
+
+  /**
+   * @brief Hands a task to the thread, after a successful try_reserve().
+   *
+   * @param task The task, run on the thread. It must not throw.
+   */
+  void submit(std::function<void()> task);
+
+  /**
+   * @brief Gets the number of skipped offers since the last call and resets it.
+   *
+   * @return The number of skipped offers.
+   */
+  uint32_t take_num_skipped();
+
+private:
+  void run();
+
+  std::mutex mutex_;
+  std::condition_variable task_available_;
+  std::function<void()> task_;
+  bool reserved_{false};
+  bool stop_{false};
+  uint32_t num_skipped_{0};
+  std::function<void()> on_start_;
+  std::thread thread_;
+};
+}  // namespace autoware::trajectory_optimizer
+
+#endif  // AUTOWARE__TRAJECTORY_OPTIMIZER_SHADOW_CHAIN_HPP_
@@ -0,0 +1,117 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__TRAJECTORY_OPTIMIZER_SIMD_KERNELS_HPP_
+#define AUTOWARE__TRAJECTORY_OPTIMIZER_SIMD_KERNELS_HPP_
+
+#include <autoware_planning_msgs/msg/trajectory_point.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Point kernels of utils with an implementation per instruction set, selected at runtime.
+ * @details The package is built with the generic flags of the target, so the AVX-512, AVX2 and
+ * SSE4 versions are compiled with per-function target attributes and the best one the cpu supports
+ * is selected on first use. They read the fields of consecutive points with strided gathers, and
+ * give the same results as the scalar versions bit for bit. On other architectures only the scalar
+ * versions exist; on aarch64 the compiler vectorizes them with NEON, which is always available.
+ */
+namespace autoware::trajectory_optimizer::simd
+{
+using autoware_planning_msgs::msg::TrajectoryPoint;
+
+enum class Isa {
+  SCALAR,
+  SSE4,
+  AVX2,
+  AVX512,
+};
+
+std::string to_string(const Isa isa);
+
+/**
+ * @brief Gets the instruction sets with kernels in this build that the cpu supports.
+ *
+ * @return The supported instruction sets, SCALAR first.
+ */
+std::vector<Isa> supported_isas();
+
+/**
+ * @brief Gets the instruction set of the kernels in use.
+ * @details The first call selects the best supported one, capped by the environment variable
+ * TRAJECTORY_OPTIMIZER_MAX_ISA (scalar, sse4, avx2 or avx512) if it is set.
+ *
+ * @return The instruction set.
+ */
+Isa active_isa();
+
+/**
+ * @brief Switches the kernels, for tests and benchmarks.
+ *
+ * @param isa The instruction set.
+ * @return False if it is not supported, the kernels in use are then unchanged.
+ */
+bool set_active_isa(const Isa isa);
+
+/**
+ * @brief Flags the points with a non-finite position, orientation, velocity or acceleration, as
+ * utils::validate_point does.
+ *
+ * @param points The points.
+ * @param num_points The number of points.
+ * @param is_invalid One flag per point, set to 1 if the point is invalid and 0 otherwise.
+ */
+void flag_invalid_points(
+  const TrajectoryPoint * points, const size_t num_points, uint8_t * is_invalid);
+
+/**
+ * @brief Flags the consecutive points closer than a distance in the x-y plane, as
+ * autoware_utils::calc_distance2d(points[i + 1], points[i]) < min_dist.
+ *
+ * @param points The points.
+ * @param num_points The number of points.
+ * @param min_dist The distance.
+ * @param is_close num_points - 1 flags, is_close[i] for the pair (i, i + 1).
+ */
+void flag_close_pairs(
+  const TrajectoryPoint * points, const size_t num_points, const double min_dist,
+  uint8_t * is_close);
+
+/**
+ * @brief Raises the velocity and acceleration of the points to a minimum, as std::max.
+ *
+ * @param points The points, updated in place.
+ * @param num_points The number of points.
+ * @param min_velocity The minimum velocity.
+ * @param min_acceleration The minimum acceleration.
+ */
+void clamp_min_velocity_and_acceleration(
+  TrajectoryPoint * points, const size_t num_points, const float min_velocity,
+  const float min_acceleration);
+
+/**
+ * @brief Caps the velocity of the points, as std::min.
+ *
+ * @param points The points, updated in place.
+ * @param num_points The number of points.
+ * @param max_velocity The maximum velocity.
+ */
+void clamp_max_velocity(
+  TrajectoryPoint * points, const size_t num_points, const float max_velocity);
+}  // namespace autoware::trajectory_optimizer::simd
+
+#endif  // AUTOWARE__TRAJECTORY_OPTIMIZER_SIMD_KERNELS_HPP_
@@ -0,0 +1,119 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__TRAJECTORY_OPTIMIZER_STAMPED_BUFFER_HPP_
+#define AUTOWARE__TRAJECTORY_OPTIMIZER_STAMPED_BUFFER_HPP_
+
+#include <rclcpp/time.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <iterator>
+#include <utility>
+
+namespace autoware::trajectory_optimizer
+{
+
+/**
+ * @brief History of a stamped input, indexed by header stamp.
+ * @details Messages are expected in stamp order. A lookup at stamp t is final once a message
+ * stamped at or after t has been received, since no later message can change its result; this is
+ * what makes the lockstep mode independent of arrival timing. Messages are only dropped by the
+ * owner, which knows the oldest stamp still to be looked up.
+ */
+template <typename MessageT>
+class StampedBuffer
+{
+public:
+  using ConstSharedPtr = typename MessageT::ConstSharedPtr;
+
+  /**
+   * @brief Appends a message.
+   *
+   * @param msg The message to be stored.
+   * @return False if the message is older than the newest stored one and was dropped.
+   */
+  bool push(const ConstSharedPtr & msg)
+  {
+    const auto stamp = rclcpp::Time(msg->header.stamp).nanoseconds();
+    if (!messages_.empty() && stamp < messages_.back().first) {
+      return false;
+    }
+    messages_.emplace_back(stamp, msg);
+    return true;
+  }
+
+  /**
+   * @brief Checks whether the lookup at the stamp can no longer change.
+   *
+   * @param stamp The stamp in nanoseconds.
+   * @return True if a message stamped at or after the stamp has been received.
+   */
+  bool is_complete(const int64_t stamp) const
+  {
+    return !messages_.empty() && messages_.back().first >= stamp;
+  }
+
+  /**
+   * @brief Finds the latest message stamped at or before the stamp.
+   *
+   * @param stamp The stamp in nanoseconds.
+   * @return The message, or nullptr if every stored message is newer.
+   */
+  ConstSharedPtr find_latest_at(const int64_t stamp) const
+  {
+    const auto it = std::upper_bound(
+      messages_.begin(), messages_.end(), stamp,
+      [](const int64_t value, const auto & entry) { return value < entry.first; });
+    if (it == messages_.begin()) {
+      return nullptr;
+    }
+    return std::prev(it)->second;
+  }
+
+  /**
+   * @brief Drops the messages that no lookup at or after the stamp can return.
+   *
+   * @param stamp The stamp in nanoseconds.
+   */
+  void discard_before(const int64_t stamp)
+  {
+    while (messages_.size() > 1 && messages_[1].first <= stamp) {
+      messages_.pop_front();
+    }
+  }
+
+  /**
+   * @brief Drops the oldest messages until at most max_size are left.
+   * @details Lookups older than the oldest message left then return nullptr.
+   *
+   * @param max_size The number of messages to keep.
+   */
+  void discard_oldest(const size_t max_size)
+  {
+    while (messages_.size() > max_size) {
+      messages_.pop_front();
+    }
+  }
+
+  size_t size() const { return messages_.size(); }
+
+private:
+  std::deque<std::pair<int64_t, ConstSharedPtr>> messages_;
+};
+}  // namespace autoware::trajectory_optimizer
+
+#endif  // AUTOWARE__TRAJECTORY_OPTIMIZER_STAMPED_BUFFER_HPP_
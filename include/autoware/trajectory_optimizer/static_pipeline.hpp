@@ -0,0 +1,304 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__TRAJECTORY_OPTIMIZER_STATIC_PIPELINE_HPP_
+#define AUTOWARE__TRAJECTORY_OPTIMIZER_STATIC_PIPELINE_HPP_
+
+#include "autoware/trajectory_optimizer/candidate_batch.hpp"
+#include "autoware/trajectory_optimizer/trajectory_optimizer_structs.hpp"
+#include "autoware/trajectory_optimizer/utils.hpp"
+
+#include <rclcpp/parameter.hpp>
+
+#include <autoware_planning_msgs/msg/trajectory_point.hpp>
+#include <rcl_interfaces/msg/set_parameters_result.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace autoware::trajectory_optimizer::pipeline
+{
+using autoware_planning_msgs::msg::TrajectoryPoint;
+using TrajectoryPoints = std::vector<TrajectoryPoint>;
+
+/**
+ * @brief Chain of optimizer stages composed at compile time.
+ * @details A stage either works on the whole trajectory, exposing optimize_trajectory() and
+ * on_parameter() like the optimizer plugins, or is element-wise, exposing
+ * - `static constexpr bool is_element_wise = true;`
+ * - `void prepare(const TrajectoryOptimizerParams &)`, evaluating per-call decisions once,
+ * - `bool enabled() const`,
+ * - `bool process(TrajectoryPoint &) const`, returning false to drop the point.
+ * Runs of adjacent element-wise stages are fused into a single pass over the points. Every stage
+ * is constructed from the arguments given to the pipeline constructor.
+ */
+template <typename... Stages>
+class Pipeline
+{
+public:
+  template <typename... Args>
+  explicit Pipeline(const Args &... args) : stages_{Stages(args...)...}
+  {
+  }
+
+  /**
+   * @brief Applies every stage of the pipeline to the trajectory points.
+   *
+   * @param traj_points The trajectory points to be optimized.
+   * @param params The parameters for trajectory optimization.
+   */
+  void optimize_trajectory(TrajectoryPoints & traj_points, const TrajectoryOptimizerParams & params)
+  {
+    run<0>(traj_points, params);
+  }
+
+  /**
+   * @brief Applies every stage to all candidates of a batch in a single pass over its points.
+   * @details Only for pipelines of element-wise stages: a point is processed the same way whatever
+   * candidate it belongs to, so the candidates need not be visited one by one.
+   *
+   * @param batch The candidates to be optimized.
+   * @param params The parameters for trajectory optimization.
+   */
+  void optimize_trajectories(CandidateBatch & batch, const TrajectoryOptimizerParams & params)
+  {
+    static_assert(
+      (IsElementWise<Stages>::value && ...),
+      "only element-wise stages can run on a batch of candidates");
+    run_fused_batch(batch, params, std::index_sequence_for<Stages...>{});
+  }
+
+  /**
+   * @brief Forwards parameter updates to every whole-trajectory stage.
+   *
+   * @param parameters Vector of updated parameters
+   * @return Set parameters result
+   */
+  rcl_interfaces::msg::SetParametersResult on_parameter(
+    const std::vector<rclcpp::Parameter> & parameters)
+  {
+    forward_parameters(parameters, std::index_sequence_for<Stages...>{});
+    rcl_interfaces::msg::SetParametersResult result;
+    result.successful = true;
+    result.reason = "success";
+    return result;
+  }
+
+  template <size_t I>
+  auto & stage()
+  {
+    return std::get<I>(stages_);
+  }
+
+  // the stage of a type that occurs once in the pipeline
+  template <typename Stage>
+  Stage & stage()
+  {
+    return std::get<Stage>(stages_);
+  }
+
+private:
+  template <size_t I>
+  using StageType = std::tuple_element_t<I, std::tuple<Stages...>>;
+
+  template <typename Stage, typename = void>
+  struct IsElementWise : std::false_type
+  {
+  };
+  template <typename Stage>
+  struct IsElementWise<Stage, std::enable_if_t<Stage::is_element_wise>> : std::true_type
+  {
+  };
+
+  // index one past the run of element-wise stages starting at I
+  template <size_t I>
+  static constexpr size_t element_wise_run_end()
+  {
+    if constexpr (I < sizeof...(Stages)) {
+      if constexpr (IsElementWise<StageType<I>>::value) {
+        return element_wise_run_end<I + 1>();
+      } else {
+        return I;
+      }
+    } else {
+      return I;
+    }
+  }
+
+  template <size_t I>
+  void run(TrajectoryPoints & traj_points, const TrajectoryOptimizerParams & params)
+  {
+    if constexpr (I < sizeof...(Stages)) {
+      if constexpr (IsElementWise<StageType<I>>::value) {
+        constexpr size_t end = element_wise_run_end<I>();
+        run_fused<I>(traj_points, params, std::make_index_sequence<end - I>{});
+        run<end>(traj_points, params);
+      } else {
+        std::get<I>(stages_).optimize_trajectory(traj_points, params);
+        run<I + 1>(traj_points, params);
+      }
+    }
+  }
+
+  template <size_t Begin, size_t... Is>
+  void run_fused(
+    TrajectoryPoints & traj_points, const TrajectoryOptimizerParams & params,
+    std::index_sequence<Is...>)
+  {
+    (std::get<Begin + Is>(stages_).prepare(params), ...);
+    if (!(std::get<Begin + Is>(stages_).enabled() || ...)) {
+      return;
+    }
+    // a dropped point is not passed to the following stages, matching separate passes
+    auto output = traj_points.begin();
+    for (auto it = traj_points.begin(); it != traj_points.end(); ++it) {
+      const bool keep = (process_if_enabled(std::get<Begin + Is>(stages_), *it) && ...);
+      if (!keep) {
+        continue;
+      }
+      if (output != it) {
+        *output = std::move(*it);
+      }
+      ++output;
+    }
+    traj_points.erase(output, traj_points.end());
+  }
+
+  template <size_t... Is>
+  void run_fused_batch(
+    CandidateBatch & batch, const TrajectoryOptimizerParams & params, std::index_sequence<Is...>)
+  {
+    (std::get<Is>(stages_).prepare(params), ...);
+    if (!(std::get<Is>(stages_).enabled() || ...)) {
+      return;
+    }
+    batch.erase_if([this](TrajectoryPoint & point) {
+      return !(process_if_enabled(std::get<Is>(stages_), point) && ...);
+    });
+  }
+
+  template <typename Stage>
+  static bool process_if_enabled(const Stage & stage, TrajectoryPoint & point)
+  {
+    return !stage.enabled() || stage.process(point);
+  }
+
+  template <size_t... Is>
+  void forward_parameters(
+    const std::vector<rclcpp::Parameter> & parameters, std::index_sequence<Is...>)
+  {
+    (
+      [&] {
+        if constexpr (!IsElementWise<StageType<Is>>::value) {
+          std::get<Is>(stages_).on_parameter(parameters);
+        }
+      }(),
+      ...);
+  }
+
+  std::tuple<Stages...> stages_;
+};
+
+namespace stages
+{
+/**
+ * @brief Raises velocity and acceleration to the pull out targets while the ego vehicle is slow.
+ */
+class EngageSpeedClamp
+{
+public:
+  static constexpr bool is_element_wise = true;
+
+  template <typename... Args>
+  explicit EngageSpeedClamp([[maybe_unused]] const Args &... args)
+  {
+  }
+
+  void prepare(const TrajectoryOptimizerParams & params)
+  {
+    const auto current_speed = params.current_odometry.twist.twist.linear.x;
+    const auto initial_motion = utils::get_initial_motion(params);
+    enabled_ = params.set_engage_speed && current_speed < params.target_pull_out_speed_mps;
+    min_velocity_ = static_cast<float>(initial_motion.speed_mps);
+    min_acceleration_ = static_cast<float>(initial_motion.acc_mps2);
+  }
+  bool enabled() const { return enabled_; }
+  bool process(TrajectoryPoint & point) const
+  {
+    point.longitudinal_velocity_mps = std::max(point.longitudinal_velocity_mps, min_velocity_);
+    point.acceleration_mps2 = std::max(point.acceleration_mps2, min_acceleration_);
+    return true;
+  }
+
+private:
+  bool enabled_{false};
+  float min_velocity_{0.0f};
+  float min_acceleration_{0.0f};
+};
+
+/**
+ * @brief Caps the velocity of every point to the maximum speed.
+ */
+class MaxSpeedLimit
+{
+public:
+  static constexpr bool is_element_wise = true;
+
+  template <typename... Args>
+  explicit MaxSpeedLimit([[maybe_unused]] const Args &... args)
+  {
+  }
+
+  void prepare(const TrajectoryOptimizerParams & params)
+  {
+    enabled_ = params.limit_speed;
+    max_velocity_ = static_cast<float>(params.max_speed_mps);
+  }
+  bool enabled() const { return enabled_; }
+  bool process(TrajectoryPoint & point) const
+  {
+    point.longitudinal_velocity_mps = std::min(point.longitudinal_velocity_mps, max_velocity_);
+    return true;
+  }
+
+private:
+  bool enabled_{false};
+  float max_velocity_{0.0f};
+};
+
+/**
+ * @brief Drops points with nan or inf values.
+ */
+class ValidPointFilter
+{
+public:
+  static constexpr bool is_element_wise = true;
+
+  template <typename... Args>
+  explicit ValidPointFilter([[maybe_unused]] const Args &... args)
+  {
+  }
+
+  void prepare([[maybe_unused]] const TrajectoryOptimizerParams & params) {}
+  bool enabled() const { return true; }
+  bool process(TrajectoryPoint & point) const { return utils::validate_point(point); }
+};
+}  // namespace stages
+}  // namespace autoware::trajectory_optimizer::pipeline
+
+#endif  // AUTOWARE__TRAJECTORY_OPTIMIZER_STATIC_PIPELINE_HPP_
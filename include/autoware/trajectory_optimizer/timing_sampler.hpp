@@ -0,0 +1,58 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__TRAJECTORY_OPTIMIZER_TIMING_SAMPLER_HPP_
+#define AUTOWARE__TRAJECTORY_OPTIMIZER_TIMING_SAMPLER_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace autoware::trajectory_optimizer
+{
+
+/**
+ * @brief Decides which cycles record the full processing time detail. Thread-safe.
+ * @details One cycle in every period is sampled, counting the cycles of all streams together; a
+ * period of 1 samples every cycle and 0 none. A cycle can also be forced, e.g. the one after a
+ * cycle that exceeded a latency threshold, since a cycle only knows it was slow once it is over.
+ */
+class TimingSampler
+{
+public:
+  explicit TimingSampler(const size_t period = 1) : period_(period) {}
+
+  void set_period(const size_t period) { period_.store(period, std::memory_order_relaxed); }
+  size_t period() const { return period_.load(std::memory_order_relaxed); }
+
+  /**
+   * @brief Requests the full detail of the next cycle.
+   */
+  void force_next() { forced_.store(true, std::memory_order_relaxed); }
+
+  /**
+   * @brief Starts a cycle.
+   *
+   * @return True if the cycle should record the full detail.
+   */
+  bool sample_cycle();
+
+private:
+  std::atomic<size_t> period_;
+  std::atomic<uint64_t> num_cycles_{0};
+  std::atomic<bool> forced_{false};
+};
+}  // namespace autoware::trajectory_optimizer
+
+#endif  // AUTOWARE__TRAJECTORY_OPTIMIZER_TIMING_SAMPLER_HPP_
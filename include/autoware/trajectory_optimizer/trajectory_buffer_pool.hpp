@@ -0,0 +1,68 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__TRAJECTORY_BUFFER_POOL_HPP_
+#define AUTOWARE__TRAJECTORY_BUFFER_POOL_HPP_
+
+#include <autoware_new_planning_msgs/msg/trajectories.hpp>
+
+#include <cstddef>
+#include <vector>
+
+namespace autoware::trajectory_optimizer
+{
+using autoware_new_planning_msgs::msg::Trajectories;
+using NewTrajectory = autoware_new_planning_msgs::msg::Trajectory;
+
+/**
+ * @brief Per-candidate-slot storage for the output message, kept alive across cycles.
+ * @details Each slot owns the point buffer of one candidate. Buffers are never released, so once
+ * the pool has seen the largest candidate count and size, copying the input into it does not
+ * allocate. Plugins double-buffer against these slots by writing into their own scratch buffer
+ * and swapping it with the slot, which recycles the old storage for the next call.
+ */
+class TrajectoryBufferPool
+{
+public:
+  /**
+   * @brief Copies the input candidates into the pooled output message.
+   *
+   * @param input The trajectories received in this cycle.
+   * @return Reference to the pooled message, valid until the next call.
+   */
+  Trajectories & acquire(const Trajectories & input);
+
+  /**
+   * @brief Creates slots up front and touches their memory, so that the first cycles do not
+   * allocate or page fault.
+   *
+   * @param num_slots The number of slots to be available.
+   * @param num_points The capacity of the point buffer of each slot.
+   */
+  void reserve(const size_t num_slots, const size_t num_points);
+
+  /**
+   * @brief Gets the number of slots held by the pool, including those unused in this cycle.
+   *
+   * @return The number of slots.
+   */
+  size_t slot_count() const { return message_.trajectories.size() + spare_slots_.size(); }
+
+private:
+  Trajectories message_;
+  std::vector<NewTrajectory> spare_slots_;
+};
+}  // namespace autoware::trajectory_optimizer
+
+#endif  // AUTOWARE__TRAJECTORY_BUFFER_POOL_HPP_
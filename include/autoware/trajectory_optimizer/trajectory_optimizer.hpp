@@ -17,20 +17,38 @@
 
 #include "autoware/path_smoother/elastic_band.hpp"
 #include "autoware/path_smoother/replan_checker.hpp"
-#include "autoware/trajectory_optimizer/trajectory_optimizer_plugins/trajectory_eb_smoother_optimizer.hpp"
-#include "autoware/trajectory_optimizer/trajectory_optimizer_plugins/trajectory_extender.hpp"
-#include "autoware/trajectory_optimizer/trajectory_optimizer_plugins/trajectory_optimizer_plugin_base.hpp"
-#include "autoware/trajectory_optimizer/trajectory_optimizer_plugins/trajectory_point_fixer.hpp"
-#include "autoware/trajectory_optimizer/trajectory_optimizer_plugins/trajectory_spline_smoother.hpp"
-#include "autoware/trajectory_optimizer/trajectory_optimizer_plugins/trajectory_velocity_optimizer.hpp"
+#include "autoware/trajectory_optimizer/bounded_trajectories.hpp"
+#include "autoware/trajectory_optimizer/candidate_clustering.hpp"
+#include "autoware/trajectory_optimizer/cost_model.hpp"
+#include "autoware/trajectory_optimizer/cycle_capture.hpp"
+#include "autoware/trajectory_optimizer/cycle_metrics.hpp"
+#include "autoware/trajectory_optimizer/lazy_trajectories_view.hpp"
+#include "autoware/trajectory_optimizer/perf_counters.hpp"
+#include "autoware/trajectory_optimizer/realtime_profile.hpp"
+#include "autoware/trajectory_optimizer/shadow_chain.hpp"
+#include "autoware/trajectory_optimizer/stamped_buffer.hpp"
+#include "autoware/trajectory_optimizer/timing_sampler.hpp"
+#include "autoware/trajectory_optimizer/trajectory_buffer_pool.hpp"
 #include "autoware/trajectory_optimizer/trajectory_optimizer_structs.hpp"
+#include "autoware/trajectory_optimizer/worker_pool.hpp"
 #include "autoware/velocity_smoother/smoother/jerk_filtered_smoother.hpp"
+#include "autoware_trajectory_optimizer/msg/candidate_costs.hpp"
+#include "autoware_trajectory_optimizer/msg/optimized_candidate.hpp"
+#include "autoware_trajectory_optimizer/msg/perf_counters.hpp"
+#include "autoware_trajectory_optimizer/srv/optimize_trajectories.hpp"
+
+#ifdef TRAJECTORY_OPTIMIZER_STATIC_PIPELINE
+#include "autoware/trajectory_optimizer/production_pipeline.hpp"
+#else
+#include "autoware/trajectory_optimizer/optimizer_chain.hpp"
+#endif
 
 #include <autoware_utils/ros/polling_subscriber.hpp>
 #include <autoware_utils/system/time_keeper.hpp>
 #include <rclcpp/rclcpp.hpp>
 #include <rclcpp/subscription.hpp>
 
+#include <autoware_internal_debug_msgs/msg/float64_stamped.hpp>
 #include <autoware_new_planning_msgs/msg/trajectories.hpp>
 #include <autoware_perception_msgs/msg/detail/predicted_objects__struct.hpp>
 #include <autoware_perception_msgs/msg/predicted_objects.hpp>
@@ -40,8 +58,17 @@
 #include <geometry_msgs/msg/accel_with_covariance_stamped.hpp>
 #include <nav_msgs/msg/odometry.hpp>
 
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <thread>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
 namespace autoware::trajectory_optimizer
@@ -55,8 +82,14 @@ using autoware::path_smoother::ReplanChecker;
 using SmootherTimekeeper = autoware::path_smoother::TimeKeeper;
 
 using autoware::velocity_smoother::JerkFilteredSmoother;
+using autoware_internal_debug_msgs::msg::Float64Stamped;
 using autoware_new_planning_msgs::msg::Trajectories;
 using autoware_perception_msgs::msg::PredictedObjects;
+using autoware_trajectory_optimizer::msg::CandidateCosts;
+using autoware_trajectory_optimizer::msg::OptimizedCandidate;
+using autoware_trajectory_optimizer::msg::PerfCounters;
+using autoware_trajectory_optimizer::msg::StagePerfCounters;
+using autoware_trajectory_optimizer::srv::OptimizeTrajectories;
 using autoware_planning_msgs::msg::Trajectory;
 using autoware_planning_msgs::msg::TrajectoryPoint;
 using geometry_msgs::msg::AccelWithCovarianceStamped;
@@ -64,18 +97,356 @@ using nav_msgs::msg::Odometry;
 using TrajectoryPoints = std::vector<TrajectoryPoint>;
 using NewTrajectory = autoware_new_planning_msgs::msg::Trajectory;
 
+// the chain is fixed at build time for production and configurable at runtime otherwise
+#ifdef TRAJECTORY_OPTIMIZER_STATIC_PIPELINE
+using TrajectoryOptimizerChain = pipeline::ProductionPipeline;
+#else
+using TrajectoryOptimizerChain = OptimizerChain;
+#endif
+
+/**
+ * @brief Applies only the jerk filtered velocity smoothing of a chain, timed as its velocity stage.
+ *
+ * @param chain The chain.
+ * @param traj_points The trajectory points to be smoothed.
+ * @param params The parameters for trajectory optimization.
+ */
+inline void smooth_velocity(
+  TrajectoryOptimizerChain & chain, TrajectoryPoints & traj_points,
+  const TrajectoryOptimizerParams & params)
+{
+#ifdef TRAJECTORY_OPTIMIZER_STATIC_PIPELINE
+  chain.stage<pipeline::stages::VelocityOptimizer>().smooth_velocity(traj_points, params);
+#else
+  chain.smooth_velocity(traj_points, params);
+#endif
+}
+
 class TrajectoryInterpolator : public rclcpp::Node
 {
 public:
   explicit TrajectoryInterpolator(const rclcpp::NodeOptions & options);
+  ~TrajectoryInterpolator() override;
 
 private:
-  void on_traj(const Trajectories::ConstSharedPtr msg);
+  /**
+   * @brief Optimizer chain together with the scratch state needed to run it on one thread.
+   * @details Chains other than the first are built on a helper node, since the smoothers declare
+   * their parameters on the node they are given. The smoothers keep a warm start across calls, so
+   * a chain only ever serves one stream, or the service.
+   */
+  struct OptimizerWorker
+  {
+    rclcpp::Node::SharedPtr helper_node;
+    std::shared_ptr<autoware_utils::TimeKeeper> time_keeper;
+    std::unique_ptr<TrajectoryOptimizerChain> chain_ptr;
+    // cost model: the cycle parameters with the stage times redirected to candidate_stage_timings,
+    // copied from the batch params_batch_id
+    TrajectoryOptimizerParams params;
+    uint64_t params_batch_id{0};
+    std::unique_ptr<PageFaultMonitor> page_fault_monitor_ptr;
+    // cost model: wall time of each stage on the current candidate
+    StageTimings candidate_stage_timings;
+    // held while the chain runs or its parameters are updated
+    std::mutex mutex;
+  };
+  // one chain per worker thread
+  using OptimizerWorkers = std::vector<std::unique_ptr<OptimizerWorker>>;
+
+  /**
+   * @brief Interfaces and cross-cycle state of one input trajectory stream, e.g. one vehicle in
+   * server mode.
+   */
+  struct StreamContext
+  {
+    std::string topic_prefix;
+    rclcpp::CallbackGroup::SharedPtr callback_group;
+    // processing time detail, one tree per sampled cycle
+    std::shared_ptr<autoware_utils::TimeKeeper> time_keeper;
+    rclcpp::Subscription<Trajectories>::SharedPtr trajectories_sub;
+    rclcpp::Publisher<Trajectories>::SharedPtr trajectories_pub;
+    // bounded transport: fixed-size interfaces, used instead of the ones above
+    rclcpp::Subscription<BoundedTrajectories>::SharedPtr bounded_trajectories_sub;
+    rclcpp::Publisher<BoundedTrajectories>::SharedPtr bounded_trajectories_pub;
+    // output used when the middleware cannot loan messages
+    std::unique_ptr<BoundedTrajectories> bounded_output_ptr;
+    // streaming output: each candidate as soon as it is optimized, tagged with cycle_id
+    rclcpp::Publisher<OptimizedCandidate>::SharedPtr candidate_pub;
+    uint64_t cycle_id{0};
+    rclcpp::Publisher<Float64Stamped>::SharedPtr processing_time_pub;
+    // freshness and throughput of each cycle
+    rclcpp::Publisher<CycleMetrics>::SharedPtr cycle_metrics_pub;
+    ThroughputMeter throughput_meter;
+    // comparison with the shadow chain on sampled cycles, null when the shadow chain is disabled
+    rclcpp::Publisher<ShadowMetrics>::SharedPtr shadow_metrics_pub;
+    // middleware receive time of the candidates being processed, if reported
+    std::optional<int64_t> input_received_ns;
+    std::unique_ptr<autoware_utils::InterProcessPollingSubscriber<Odometry>> sub_current_odometry;
+    std::unique_ptr<autoware_utils::InterProcessPollingSubscriber<AccelWithCovarianceStamped>>
+      sub_current_acceleration;
+    std::unique_ptr<autoware_utils::InterProcessPollingSubscriber<Trajectory>>
+      sub_previous_trajectory;
+    // lockstep mode: inputs indexed by stamp and candidates waiting for them, in arrival order
+    rclcpp::Subscription<Odometry>::SharedPtr odometry_sub;
+    rclcpp::Subscription<AccelWithCovarianceStamped>::SharedPtr acceleration_sub;
+    rclcpp::Subscription<Trajectory>::SharedPtr previous_trajectory_sub;
+    StampedBuffer<Odometry> odometry_buffer;
+    StampedBuffer<AccelWithCovarianceStamped> acceleration_buffer;
+    StampedBuffer<Trajectory> previous_trajectory_buffer;
+    std::deque<std::pair<Trajectories::ConstSharedPtr, std::optional<int64_t>>>
+      pending_trajectories;
+    std::optional<int64_t> last_lockstep_stamp;
+    // lockstep mode: candidates given an empty output since the last cycle metrics
+    uint32_t num_skipped_cycles{0};
+    // lazy deserialization and bounded transport: input decoded into a message reused across cycles
+    LazyTrajectoriesView trajectories_view;
+    std::shared_ptr<Trajectories> decoded_trajectories_ptr;
+    // lazy deserialization: the message of the running cycle, null outside of it
+    const rclcpp::SerializedMessage * serialized_input_ptr{nullptr};
+    // last time a trajectory was received
+    rclcpp::Time last_time;
+    Trajectory past_ego_state_trajectory;
+    // parameters of the current cycle, kept to reuse the ego history buffer
+    TrajectoryOptimizerParams cycle_params;
+    // output storage reused across cycles
+    TrajectoryBufferPool buffer_pool;
+    std::unique_ptr<PageFaultMonitor> page_fault_monitor_ptr;
+    // slow cycle capture: wall time of each stage in the current cycle
+    std::unique_ptr<StageTimings> stage_timings_ptr;
+    // cost model: dispatch order of the current cycle, and its predicted and measured times
+    CandidateSchedule schedule;
+    rclcpp::Publisher<CandidateCosts>::SharedPtr candidate_costs_pub;
+    // candidate clustering: representative of each candidate of the current cycle
+    CandidateClusters clusters;
+    // chains of the stream, holding its smoother warm starts: the streams split the worker
+    // threads between them, with at least one chain each
+    OptimizerWorkers workers;
+  };
+
+  void on_traj(const Trajectories::ConstSharedPtr msg, StreamContext & stream);
+  void publish_output(const Trajectories & output_trajectories, StreamContext & stream);
+  void on_serialized_traj(
+    const rclcpp::SerializedMessage & serialized_msg, StreamContext & stream);
+
+  /**
+   * @brief Decodes the selected candidates of a serialized message into the stream's message.
+   *
+   * @param serialized_msg The serialized Trajectories message.
+   * @param stream The stream the message belongs to.
+   * @return False if the lazy view does not support the message encoding.
+   */
+  bool decode_selected_candidates(
+    const rclcpp::SerializedMessage & serialized_msg, StreamContext & stream);
+  void deserialize_selected_candidates(
+    const rclcpp::SerializedMessage & serialized_msg, StreamContext & stream);
+  void set_up_lockstep_subscriptions(
+    StreamContext & stream, const rclcpp::SubscriptionOptions & subscription_options);
+
+  /**
+   * @brief Runs the pending candidates of a lockstep stream whose inputs are complete.
+   *
+   * @param stream The stream whose inputs were updated.
+   */
+  void process_lockstep(StreamContext & stream);
+
+  /**
+   * @brief Publishes an empty output for lockstep candidates that cannot be processed, and counts
+   * them in the cycle metrics.
+   *
+   * @param input The skipped candidates.
+   * @param stream The stream the candidates belong to.
+   */
+  void skip_lockstep_cycle(const Trajectories & input, StreamContext & stream);
+  void publish_empty_output(const Trajectories & input, StreamContext & stream);
+
+  /**
+   * @brief Optimizes and publishes the candidates of one cycle of a stream.
+   *
+   * @param msg The candidates received.
+   * @param stream The stream the candidates belong to.
+   * @param cycle_time Time of the cycle: the current time, or the candidates' stamp in lockstep
+   * mode.
+   * @param current_odometry_ptr The ego odometry of the cycle.
+   * @param current_acceleration_ptr The ego acceleration of the cycle.
+   * @param previous_trajectory_ptr The trajectory selected downstream in a previous cycle.
+   */
+  void run_cycle(
+    const Trajectories::ConstSharedPtr msg, StreamContext & stream,
+    const rclcpp::Time & cycle_time, const Odometry::ConstSharedPtr current_odometry_ptr,
+    const AccelWithCovarianceStamped::ConstSharedPtr current_acceleration_ptr,
+    const Trajectory::ConstSharedPtr previous_trajectory_ptr);
+
+  /**
+   * @brief Optimizes the trajectories of a request with the inputs it carries, independently of
+   * the input streams.
+   *
+   * @param request The candidates together with the ego state and history.
+   * @param response The optimized candidates, or an error message if optimization failed.
+   */
+  void on_optimize_trajectories(
+    const OptimizeTrajectories::Request::SharedPtr request,
+    OptimizeTrajectories::Response::SharedPtr response);
+
+  /**
+   * @brief Takes a set of service chains no other request is using, building one if needed.
+   *
+   * @return The chains, to be handed back with release_service_workers().
+   */
+  OptimizerWorkers & acquire_service_workers();
+  void release_service_workers(OptimizerWorkers & workers);
+
+  /**
+   * @brief Optimizes every candidate in place, in parallel if there is more than one worker.
+   * @details With the cost model, the candidates are handed to the workers longest predicted
+   * first, and the model learns from the stage times of every candidate. With candidate
+   * clustering, the chain only runs on the representative of each cluster, and the other members
+   * are projected onto its output by the worker that optimized it.
+   *
+   * @param trajectories The candidates to be optimized.
+   * @param cycle_params The parameters and ego state of the cycle.
+   * @param workers The chains of the stream, or of the service.
+   * @param schedule Scratch of the cost model, holding the predicted and measured times once the
+   * candidates are optimized. Ignored without the cost model.
+   * @param clusters Output, the clustering of the candidates, empty without clustering.
+   * @param on_candidate_optimized Called with the candidate index once it is optimized, possibly
+   * from a worker thread.
+   */
+  void optimize_candidates(
+    Trajectories & trajectories, const TrajectoryOptimizerParams & cycle_params,
+    OptimizerWorkers & workers, CandidateSchedule & schedule, CandidateClusters & clusters,
+    const std::function<void(size_t)> & on_candidate_optimized = nullptr);
+
+  /**
+   * @brief Gives a cluster member the path of its optimized representative, with its own
+   * velocities under the engage speed and speed limit of the velocity optimizer.
+   * @details With smooth_velocities, the velocities are then smoothed by the velocity smoother of
+   * the worker's chain, which resamples the path as it does in the chain.
+   *
+   * @param representative The optimized representative.
+   * @param member The member before optimization, updated in place.
+   * @param cycle_params The parameters and ego state of the cycle.
+   * @param worker The worker whose chain smooths the velocities.
+   */
+  void project_cluster_member(
+    const NewTrajectory & representative, NewTrajectory & member,
+    const TrajectoryOptimizerParams & cycle_params, OptimizerWorker & worker);
+  void publish_candidate(
+    StreamContext & stream, const size_t index, const size_t total,
+    const NewTrajectory & trajectory);
+  NewTrajectory create_output_trajectory_from_past(
+    const Trajectory & previous_trajectory, const Trajectories & input,
+    const Odometry & current_odometry, const rclcpp::Time & stamp) const;
+
+  /**
+   * @brief Runs the chain of a worker on one candidate.
+   *
+   * @param trajectory The candidate, optimized in place.
+   * @param cycle_params The parameters and ego state of the cycle.
+   * @param worker The worker whose chain is used.
+   * @param features The features of the candidate to train the cost model with, null to leave
+   * the model unchanged. The chain then runs on a copy of the cycle parameters held by the worker.
+   * @param batch_id The call of optimize_candidates() the candidate belongs to, the worker copies
+   * the cycle parameters again when it changes.
+   * @return The wall time of the chain in milliseconds.
+   */
+  double optimize_candidate(
+    NewTrajectory & trajectory, const TrajectoryOptimizerParams & cycle_params,
+    OptimizerWorker & worker, const CandidateFeatures * features = nullptr,
+    const uint64_t batch_id = 0);
   void set_up_params();
+  void set_up_streams();
   void initialize_planners();
   void reset_previous_data();
   void initialize_optimizers();
-  bool initialized_optimizers_{false};
+
+  /**
+   * @brief Creates the chains of a stream, or of the service.
+   * @details The first chain of the first stream is built on this node, every other one on a
+   * helper node. Without a worker pool the chains record their scopes in the cycle's time keeper,
+   * otherwise each one in a time keeper of its own.
+   *
+   * @param topic_prefix The prefix of the debug topics of the chains.
+   * @param name_prefix The prefix of the helper node names, empty for the first stream.
+   * @param num_workers The number of chains, i.e. of candidates optimized in parallel.
+   * @param cycle_time_keeper The time keeper of the cycles of the stream, null for the service,
+   * whose requests are never sampled.
+   * @return The chains.
+   */
+  OptimizerWorkers create_workers(
+    const std::string & topic_prefix, const std::string & name_prefix, const size_t num_workers,
+    const std::shared_ptr<autoware_utils::TimeKeeper> & cycle_time_keeper);
+  std::unique_ptr<OptimizerWorker> create_worker(
+    const std::string & topic_prefix, const std::string & name_prefix, const size_t worker_id,
+    const std::shared_ptr<autoware_utils::TimeKeeper> & cycle_time_keeper);
+
+  /**
+   * @brief Creates a node holding the parameters of a chain other than the first one.
+   *
+   * @param name_suffix The suffix of the node name.
+   * @param parameters The parameters of the node.
+   * @return The node.
+   */
+  rclcpp::Node::SharedPtr create_helper_node(
+    const std::string & name_suffix, const std::vector<rclcpp::Parameter> & parameters);
+  void set_up_shadow();
+  std::unique_ptr<OptimizerWorker> create_shadow_worker();
+
+  /**
+   * @brief Hands a copy of the cycle to the shadow chain if the cycle is sampled and the shadow
+   * chain is idle; the comparison is published on the shadow thread once it finishes.
+   * @details The shadow chain projects the members of the clusters of the primary chain, so that
+   * clustering does not show up as a difference between the two configurations.
+   *
+   * @param stream The stream of the cycle.
+   * @param input The candidates received.
+   * @param primary_output The candidates optimized by the primary chain, in input order.
+   * @param num_candidates The number of optimized candidates at the front of primary_output.
+   * @param cycle_params The parameters and ego state of the cycle.
+   * @param primary_processing_time_ms The time the primary chain took to optimize the candidates.
+   */
+  void offer_shadow_cycle(
+    StreamContext & stream, const Trajectories & input, const Trajectories & primary_output,
+    const size_t num_candidates, const TrajectoryOptimizerParams & cycle_params,
+    const double primary_processing_time_ms);
+  void set_up_perf_counters();
+  void publish_perf_counters();
+  void set_up_cost_model();
+
+  /**
+   * @brief Publishes the predicted and measured time of every candidate of a cycle.
+   *
+   * @param stream The stream of the cycle.
+   * @param makespan_ms The time the workers took to optimize every candidate.
+   */
+  void publish_candidate_costs(StreamContext & stream, const double makespan_ms);
+  void set_up_slow_cycle_capture();
+
+  /**
+   * @brief Queues the inputs, parameters and stage times of a cycle to be written to disk if the
+   * cycle was slow and the rate limit allows it.
+   *
+   * @param stream The stream of the cycle.
+   * @param processing_time_ms The end-to-end processing time of the cycle.
+   * @param trajectories The candidates received.
+   * @param current_odometry The ego odometry of the cycle.
+   * @param current_acceleration The ego acceleration of the cycle.
+   * @param previous_trajectory_ptr The previous trajectory of the cycle, if any.
+   * @param cycle_time Time of the cycle.
+   */
+  void capture_slow_cycle(
+    StreamContext & stream, const double processing_time_ms, const Trajectories & trajectories,
+    const Odometry & current_odometry, const AccelWithCovarianceStamped & current_acceleration,
+    const Trajectory::ConstSharedPtr previous_trajectory_ptr, const rclcpp::Time & cycle_time);
+  void set_up_realtime_profile();
+  /**
+   * @brief Starts one executor thread per stream, owned by this node and running the callbacks of
+   * its stream only, so that the real-time profile is applied to threads of this node alone.
+   * @details Without the real-time profile, the streams run on the executor the node is added to.
+   */
+  void start_stream_executors();
+  void configure_realtime_thread();
+  void report_page_faults(const PageFaults & page_faults, const std::string & context);
+  std::once_flag initialize_optimizers_flag_;
 
   /**
    * @brief Callback for parameter updates
@@ -85,46 +456,82 @@ private:
   rcl_interfaces::msg::SetParametersResult on_parameter(
     const std::vector<rclcpp::Parameter> & parameters);
 
-  // Optimizer pointers
-  std::shared_ptr<plugin::TrajectoryEBSmootherOptimizer> eb_smoother_optimizer_ptr_;
-  std::shared_ptr<plugin::TrajectoryExtender> trajectory_extender_ptr_;
-  std::shared_ptr<plugin::TrajectoryPointFixer> trajectory_point_fixer_ptr_;
-  std::shared_ptr<plugin::TrajectorySplineSmoother> trajectory_spline_smoother_ptr_;
-  std::shared_ptr<plugin::TrajectoryVelocityOptimizer> trajectory_velocity_optimizer_ptr_;
-
-  // interface subscriber
-  rclcpp::Subscription<Trajectories>::SharedPtr trajectories_sub_;
-  // interface publisher
-  rclcpp::Publisher<Trajectories>::SharedPtr trajectories_pub_;
-  rclcpp::Publisher<autoware_utils::ProcessingTimeDetail>::SharedPtr debug_processing_time_detail_;
-
-  autoware_utils::InterProcessPollingSubscriber<Odometry> sub_current_odometry_{
-    this, "~/input/odometry"};
-  autoware_utils::InterProcessPollingSubscriber<AccelWithCovarianceStamped>
-    sub_current_acceleration_{this, "~/input/acceleration"};
-  autoware_utils::InterProcessPollingSubscriber<Trajectory> sub_previous_trajectory_{
-    this, "~/input/previous_trajectory"};
-
-  Odometry::ConstSharedPtr current_odometry_ptr_;  // current odometry
-  AccelWithCovarianceStamped::ConstSharedPtr current_acceleration_ptr_;
-  Trajectory::ConstSharedPtr previous_trajectory_ptr_;
-  Trajectory::ConstSharedPtr previous_output_ptr_;
+  /**
+   * @brief Updates the chain parameters that are read from the node.
+   *
+   * @param parameters The parameters to be applied.
+   * @param params The parameters of a chain, updated in place.
+   */
+  static void update_optimizer_params(
+    const std::vector<rclcpp::Parameter> & parameters, TrajectoryOptimizerParams & params);
+
+  // input streams, a single one unless server mode is enabled
+  std::vector<std::unique_ptr<StreamContext>> streams_;
+  // synchronous interface for batch clients
+  rclcpp::CallbackGroup::SharedPtr service_callback_group_;
+  rclcpp::Service<OptimizeTrajectories>::SharedPtr optimize_trajectories_srv_;
+  // chains of the service, one set per request in flight so that a request never runs on the
+  // smoother warm start of a concurrent one; sets are built on demand and kept, so there are as
+  // many as the peak number of concurrent requests
+  std::mutex service_workers_mutex_;
+  std::vector<std::unique_ptr<OptimizerWorkers>> service_workers_;
+  std::vector<OptimizerWorkers *> idle_service_workers_;
+  // sets built or being built, numbering the helper nodes
+  size_t num_service_worker_sets_{0};
+  // calls of optimize_candidates(), which may run concurrently for the service
+  std::atomic<uint64_t> num_candidate_batches_{0};
+  // runs the candidates of a cycle in parallel, null when there is a single worker
+  std::unique_ptr<WorkerPool> worker_pool_ptr_;
+  size_t num_worker_threads_{1};
+  // depth of the lockstep input queues, 0 when lockstep mode is disabled
+  size_t lockstep_queue_size_{0};
+  bool bounded_transport_{false};
+  // candidate selection applied before decoding the points
+  bool lazy_deserialization_{false};
+  size_t max_selected_candidates_{0};
+  bool deduplicate_candidates_{false};
+  // largest deviation of a candidate from the representative it is projected onto, unset when
+  // candidate clustering is disabled
+  std::optional<double> clustering_tolerance_m_;
+  CycleMetricsThresholds cycle_metrics_thresholds_;
 
   rclcpp::Publisher<autoware_utils::ProcessingTimeDetail>::SharedPtr
     debug_processing_time_detail_pub_;
   mutable std::shared_ptr<autoware_utils::TimeKeeper> time_keeper_{nullptr};
-  // Velocity smoothing
-  std::shared_ptr<rclcpp::Time> last_time_{nullptr};
+  // cycles that record the processing time detail, the others only report their totals
+  TimingSampler timing_sampler_;
+  std::atomic<bool> profile_after_breach_{true};
+
+  // hardware counters per plugin stage, summed over the cycles between two reports
+  std::unique_ptr<PerfCounterAggregator> perf_counter_aggregator_ptr_;
+  rclcpp::Publisher<PerfCounters>::SharedPtr perf_counters_pub_;
+  // learned optimization time of the candidates, null when disabled
+  std::unique_ptr<CandidateCostModel> cost_model_ptr_;
+  // writes the inputs of slow cycles to disk, null when disabled
+  std::unique_ptr<SlowCycleRecorder> slow_cycle_recorder_ptr_;
 
-  // variables for previous information
-  std::shared_ptr<TrajectoryPoints> prev_optimized_traj_points_ptr_{nullptr};
+  // real-time execution settings
+  std::unique_ptr<RealtimeProfile> realtime_profile_ptr_;
+  std::mutex realtime_threads_mutex_;
+  std::unordered_set<std::thread::id> realtime_threads_;
+  // with the real-time profile, the executors of the stream callback groups and their threads
+  std::vector<rclcpp::executors::SingleThreadedExecutor::SharedPtr> stream_executors_;
+  std::vector<std::thread> stream_executor_threads_;
   // parameters
   CommonParam common_param_;
   EgoNearestParam ego_nearest_param_;
 
-  Trajectory past_ego_state_trajectory_;
+  // shared by all streams, read under params_mutex_ at the start of each cycle
+  std::mutex params_mutex_;
   TrajectoryOptimizerParams params_;
+  // shadow chain parameters that differ from params_, without their prefix, under params_mutex_
+  std::vector<rclcpp::Parameter> shadow_overrides_;
   OnSetParametersCallbackHandle::SharedPtr set_param_res_;
+
+  // shadow chain, null when disabled; declared last so that its thread stops first
+  TimingSampler shadow_sampler_{0};
+  std::unique_ptr<OptimizerWorker> shadow_worker_ptr_;
+  std::unique_ptr<ShadowRunner> shadow_runner_ptr_;
 };
 
 }  // namespace autoware::trajectory_optimizer
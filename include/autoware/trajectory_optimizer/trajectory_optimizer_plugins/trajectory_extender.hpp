@@ -43,9 +43,6 @@ public:
   void set_up_params() override;
   rcl_interfaces::msg::SetParametersResult on_parameter(
     const std::vector<rclcpp::Parameter> & parameters) override;
-
-private:
-  Trajectory past_ego_state_trajectory_;
 };
 }  // namespace autoware::trajectory_optimizer::plugin
 
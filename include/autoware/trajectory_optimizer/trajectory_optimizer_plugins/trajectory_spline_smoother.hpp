@@ -42,6 +42,10 @@ public:
   void set_up_params() override;
   rcl_interfaces::msg::SetParametersResult on_parameter(
     const std::vector<rclcpp::Parameter> & parameters) override;
+
+private:
+  // back buffer swapped with the input on every call, keeps its capacity across cycles
+  TrajectoryPoints scratch_points_;
 };
 }  // namespace autoware::trajectory_optimizer::plugin
 
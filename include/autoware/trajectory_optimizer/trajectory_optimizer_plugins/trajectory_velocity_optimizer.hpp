@@ -29,6 +29,20 @@ using autoware_planning_msgs::msg::TrajectoryPoint;
 using TrajectoryPoints = std::vector<TrajectoryPoint>;
 using autoware::velocity_smoother::JerkFilteredSmoother;
 
+/**
+ * @brief JerkFilteredSmoother whose time keeper can be switched between cycles.
+ */
+class SampledJerkFilteredSmoother : public JerkFilteredSmoother
+{
+public:
+  using JerkFilteredSmoother::JerkFilteredSmoother;
+
+  void set_time_keeper(const std::shared_ptr<autoware_utils_debug::TimeKeeper> & time_keeper)
+  {
+    time_keeper_ = time_keeper;
+  }
+};
+
 class TrajectoryVelocityOptimizer : public TrajectoryOptimizerPluginBase
 {
 public:
@@ -37,16 +51,25 @@ public:
     const std::shared_ptr<autoware_utils_debug::TimeKeeper> time_keeper,
     const TrajectoryOptimizerParams & params);
 
-  void set_up_velocity_smoother(
-    rclcpp::Node * node_ptr, const std::shared_ptr<autoware_utils_debug::TimeKeeper> time_keeper);
+  void set_up_velocity_smoother(rclcpp::Node * node_ptr);
   void optimize_trajectory(
     TrajectoryPoints & traj_points, const TrajectoryOptimizerParams & params) override;
+  /**
+   * @brief Applies only the jerk filtered velocity smoothing, without engage speed and speed limit.
+   *
+   * @param traj_points The trajectory points to be smoothed.
+   * @param params The parameters for trajectory optimization.
+   */
+  void smooth_velocity(TrajectoryPoints & traj_points, const TrajectoryOptimizerParams & params);
   void set_up_params() override;
   rcl_interfaces::msg::SetParametersResult on_parameter(
     const std::vector<rclcpp::Parameter> & parameters) override;
 
 private:
-  std::shared_ptr<JerkFilteredSmoother> jerk_filtered_smoother_{nullptr};
+  std::shared_ptr<SampledJerkFilteredSmoother> jerk_filtered_smoother_{nullptr};
+  // reports nowhere, for the smoother's scopes on cycles that are not sampled
+  std::shared_ptr<autoware_utils_debug::TimeKeeper> silent_time_keeper_{
+    std::make_shared<autoware_utils_debug::TimeKeeper>()};
 };
 }  // namespace autoware::trajectory_optimizer::plugin
 
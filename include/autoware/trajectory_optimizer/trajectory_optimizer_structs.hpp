@@ -14,12 +14,17 @@
 
 #ifndef AUTOWARE__TRAJECTORY_OPTIMIZER_STRUCTS_HPP_
 #define AUTOWARE__TRAJECTORY_OPTIMIZER_STRUCTS_HPP_
+#include <autoware_planning_msgs/msg/trajectory_point.hpp>
 #include <geometry_msgs/msg/accel_with_covariance_stamped.hpp>
 #include <nav_msgs/msg/detail/odometry__struct.hpp>
 #include <nav_msgs/msg/odometry.hpp>
 
+#include <vector>
+
 namespace autoware::trajectory_optimizer
 {
+class PerfCounterAggregator;
+class StageTimings;
 using geometry_msgs::msg::AccelWithCovarianceStamped;
 using nav_msgs::msg::Odometry;
 
@@ -49,6 +54,14 @@ struct TrajectoryOptimizerParams
   bool extend_trajectory_backward{false};
   Odometry current_odometry;
   AccelWithCovarianceStamped current_acceleration;
+  // past ego states of the stream being optimized, oldest first
+  std::vector<autoware_planning_msgs::msg::TrajectoryPoint> ego_history_points;
+  // hardware counters per plugin stage, null when not measured
+  PerfCounterAggregator * perf_counter_aggregator{nullptr};
+  // wall time per plugin stage, null when not measured
+  StageTimings * stage_timings{nullptr};
+  // whether the cycle records the full processing time detail, see TimingSampler
+  bool detailed_timing{true};
 };
 }  // namespace autoware::trajectory_optimizer
 #endif  // AUTOWARE__TRAJECTORY_OPTIMIZER_STRUCTS_HPP_
@@ -72,6 +72,19 @@ bool validate_point(const TrajectoryPoint & point);
  */
 void apply_spline(TrajectoryPoints & traj_points, const TrajectoryOptimizerParams & params);
 
+/**
+ * @brief Interpolates the given trajectory points, writing the result into a reusable buffer.
+ *
+ * @param traj_points The trajectory points to be interpolated.
+ * @param params The parameters for trajectory interpolation.
+ * @param scratch_points Buffer that receives the interpolated points before being swapped with
+ * traj_points. On return it holds the previous storage of traj_points, so passing the same buffer
+ * on every call avoids reallocating once it has grown to the trajectory size.
+ */
+void apply_spline(
+  TrajectoryPoints & traj_points, const TrajectoryOptimizerParams & params,
+  TrajectoryPoints & scratch_points);
+
 /**
  * @brief Interpolates the given trajectory points based on the current odometry and acceleration.
  *
@@ -115,6 +128,16 @@ void filter_velocity(
   const TrajectoryOptimizerParams & params, const std::shared_ptr<JerkFilteredSmoother> & smoother,
   const Odometry & current_odometry);
 
+/**
+ * @brief Gets the speed and acceleration the velocity profile should start from.
+ * @details Below the pull out speed, the target pull out speed and acceleration are used so that
+ * the ego vehicle can start moving from a stop.
+ *
+ * @param params The parameters for trajectory interpolation, including the current ego state.
+ * @return The initial motion.
+ */
+InitialMotion get_initial_motion(const TrajectoryOptimizerParams & params);
+
 /**
  * @brief Clamps the velocities of the input trajectory points to the specified minimum values.
  *
@@ -0,0 +1,86 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__TRAJECTORY_OPTIMIZER_WORKER_POOL_HPP_
+#define AUTOWARE__TRAJECTORY_OPTIMIZER_WORKER_POOL_HPP_
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace autoware::trajectory_optimizer
+{
+
+/**
+ * @brief Fixed set of threads running batches of independent tasks.
+ * @details Several callers may submit batches concurrently, e.g. one per input stream; batches
+ * are served in submission order and the tasks of a batch are handed out in index order. Tasks
+ * must not submit batches themselves.
+ */
+class WorkerPool
+{
+public:
+  using Task = std::function<void(size_t task_index, size_t worker_id)>;
+
+  /**
+   * @brief Starts the worker threads.
+   *
+   * @param num_workers The number of threads.
+   * @param on_worker_start Called on each thread before it runs any task, e.g. to set its
+   * scheduling policy.
+   */
+  WorkerPool(const size_t num_workers, const std::function<void(size_t)> & on_worker_start);
+  ~WorkerPool();
+  WorkerPool(const WorkerPool &) = delete;
+  WorkerPool & operator=(const WorkerPool &) = delete;
+
+  /**
+   * @brief Runs task(i, worker_id) for every i in [0, num_tasks) and waits for all of them.
+   * @details The first exception thrown by a task is rethrown once the batch has finished.
+   *
+   * @param num_tasks The number of tasks in the batch.
+   * @param task The task to be run.
+   */
+  void parallel_for(const size_t num_tasks, const Task & task);
+
+  size_t size() const { return threads_.size(); }
+
+private:
+  struct Batch
+  {
+    size_t num_tasks{0};
+    const Task * task{nullptr};
+    size_t next_index{0};
+    size_t completed{0};
+    std::exception_ptr exception;
+    std::condition_variable done;
+  };
+
+  void run_worker(const size_t worker_id);
+
+  std::mutex mutex_;
+  std::condition_variable work_available_;
+  std::deque<Batch *> batches_;
+  bool stop_{false};
+  std::function<void(size_t)> on_worker_start_;
+  std::vector<std::thread> threads_;
+};
+}  // namespace autoware::trajectory_optimizer
+
+#endif  // AUTOWARE__TRAJECTORY_OPTIMIZER_WORKER_POOL_HPP_
@@ -0,0 +1,121 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/trajectory_optimizer/bounded_trajectories.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+namespace autoware::trajectory_optimizer
+{
+using autoware_trajectory_optimizer::msg::BoundedTrajectory;
+
+namespace
+{
+/**
+ * @brief Copies a string into a null-terminated fixed-size array.
+ *
+ * @param str The string to be copied.
+ * @param bounded_str Output array.
+ * @return False if the string had to be cut.
+ */
+template <size_t N>
+bool copy_to_bounded(const std::string & str, std::array<uint8_t, N> & bounded_str)
+{
+  // one byte is kept for the terminator
+  const auto length = std::min<size_t>(str.size(), N - 1);
+  std::memcpy(bounded_str.data(), str.data(), length);
+  bounded_str[length] = 0;
+  return length == str.size();
+}
+
+template <size_t N>
+void copy_from_bounded(const std::array<uint8_t, N> & bounded_str, std::string & str)
+{
+  str.assign(bounded_str.begin(), std::find(bounded_str.begin(), bounded_str.end(), 0));
+}
+}  // namespace
+
+bool to_bounded(const Trajectories & trajectories, BoundedTrajectories & bounded_trajectories)
+{
+  bool complete = true;
+  const auto num_trajectories = std::min<size_t>(
+    trajectories.trajectories.size(), BoundedTrajectories::MAX_TRAJECTORIES);
+  complete &= num_trajectories == trajectories.trajectories.size();
+  bounded_trajectories.num_trajectories = static_cast<uint8_t>(num_trajectories);
+
+  for (size_t i = 0; i < num_trajectories; ++i) {
+    const auto & trajectory = trajectories.trajectories[i];
+    auto & bounded_trajectory = bounded_trajectories.trajectories[i];
+    bounded_trajectory.stamp = trajectory.header.stamp;
+    bounded_trajectory.generator_id = trajectory.generator_id;
+    bounded_trajectory.score = trajectory.score;
+    complete &= copy_to_bounded(trajectory.header.frame_id, bounded_trajectory.frame_id);
+
+    const auto num_points =
+      std::min<size_t>(trajectory.points.size(), BoundedTrajectory::MAX_POINTS);
+    complete &= num_points == trajectory.points.size();
+    bounded_trajectory.num_points = static_cast<uint16_t>(num_points);
+    std::copy_n(trajectory.points.begin(), num_points, bounded_trajectory.points.begin());
+  }
+
+  const auto num_generator_info = std::min<size_t>(
+    trajectories.generator_info.size(), BoundedTrajectories::MAX_GENERATOR_INFO);
+  complete &= num_generator_info == trajectories.generator_info.size();
+  bounded_trajectories.num_generator_info = static_cast<uint8_t>(num_generator_info);
+  for (size_t i = 0; i < num_generator_info; ++i) {
+    const auto & generator_info = trajectories.generator_info[i];
+    auto & bounded_generator_info = bounded_trajectories.generator_info[i];
+    bounded_generator_info.generator_id = generator_info.generator_id;
+    complete &= copy_to_bounded(
+      generator_info.generator_name.data, bounded_generator_info.generator_name);
+  }
+  return complete;
+}
+
+void from_bounded(const BoundedTrajectories & bounded_trajectories, Trajectories & trajectories)
+{
+  const auto num_trajectories = std::min<size_t>(
+    bounded_trajectories.num_trajectories, BoundedTrajectories::MAX_TRAJECTORIES);
+  trajectories.trajectories.resize(num_trajectories);
+
+  for (size_t i = 0; i < num_trajectories; ++i) {
+    const auto & bounded_trajectory = bounded_trajectories.trajectories[i];
+    auto & trajectory = trajectories.trajectories[i];
+    trajectory.header.stamp = bounded_trajectory.stamp;
+    copy_from_bounded(bounded_trajectory.frame_id, trajectory.header.frame_id);
+    trajectory.generator_id = bounded_trajectory.generator_id;
+    trajectory.score = bounded_trajectory.score;
+
+    const auto num_points =
+      std::min<size_t>(bounded_trajectory.num_points, BoundedTrajectory::MAX_POINTS);
+    trajectory.points.assign(
+      bounded_trajectory.points.begin(), bounded_trajectory.points.begin() + num_points);
+  }
+
+  const auto num_generator_info = std::min<size_t>(
+    bounded_trajectories.num_generator_info, BoundedTrajectories::MAX_GENERATOR_INFO);
+  trajectories.generator_info.resize(num_generator_info);
+  for (size_t i = 0; i < num_generator_info; ++i) {
+    const auto & bounded_generator_info = bounded_trajectories.generator_info[i];
+    auto & generator_info = trajectories.generator_info[i];
+    generator_info.generator_id = bounded_generator_info.generator_id;
+    copy_from_bounded(bounded_generator_info.generator_name, generator_info.generator_name.data);
+  }
+}
+
+}  // namespace autoware::trajectory_optimizer
@@ -0,0 +1,66 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/trajectory_optimizer/candidate_batch.hpp"
+
+#include "autoware/trajectory_optimizer/simd_kernels.hpp"
+
+namespace autoware::trajectory_optimizer
+{
+void CandidateBatch::assign(const std::vector<NewTrajectory> & trajectories)
+{
+  size_t num_points = 0;
+  for (const auto & trajectory : trajectories) {
+    num_points += trajectory.points.size();
+  }
+  points_.clear();
+  points_.reserve(num_points);
+  offsets_.resize(trajectories.size() + 1);
+  offsets_[0] = 0;
+  for (size_t i = 0; i < trajectories.size(); ++i) {
+    points_.insert(points_.end(), trajectories[i].points.begin(), trajectories[i].points.end());
+    offsets_[i + 1] = points_.size();
+  }
+}
+
+void CandidateBatch::copy_to(std::vector<NewTrajectory> & trajectories) const
+{
+  for (size_t i = 0; i < num_candidates() && i < trajectories.size(); ++i) {
+    trajectories[i].points.assign(
+      points_.begin() + static_cast<std::ptrdiff_t>(offsets_[i]),
+      points_.begin() + static_cast<std::ptrdiff_t>(offsets_[i + 1]));
+  }
+}
+
+void CandidateBatch::remove_non_finite_points()
+{
+  flags_.resize(points_.size());
+  simd::flag_invalid_points(points_.data(), points_.size(), flags_.data());
+  // the predicate sees every point at its original index
+  erase_if([&](const TrajectoryPoint & point) {
+    return flags_[static_cast<size_t>(&point - points_.data())] != 0;
+  });
+}
+
+void CandidateBatch::clamp_velocities(const float min_velocity, const float min_acceleration)
+{
+  simd::clamp_min_velocity_and_acceleration(
+    points_.data(), points_.size(), min_velocity, min_acceleration);
+}
+
+void CandidateBatch::set_max_velocity(const float max_velocity)
+{
+  simd::clamp_max_velocity(points_.data(), points_.size(), max_velocity);
+}
+}  // namespace autoware::trajectory_optimizer
@@ -0,0 +1,172 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/trajectory_optimizer/candidate_clustering.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace autoware::trajectory_optimizer
+{
+namespace
+{
+struct SegmentProjection
+{
+  size_t segment{0};
+  // position of the projection along the segment, below 0 or above 1 outside of it
+  double ratio{0.0};
+  double distance_m{std::numeric_limits<double>::infinity()};
+};
+
+// distance of a point to the segment from path[i] to path[i + 1]
+SegmentProjection project_on_segment(
+  const TrajectoryPoint * path, const size_t i, const TrajectoryPoint & point)
+{
+  const auto & p = point.pose.position;
+  const auto & a = path[i].pose.position;
+  const auto & b = path[i + 1].pose.position;
+  const double dx = b.x - a.x;
+  const double dy = b.y - a.y;
+  const double squared_length = dx * dx + dy * dy;
+  SegmentProjection projection;
+  projection.segment = i;
+  projection.ratio =
+    squared_length > 0.0 ? ((p.x - a.x) * dx + (p.y - a.y) * dy) / squared_length : 0.0;
+  const double ratio = std::clamp(projection.ratio, 0.0, 1.0);
+  projection.distance_m = std::hypot(p.x - (a.x + ratio * dx), p.y - (a.y + ratio * dy));
+  return projection;
+}
+
+// nearest segment of a path of at least two points, walking forward from start_segment while the
+// next segment is not farther
+SegmentProjection find_nearest_segment(
+  const TrajectoryPoint * path, const size_t size, const TrajectoryPoint & point,
+  const size_t start_segment)
+{
+  auto nearest = project_on_segment(path, start_segment, point);
+  for (size_t i = start_segment + 1; i + 1 < size; ++i) {
+    const auto projection = project_on_segment(path, i, point);
+    if (projection.distance_m > nearest.distance_m) {
+      break;
+    }
+    nearest = projection;
+  }
+  return nearest;
+}
+
+// largest distance of the points of from to the path to, stopping once it exceeds bound
+double compute_one_way_deviation(
+  const std::vector<TrajectoryPoint> & from, const std::vector<TrajectoryPoint> & to,
+  const double bound)
+{
+  double max_deviation = 0.0;
+  size_t segment = 0;
+  for (const auto & point : from) {
+    double distance_m = 0.0;
+    if (to.size() == 1) {
+      distance_m = std::hypot(
+        point.pose.position.x - to.front().pose.position.x,
+        point.pose.position.y - to.front().pose.position.y);
+    } else {
+      const auto nearest = find_nearest_segment(to.data(), to.size(), point, segment);
+      segment = nearest.segment;
+      distance_m = nearest.distance_m;
+    }
+    if (!(distance_m <= bound)) {
+      // invalid points never match
+      return std::isnan(distance_m) ? std::numeric_limits<double>::infinity() : distance_m;
+    }
+    max_deviation = std::max(max_deviation, distance_m);
+  }
+  return max_deviation;
+}
+}  // namespace
+
+double compute_max_deviation(
+  const std::vector<TrajectoryPoint> & a, const std::vector<TrajectoryPoint> & b,
+  const double bound)
+{
+  if (a.empty() || b.empty()) {
+    return std::numeric_limits<double>::infinity();
+  }
+  const double a_to_b = compute_one_way_deviation(a, b, bound);
+  if (a_to_b > bound) {
+    return a_to_b;
+  }
+  return std::max(a_to_b, compute_one_way_deviation(b, a, bound));
+}
+
+void cluster_candidates(
+  const std::vector<NewTrajectory> & candidates, const double tolerance_m,
+  CandidateClusters & clusters)
+{
+  clusters.representative_of.resize(candidates.size());
+  clusters.num_clusters = 0;
+  for (size_t i = 0; i < candidates.size(); ++i) {
+    clusters.representative_of[i] = i;
+    const auto & points = candidates[i].points;
+    for (size_t j = 0; j < i && points.size() >= 2; ++j) {
+      if (!clusters.is_representative(j) || candidates[j].points.size() < 2) {
+        continue;
+      }
+      if (compute_max_deviation(candidates[j].points, points, tolerance_m) <= tolerance_m) {
+        clusters.representative_of[i] = j;
+        break;
+      }
+    }
+    if (clusters.is_representative(i)) {
+      ++clusters.num_clusters;
+    }
+  }
+}
+
+void project_onto_representative(
+  const std::vector<TrajectoryPoint> & representative, std::vector<TrajectoryPoint> & member)
+{
+  const size_t num_member_points = member.size();
+  if (num_member_points == 0) {
+    member = representative;
+    return;
+  }
+  // the output is appended after the member's points, which are read until the end and then erased
+  member.insert(member.end(), representative.begin(), representative.end());
+  const TrajectoryPoint * path = member.data();
+  size_t segment = 0;
+  for (size_t i = num_member_points; i < member.size(); ++i) {
+    auto & point = member[i];
+    if (num_member_points == 1) {
+      point.longitudinal_velocity_mps = path[0].longitudinal_velocity_mps;
+      point.lateral_velocity_mps = path[0].lateral_velocity_mps;
+      point.acceleration_mps2 = path[0].acceleration_mps2;
+      continue;
+    }
+    const auto nearest = find_nearest_segment(path, num_member_points, point, segment);
+    segment = nearest.segment;
+    if (nearest.segment == 0 && nearest.ratio < 0.0) {
+      continue;
+    }
+    const auto & a = path[nearest.segment];
+    const auto & b = path[nearest.segment + 1];
+    const auto ratio = static_cast<float>(std::clamp(nearest.ratio, 0.0, 1.0));
+    point.longitudinal_velocity_mps =
+      a.longitudinal_velocity_mps +
+      ratio * (b.longitudinal_velocity_mps - a.longitudinal_velocity_mps);
+    point.lateral_velocity_mps =
+      a.lateral_velocity_mps + ratio * (b.lateral_velocity_mps - a.lateral_velocity_mps);
+    point.acceleration_mps2 =
+      a.acceleration_mps2 + ratio * (b.acceleration_mps2 - a.acceleration_mps2);
+  }
+  member.erase(member.begin(), member.begin() + static_cast<std::ptrdiff_t>(num_member_points));
+}
+}  // namespace autoware::trajectory_optimizer
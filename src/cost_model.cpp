@@ -0,0 +1,206 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/trajectory_optimizer/cost_model.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <queue>
+
+namespace autoware::trajectory_optimizer
+{
+namespace
+{
+constexpr double min_segment_length_m = 1e-3;
+// keeps the normal equations positive definite, far below the weight of a single sample
+constexpr double ridge = 1e-6;
+}  // namespace
+
+CandidateFeatures compute_candidate_features(const std::vector<TrajectoryPoint> & points)
+{
+  CandidateFeatures features;
+  features.num_points = points.size();
+  bool has_heading = false;
+  double previous_heading = 0.0;
+  double previous_length = 0.0;
+  for (size_t i = 1; i < points.size(); ++i) {
+    const double dx = points[i].pose.position.x - points[i - 1].pose.position.x;
+    const double dy = points[i].pose.position.y - points[i - 1].pose.position.y;
+    const double length = std::hypot(dx, dy);
+    if (!std::isfinite(length)) {
+      continue;
+    }
+    features.arc_length_m += length;
+    if (length < min_segment_length_m) {
+      continue;
+    }
+    const double heading = std::atan2(dy, dx);
+    if (has_heading) {
+      const double turning = std::abs(std::remainder(heading - previous_heading, 2.0 * M_PI));
+      features.total_turning_rad += turning;
+      features.max_curvature = std::max(
+        features.max_curvature,
+        std::min(
+          2.0 * turning / (length + previous_length), CandidateFeatures::max_curvature_cap));
+    }
+    has_heading = true;
+    previous_heading = heading;
+    previous_length = length;
+  }
+  return features;
+}
+
+OnlineCostRegression::OnlineCostRegression(const double forgetting_factor)
+: forgetting_factor_(std::clamp(forgetting_factor, std::numeric_limits<double>::min(), 1.0))
+{
+}
+
+OnlineCostRegression::Terms OnlineCostRegression::to_terms(const CandidateFeatures & features)
+{
+  // scaled so every term is of order 1 for a typical candidate
+  return {
+    1.0, static_cast<double>(features.num_points) * 1e-2, features.arc_length_m * 1e-2,
+    features.total_turning_rad, features.max_curvature};
+}
+
+double OnlineCostRegression::predict(const CandidateFeatures & features) const
+{
+  const auto terms = to_terms(features);
+  const double cost = std::inner_product(terms.begin(), terms.end(), weights_.begin(), 0.0);
+  return std::max(cost, 0.0);
+}
+
+void OnlineCostRegression::update(const CandidateFeatures & features, const double cost)
+{
+  if (!std::isfinite(cost)) {
+    return;
+  }
+  const auto terms = to_terms(features);
+  for (size_t i = 0; i < num_terms; ++i) {
+    for (size_t j = 0; j < num_terms; ++j) {
+      information_[i][j] = forgetting_factor_ * information_[i][j] + terms[i] * terms[j];
+    }
+    moments_[i] = forgetting_factor_ * moments_[i] + terms[i] * cost;
+  }
+  ++num_samples_;
+
+  // solve (A + ridge I) w = b by Cholesky decomposition, A + ridge I = L L^T
+  std::array<Terms, num_terms> lower{};
+  for (size_t j = 0; j < num_terms; ++j) {
+    double diagonal = information_[j][j] + ridge;
+    for (size_t k = 0; k < j; ++k) {
+      diagonal -= lower[j][k] * lower[j][k];
+    }
+    lower[j][j] = std::sqrt(std::max(diagonal, ridge));
+    for (size_t i = j + 1; i < num_terms; ++i) {
+      double value = information_[i][j];
+      for (size_t k = 0; k < j; ++k) {
+        value -= lower[i][k] * lower[j][k];
+      }
+      lower[i][j] = value / lower[j][j];
+    }
+  }
+  Terms forward{};
+  for (size_t i = 0; i < num_terms; ++i) {
+    double value = moments_[i];
+    for (size_t k = 0; k < i; ++k) {
+      value -= lower[i][k] * forward[k];
+    }
+    forward[i] = value / lower[i][i];
+  }
+  for (size_t i = num_terms; i-- > 0;) {
+    double value = forward[i];
+    for (size_t k = i + 1; k < num_terms; ++k) {
+      value -= lower[k][i] * weights_[k];
+    }
+    weights_[i] = value / lower[i][i];
+  }
+}
+
+CandidateCostModel::CandidateCostModel(const double forgetting_factor)
+: forgetting_factor_(forgetting_factor)
+{
+}
+
+double CandidateCostModel::predict_ms(const CandidateFeatures & features) const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  double predicted_ms = 0.0;
+  for (const auto & [stage, regression] : stages_) {
+    predicted_ms += regression.predict(features);
+  }
+  return predicted_ms;
+}
+
+void CandidateCostModel::update(
+  const std::string_view stage, const CandidateFeatures & features, const double elapsed_ms)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = stages_.find(stage);
+  if (it == stages_.end()) {
+    it = stages_.emplace(std::string(stage), OnlineCostRegression(forgetting_factor_)).first;
+  }
+  it->second.update(features, elapsed_ms);
+}
+
+void CandidateCostModel::schedule(
+  const std::vector<NewTrajectory> & candidates, CandidateSchedule & schedule) const
+{
+  schedule.features.resize(candidates.size());
+  schedule.predicted_ms.resize(candidates.size());
+  schedule.actual_ms.assign(candidates.size(), std::numeric_limits<double>::quiet_NaN());
+  for (size_t i = 0; i < candidates.size(); ++i) {
+    schedule.features[i] = compute_candidate_features(candidates[i].points);
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (size_t i = 0; i < candidates.size(); ++i) {
+      double predicted_ms = 0.0;
+      for (const auto & [stage, regression] : stages_) {
+        predicted_ms += regression.predict(schedule.features[i]);
+      }
+      schedule.predicted_ms[i] = predicted_ms;
+    }
+  }
+  order_longest_first(schedule.predicted_ms, schedule.order);
+}
+
+void order_longest_first(const std::vector<double> & costs, std::vector<size_t> & order)
+{
+  order.resize(costs.size());
+  std::iota(order.begin(), order.end(), size_t{0});
+  std::stable_sort(order.begin(), order.end(), [&costs](const size_t a, const size_t b) {
+    return costs[a] > costs[b];
+  });
+}
+
+double list_schedule_makespan(
+  const std::vector<double> & costs, const std::vector<size_t> & order, const size_t num_workers)
+{
+  // time at which each worker becomes idle, earliest on top
+  std::priority_queue<double, std::vector<double>, std::greater<>> idle_times(
+    std::greater<>{}, std::vector<double>(std::max<size_t>(num_workers, 1), 0.0));
+  double makespan = 0.0;
+  for (const auto index : order) {
+    const double finish = idle_times.top() + costs[index];
+    idle_times.pop();
+    idle_times.push(finish);
+    makespan = std::max(makespan, finish);
+  }
+  return makespan;
+}
+}  // namespace autoware::trajectory_optimizer
@@ -0,0 +1,337 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/trajectory_optimizer/cycle_capture.hpp"
+
+#include "autoware_trajectory_optimizer/srv/optimize_trajectories.hpp"
+
+#include <rclcpp/logging.hpp>
+#include <rosbag2_cpp/writer.hpp>
+
+#include <algorithm>
+#include <cinttypes>
+#include <cmath>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+namespace autoware::trajectory_optimizer
+{
+namespace
+{
+std::string to_yaml(const std::string & value)
+{
+  std::string quoted = "\"";
+  for (const auto c : value) {
+    if (c == '"' || c == '\\') {
+      quoted += '\\';
+    }
+    quoted += c;
+  }
+  return quoted + "\"";
+}
+
+std::string to_yaml(const double value)
+{
+  if (std::isnan(value)) {
+    return ".nan";
+  }
+  if (std::isinf(value)) {
+    return value > 0.0 ? ".inf" : "-.inf";
+  }
+  std::ostringstream stream;
+  stream << std::setprecision(17) << value;
+  auto text = stream.str();
+  // without a decimal point the value would be read back as an integer parameter
+  if (text.find_first_of(".e") == std::string::npos) {
+    text += ".0";
+  }
+  return text;
+}
+
+std::string to_yaml(const bool value)
+{
+  return value ? "true" : "false";
+}
+
+std::string to_yaml(const int64_t value)
+{
+  return std::to_string(value);
+}
+
+template <typename T>
+std::string to_yaml(const std::vector<T> & values)
+{
+  std::string text = "[";
+  for (size_t i = 0; i < values.size(); ++i) {
+    text += (i > 0 ? ", " : "") + to_yaml(static_cast<T>(values[i]));
+  }
+  return text + "]";
+}
+
+std::string to_yaml(const std::vector<uint8_t> & values)
+{
+  return to_yaml(std::vector<int64_t>(values.begin(), values.end()));
+}
+
+/**
+ * @brief Formats a parameter value as a YAML value of the same parameter type.
+ * @return The value, or nullopt for unset parameters and for empty arrays, whose type YAML cannot
+ * express.
+ */
+std::optional<std::string> to_yaml(const rclcpp::ParameterValue & value)
+{
+  switch (value.get_type()) {
+    case rclcpp::ParameterType::PARAMETER_BOOL:
+      return to_yaml(value.get<bool>());
+    case rclcpp::ParameterType::PARAMETER_INTEGER:
+      return to_yaml(value.get<int64_t>());
+    case rclcpp::ParameterType::PARAMETER_DOUBLE:
+      return to_yaml(value.get<double>());
+    case rclcpp::ParameterType::PARAMETER_STRING:
+      return to_yaml(value.get<std::string>());
+    case rclcpp::ParameterType::PARAMETER_BYTE_ARRAY: {
+      const auto & values = value.get<std::vector<uint8_t>>();
+      return values.empty() ? std::nullopt : std::make_optional(to_yaml(values));
+    }
+    case rclcpp::ParameterType::PARAMETER_BOOL_ARRAY: {
+      const auto & values = value.get<std::vector<bool>>();
+      return values.empty() ? std::nullopt : std::make_optional(to_yaml(values));
+    }
+    case rclcpp::ParameterType::PARAMETER_INTEGER_ARRAY: {
+      const auto & values = value.get<std::vector<int64_t>>();
+      return values.empty() ? std::nullopt : std::make_optional(to_yaml(values));
+    }
+    case rclcpp::ParameterType::PARAMETER_DOUBLE_ARRAY: {
+      const auto & values = value.get<std::vector<double>>();
+      return values.empty() ? std::nullopt : std::make_optional(to_yaml(values));
+    }
+    case rclcpp::ParameterType::PARAMETER_STRING_ARRAY: {
+      const auto & values = value.get<std::vector<std::string>>();
+      return values.empty() ? std::nullopt : std::make_optional(to_yaml(values));
+    }
+    default:
+      return std::nullopt;
+  }
+}
+
+void write_parameters(
+  const std::filesystem::path & path, const std::string & node_name,
+  const std::vector<rclcpp::Parameter> & parameters)
+{
+  std::ofstream file(path);
+  file << node_name << ":\n  ros__parameters:\n";
+  for (const auto & parameter : parameters) {
+    const auto value = to_yaml(parameter.get_parameter_value());
+    if (!value) {
+      file << "    # " << parameter.get_name() << ": not set or empty\n";
+      continue;
+    }
+    file << "    " << parameter.get_name() << ": " << *value << "\n";
+  }
+  if (!file) {
+    throw std::runtime_error("failed to write " + path.string());
+  }
+}
+
+void write_timings(const std::filesystem::path & path, const CycleCapture & capture)
+{
+  std::ofstream file(path);
+  file << "topic_prefix: " << to_yaml(capture.topic_prefix) << "\n";
+  file << "cycle_id: " << capture.cycle_id << "\n";
+  file << "stamp_ns: " << capture.stamp.nanoseconds() << "\n";
+  file << "processing_time_ms: " << to_yaml(capture.processing_time_ms) << "\n";
+  file << "stages:\n";
+  for (const auto & [stage, time] : capture.stage_timings) {
+    file << "  - {stage: " << to_yaml(stage) << ", calls: " << time.calls
+         << ", total_ms: " << to_yaml(time.total_ms) << "}\n";
+  }
+  if (!file) {
+    throw std::runtime_error("failed to write " + path.string());
+  }
+}
+}  // namespace
+
+void StageTimings::add(const std::string_view stage, const double elapsed_ms)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = stages_.find(stage);
+  if (it == stages_.end()) {
+    it = stages_.emplace(std::string(stage), StageTime{}).first;
+  }
+  ++it->second.calls;
+  it->second.total_ms += elapsed_ms;
+}
+
+void StageTimings::add(const std::string_view stage, const StageTime & time)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = stages_.find(stage);
+  if (it == stages_.end()) {
+    it = stages_.emplace(std::string(stage), StageTime{}).first;
+  }
+  it->second.calls += time.calls;
+  it->second.total_ms += time.total_ms;
+}
+
+std::vector<std::pair<std::string, StageTimings::StageTime>> StageTimings::take()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::vector<std::pair<std::string, StageTime>> times;
+  times.reserve(stages_.size());
+  for (auto & [stage, time] : stages_) {
+    times.emplace_back(stage, time);
+    time = StageTime{};
+  }
+  return times;
+}
+
+ScopedStageTimer::ScopedStageTimer(StageTimings * timings, const std::string_view stage)
+: timings_(timings), stage_(stage)
+{
+  if (timings_) {
+    start_ = std::chrono::steady_clock::now();
+  }
+}
+
+ScopedStageTimer::~ScopedStageTimer()
+{
+  if (timings_) {
+    timings_->add(
+      stage_, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_)
+                .count());
+  }
+}
+
+SlowCycleRecorder::SlowCycleRecorder(
+  const CycleCaptureParams & params, const std::string & node_name, const rclcpp::Logger & logger)
+: params_(params), node_name_(node_name), logger_(logger)
+{
+  thread_ = std::thread([this]() { run(); });
+}
+
+SlowCycleRecorder::~SlowCycleRecorder()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  condition_.notify_all();
+  thread_.join();
+}
+
+bool SlowCycleRecorder::should_capture(
+  const double processing_time_ms, const std::chrono::steady_clock::time_point now)
+{
+  if (processing_time_ms < params_.threshold_ms) {
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (params_.max_captures > 0 && num_captures_ >= params_.max_captures) {
+    return false;
+  }
+  if (
+    last_capture_time_ &&
+    std::chrono::duration<double>(now - *last_capture_time_).count() < params_.min_interval_s) {
+    return false;
+  }
+  last_capture_time_ = now;
+  ++num_captures_;
+  return true;
+}
+
+void SlowCycleRecorder::record(CycleCapture capture)
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    queue_.push_back(std::move(capture));
+  }
+  condition_.notify_one();
+}
+
+void SlowCycleRecorder::run()
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    condition_.wait(lock, [this]() { return stop_ || !queue_.empty(); });
+    // pending captures are still written on shutdown, they are what the user is waiting for
+    if (queue_.empty()) {
+      return;
+    }
+    auto capture = std::move(queue_.front());
+    queue_.pop_front();
+    lock.unlock();
+    try {
+      const auto path = write_capture(capture, params_.directory, node_name_);
+      RCLCPP_WARN(
+        logger_, "Cycle %" PRIu64 " of %s took %.1f ms, inputs captured to %s", capture.cycle_id,
+        capture.topic_prefix.c_str(), capture.processing_time_ms, path.c_str());
+    } catch (const std::exception & e) {
+      RCLCPP_ERROR(logger_, "Failed to capture slow cycle: %s", e.what());
+    }
+    lock.lock();
+  }
+}
+
+std::string SlowCycleRecorder::write_capture(
+  const CycleCapture & capture, const std::string & directory, const std::string & node_name)
+{
+  std::string stream_name = capture.topic_prefix;
+  std::replace(stream_name.begin(), stream_name.end(), '/', '_');
+  std::ostringstream name;
+  name << "cycle_" << capture.stamp.nanoseconds() << stream_name << capture.cycle_id;
+  const auto path = std::filesystem::path(directory) / name.str();
+  std::filesystem::create_directories(path);
+
+  {
+    // the bag is closed when the writer goes out of scope
+    rosbag2_cpp::Writer writer;
+    writer.open((path / "inputs").string());
+    const auto & prefix = capture.topic_prefix;
+    writer.write(capture.odometry, prefix + "input/odometry", capture.stamp);
+    writer.write(capture.acceleration, prefix + "input/acceleration", capture.stamp);
+    if (capture.previous_trajectory) {
+      writer.write(
+        *capture.previous_trajectory, prefix + "input/previous_trajectory", capture.stamp);
+    }
+    // played last so that the polling subscribers already hold the other inputs
+    const auto trajectories_time = capture.stamp + rclcpp::Duration::from_seconds(0.01);
+    if (capture.serialized_trajectories) {
+      writer.write(
+        *capture.serialized_trajectories, prefix + "input/trajectories",
+        "autoware_new_planning_msgs/msg/Trajectories", trajectories_time);
+    } else {
+      writer.write(capture.trajectories, prefix + "input/trajectories", trajectories_time);
+    }
+
+    // the backward extension depends on the ego history, which only a request can carry
+    autoware_trajectory_optimizer::srv::OptimizeTrajectories::Request request;
+    request.trajectories = capture.trajectories;
+    request.odometry = capture.odometry;
+    request.acceleration = capture.acceleration;
+    if (capture.previous_trajectory) {
+      request.previous_trajectory = *capture.previous_trajectory;
+    }
+    request.ego_history_points = capture.ego_history_points;
+    writer.write(request, prefix + "debug/cycle_request", capture.stamp);
+  }
+  write_parameters(path / "parameters.yaml", node_name, capture.parameters);
+  write_timings(path / "timings.yaml", capture);
+  return path.string();
+}
+
+}  // namespace autoware::trajectory_optimizer
@@ -0,0 +1,70 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/trajectory_optimizer/cycle_metrics.hpp"
+
+#include <cstdio>
+
+namespace autoware::trajectory_optimizer
+{
+
+void ThroughputMeter::add(
+  const std::chrono::steady_clock::time_point now, const size_t num_candidates)
+{
+  cycles_.emplace_back(now, num_candidates);
+  num_candidates_ += num_candidates;
+  const auto window_start = now - std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                    std::chrono::duration<double>(window_s_));
+  while (!cycles_.empty() && cycles_.front().first <= window_start) {
+    num_candidates_ -= cycles_.front().second;
+    cycles_.pop_front();
+  }
+}
+
+double ThroughputMeter::cycles_per_second() const
+{
+  return window_s_ > 0.0 ? static_cast<double>(cycles_.size()) / window_s_ : 0.0;
+}
+
+double ThroughputMeter::candidates_per_second() const
+{
+  return window_s_ > 0.0 ? static_cast<double>(num_candidates_) / window_s_ : 0.0;
+}
+
+bool apply_thresholds(const CycleMetricsThresholds & thresholds, CycleMetrics & metrics)
+{
+  metrics.level = CycleMetrics::OK;
+  metrics.message.clear();
+  const auto check = [&metrics](const char * name, const double value, const double threshold) {
+    // NaN, i.e. unknown, values never exceed a threshold
+    if (threshold <= 0.0 || !(value > threshold)) {
+      return;
+    }
+    char buffer[96];
+    std::snprintf(
+      buffer, sizeof(buffer), "%s%s %.1f ms > %.1f ms", metrics.message.empty() ? "" : ", ", name,
+      value, threshold);
+    metrics.message += buffer;
+    metrics.level = CycleMetrics::WARN;
+  };
+  check("input age", metrics.input_age_ms, thresholds.max_input_age_ms);
+  check("odometry age", metrics.odometry_age_ms, thresholds.max_ego_state_age_ms);
+  check("acceleration age", metrics.acceleration_age_ms, thresholds.max_ego_state_age_ms);
+  check("queueing delay", metrics.queueing_delay_ms, thresholds.max_queueing_delay_ms);
+  check("processing time", metrics.processing_time_ms, thresholds.max_processing_time_ms);
+  check("output age", metrics.output_age_ms, thresholds.max_output_age_ms);
+  return metrics.level == CycleMetrics::WARN;
+}
+
+}  // namespace autoware::trajectory_optimizer
@@ -0,0 +1,88 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/trajectory_optimizer/fixed_size_utils.hpp"
+
+#include "autoware/trajectory_optimizer/simd_kernels.hpp"
+
+#include <limits>
+
+namespace autoware::trajectory_optimizer::utils::fixed_size
+{
+namespace
+{
+// the first num_points points, checked as the fixed-size version
+bool are_valid_and_apart(
+  const TrajectoryPoint * points, const size_t num_points, const double min_dist)
+{
+  const double min_dist2 = min_dist * min_dist * (1.0 + 1e-9);
+  for (size_t i = 0; i < num_points; ++i) {
+    if (!is_finite(points[i])) {
+      return false;
+    }
+    if (i == 0) {
+      continue;
+    }
+    const double dx = points[i].pose.position.x - points[i - 1].pose.position.x;
+    const double dy = points[i].pose.position.y - points[i - 1].pose.position.y;
+    if (!(dx * dx + dy * dy >= min_dist2)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void clamp_velocities(
+  TrajectoryPoint * points, const size_t num_points, const float min_velocity,
+  const float min_acceleration, const float max_velocity)
+{
+  constexpr auto infinity = std::numeric_limits<float>::infinity();
+  if (min_velocity > -infinity || min_acceleration > -infinity) {
+    simd::clamp_min_velocity_and_acceleration(points, num_points, min_velocity, min_acceleration);
+  }
+  if (max_velocity < infinity) {
+    simd::clamp_max_velocity(points, num_points, max_velocity);
+  }
+}
+}  // namespace
+
+bool are_valid_and_apart(const TrajectoryPoints & points, const double min_dist)
+{
+  bool valid_and_apart = false;
+  visit_tail(
+    points.data(), points.size(), Sizes{},
+    [&](const size_t head_size, const auto tail) {
+      // the head and the pair joining it to the tail
+      valid_and_apart = are_valid_and_apart(points.data(), head_size + 1, min_dist) &&
+                        fixed_size::are_valid_and_apart(tail, min_dist);
+    },
+    [] {});
+  return valid_and_apart;
+}
+
+void clamp_velocities(
+  TrajectoryPoints & points, const float min_velocity, const float min_acceleration,
+  const float max_velocity)
+{
+  visit_tail(
+    points.data(), points.size(), Sizes{},
+    [&](const size_t head_size, const auto tail) {
+      clamp_velocities(points.data(), head_size, min_velocity, min_acceleration, max_velocity);
+      fixed_size::clamp_velocities(tail, min_velocity, min_acceleration, max_velocity);
+    },
+    [&] {
+      clamp_velocities(points.data(), points.size(), min_velocity, min_acceleration, max_velocity);
+    });
+}
+}  // namespace autoware::trajectory_optimizer::utils::fixed_size
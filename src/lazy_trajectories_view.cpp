@@ -0,0 +1,325 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/trajectory_optimizer/lazy_trajectories_view.hpp"
+
+#include <rclcpp/serialization.hpp>
+
+#include <std_msgs/msg/string.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <string>
+#include <type_traits>
+#include <unordered_set>
+
+namespace autoware::trajectory_optimizer
+{
+namespace
+{
+constexpr size_t kEncapsulationSize = 4;
+// serialized size of a TrajectoryPoint without padding: time_from_start, pose and six float32
+constexpr size_t kPointSize = 2 * sizeof(int32_t) + 7 * sizeof(double) + 6 * sizeof(float);
+constexpr uint64_t kFnvOffsetBasis = 14695981039346656037ULL;
+constexpr uint64_t kFnvPrime = 1099511628211ULL;
+
+// decode_generator_info() moves the serialized generator info to offset 4, which keeps it aligned
+// only as long as it has no 8-byte fields: a message change must be checked against that
+using GeneratorInfo = decltype(Trajectories::generator_info)::value_type;
+static_assert(
+  std::is_same_v<decltype(GeneratorInfo::generator_id), unique_identifier_msgs::msg::UUID> &&
+    std::is_same_v<decltype(GeneratorInfo::generator_name), std_msgs::msg::String>,
+  "the generator info fields changed, check their alignment in decode_generator_info()");
+static_assert(
+  sizeof(GeneratorInfo) ==
+    sizeof(unique_identifier_msgs::msg::UUID) + sizeof(std_msgs::msg::String),
+  "the generator info has new fields, check their alignment in decode_generator_info()");
+
+void hash_bytes(const void * data, const size_t size, uint64_t & hash)
+{
+  const auto * bytes = static_cast<const uint8_t *>(data);
+  for (size_t i = 0; i < size; ++i) {
+    hash ^= bytes[i];
+    hash *= kFnvPrime;
+  }
+}
+
+/**
+ * @brief Minimal little-endian CDR reader; alignment is relative to the end of the encapsulation.
+ */
+class CdrReader
+{
+public:
+  CdrReader(const uint8_t * data, const size_t size, const size_t max_alignment, size_t position)
+  : data_(data), size_(size), max_alignment_(max_alignment), position_(position)
+  {
+  }
+
+  bool align(const size_t alignment)
+  {
+    const auto step = std::min(alignment, max_alignment_);
+    const auto offset = position_ - kEncapsulationSize;
+    position_ = kEncapsulationSize + (offset + step - 1) / step * step;
+    return position_ <= size_;
+  }
+
+  template <typename T>
+  bool read(T & value)
+  {
+    if (!align(sizeof(T)) || position_ + sizeof(T) > size_) {
+      return false;
+    }
+    std::memcpy(&value, data_ + position_, sizeof(T));
+    position_ += sizeof(T);
+    return true;
+  }
+
+  bool read_string(std::string & value)
+  {
+    uint32_t length = 0;
+    if (!read(length) || position_ + length > size_) {
+      return false;
+    }
+    // the length includes the null terminator
+    value.assign(
+      reinterpret_cast<const char *>(data_ + position_), length > 0 ? length - 1 : 0);
+    position_ += length;
+    return true;
+  }
+
+  bool read_bytes(uint8_t * value, const size_t size)
+  {
+    if (position_ + size > size_) {
+      return false;
+    }
+    std::memcpy(value, data_ + position_, size);
+    position_ += size;
+    return true;
+  }
+
+  bool skip(const size_t size)
+  {
+    position_ += size;
+    return position_ <= size_;
+  }
+
+  bool read_point(TrajectoryPoint & point)
+  {
+    return read(point.time_from_start.sec) && read(point.time_from_start.nanosec) &&
+           read(point.pose.position.x) && read(point.pose.position.y) &&
+           read(point.pose.position.z) && read(point.pose.orientation.x) &&
+           read(point.pose.orientation.y) && read(point.pose.orientation.z) &&
+           read(point.pose.orientation.w) && read(point.longitudinal_velocity_mps) &&
+           read(point.lateral_velocity_mps) && read(point.acceleration_mps2) &&
+           read(point.heading_rate_rps) && read(point.front_wheel_angle_rad) &&
+           read(point.rear_wheel_angle_rad);
+  }
+
+  // after one point the stream is aligned for the largest field, so the rest are packed
+  bool is_packed() const { return (position_ - kEncapsulationSize) % max_alignment_ == 0; }
+
+  const uint8_t * current() const { return data_ + position_; }
+  size_t position() const { return position_; }
+
+private:
+  const uint8_t * data_;
+  size_t size_;
+  size_t max_alignment_;
+  size_t position_;
+};
+
+void hash_point(const TrajectoryPoint & point, uint64_t & hash)
+{
+  // fields in serialization order, so that packed raw bytes hash to the same value
+  hash_bytes(&point.time_from_start.sec, sizeof(point.time_from_start.sec), hash);
+  hash_bytes(&point.time_from_start.nanosec, sizeof(point.time_from_start.nanosec), hash);
+  hash_bytes(&point.pose.position.x, sizeof(double), hash);
+  hash_bytes(&point.pose.position.y, sizeof(double), hash);
+  hash_bytes(&point.pose.position.z, sizeof(double), hash);
+  hash_bytes(&point.pose.orientation.x, sizeof(double), hash);
+  hash_bytes(&point.pose.orientation.y, sizeof(double), hash);
+  hash_bytes(&point.pose.orientation.z, sizeof(double), hash);
+  hash_bytes(&point.pose.orientation.w, sizeof(double), hash);
+  hash_bytes(&point.longitudinal_velocity_mps, sizeof(float), hash);
+  hash_bytes(&point.lateral_velocity_mps, sizeof(float), hash);
+  hash_bytes(&point.acceleration_mps2, sizeof(float), hash);
+  hash_bytes(&point.heading_rate_rps, sizeof(float), hash);
+  hash_bytes(&point.front_wheel_angle_rad, sizeof(float), hash);
+  hash_bytes(&point.rear_wheel_angle_rad, sizeof(float), hash);
+}
+}  // namespace
+
+bool LazyTrajectoriesView::parse(const rclcpp::SerializedMessage & serialized_msg)
+{
+  candidates_.clear();
+  const auto & rcl_msg = serialized_msg.get_rcl_serialized_message();
+  data_ = rcl_msg.buffer;
+  size_ = rcl_msg.buffer_length;
+
+#if !defined(__BYTE_ORDER__) || __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+  return false;
+#endif
+  if (size_ < kEncapsulationSize || data_[0] != 0x00) {
+    return false;
+  }
+  // plain little-endian CDR aligns 8-byte fields to 8, XCDR2 to 4
+  if (data_[1] == 0x01) {
+    max_alignment_ = 8;
+  } else if (data_[1] == 0x07) {
+    max_alignment_ = 4;
+  } else {
+    return false;
+  }
+
+  CdrReader reader(data_, size_, max_alignment_, kEncapsulationSize);
+  uint32_t num_candidates = 0;
+  if (!reader.read(num_candidates)) {
+    return false;
+  }
+  candidates_.reserve(std::min<size_t>(num_candidates, size_));
+  for (uint32_t i = 0; i < num_candidates; ++i) {
+    Candidate candidate;
+    uint32_t num_points = 0;
+    if (
+      !reader.read(candidate.header.stamp.sec) || !reader.read(candidate.header.stamp.nanosec) ||
+      !reader.read_string(candidate.header.frame_id) ||
+      !reader.read_bytes(candidate.generator_id.uuid.data(), candidate.generator_id.uuid.size()) ||
+      !reader.read(num_points)) {
+      return false;
+    }
+    candidate.num_points = num_points;
+    candidate.points_offset = reader.position();
+    if (num_points > 0) {
+      TrajectoryPoint first_point;
+      if (!reader.read_point(first_point)) {
+        return false;
+      }
+      const auto remaining = static_cast<size_t>(num_points) - 1;
+      if (reader.is_packed()) {
+        if (!reader.skip(remaining * kPointSize)) {
+          return false;
+        }
+      } else {
+        for (size_t j = 0; j < remaining; ++j) {
+          if (!reader.read_point(first_point)) {
+            return false;
+          }
+        }
+      }
+    }
+    if (!reader.read(candidate.score)) {
+      return false;
+    }
+    candidates_.push_back(std::move(candidate));
+  }
+  generator_info_offset_ = reader.position();
+  return true;
+}
+
+void LazyTrajectoriesView::decode_points(const size_t index, TrajectoryPoints & points) const
+{
+  const auto & candidate = candidates_.at(index);
+  points.resize(candidate.num_points);
+  // parse() has already checked that the points are within the buffer
+  CdrReader reader(data_, size_, max_alignment_, candidate.points_offset);
+  for (auto & point : points) {
+    reader.read_point(point);
+  }
+}
+
+uint64_t LazyTrajectoriesView::hash_points(const size_t index) const
+{
+  const auto & candidate = candidates_.at(index);
+  uint64_t hash = kFnvOffsetBasis;
+  if (candidate.num_points == 0) {
+    return hash;
+  }
+  CdrReader reader(data_, size_, max_alignment_, candidate.points_offset);
+  TrajectoryPoint point;
+  reader.read_point(point);
+  hash_point(point, hash);
+  const auto remaining = candidate.num_points - 1;
+  if (reader.is_packed()) {
+    hash_bytes(reader.current(), remaining * kPointSize, hash);
+    return hash;
+  }
+  for (size_t i = 0; i < remaining; ++i) {
+    reader.read_point(point);
+    hash_point(point, hash);
+  }
+  return hash;
+}
+
+bool LazyTrajectoriesView::decode_generator_info(
+  decltype(Trajectories::generator_info) & generator_info) const
+{
+  // re-encode the tail as a message without candidates and let the type support decode it; the
+  // tail keeps its alignment as long as the generator info has no 8-byte fields, see GeneratorInfo
+  const auto tail_size = size_ - generator_info_offset_;
+  rclcpp::SerializedMessage tail_msg(kEncapsulationSize + sizeof(uint32_t) + tail_size);
+  auto & rcl_tail = tail_msg.get_rcl_serialized_message();
+  const uint32_t no_candidates = 0;
+  std::memcpy(rcl_tail.buffer, data_, kEncapsulationSize);
+  std::memcpy(rcl_tail.buffer + kEncapsulationSize, &no_candidates, sizeof(no_candidates));
+  std::memcpy(
+    rcl_tail.buffer + kEncapsulationSize + sizeof(no_candidates), data_ + generator_info_offset_,
+    tail_size);
+  rcl_tail.buffer_length = kEncapsulationSize + sizeof(no_candidates) + tail_size;
+
+  Trajectories tail;
+  try {
+    rclcpp::Serialization<Trajectories>().deserialize_message(&tail_msg, &tail);
+  } catch (const std::exception &) {
+    return false;
+  }
+  generator_info = std::move(tail.generator_info);
+  return true;
+}
+
+uint64_t hash_points(const TrajectoryPoints & points)
+{
+  uint64_t hash = kFnvOffsetBasis;
+  for (const auto & point : points) {
+    hash_point(point, hash);
+  }
+  return hash;
+}
+
+std::vector<size_t> select_candidates(
+  const std::vector<double> & scores, const std::vector<uint64_t> & hashes,
+  const size_t max_candidates)
+{
+  std::vector<size_t> indices;
+  indices.reserve(scores.size());
+  std::unordered_set<uint64_t> seen_hashes;
+  for (size_t i = 0; i < scores.size(); ++i) {
+    // the first of several identical candidates is kept
+    if (!hashes.empty() && !seen_hashes.insert(hashes[i]).second) {
+      continue;
+    }
+    indices.push_back(i);
+  }
+
+  if (max_candidates > 0 && indices.size() > max_candidates) {
+    std::stable_sort(indices.begin(), indices.end(), [&scores](const size_t a, const size_t b) {
+      return scores[a] > scores[b];
+    });
+    indices.resize(max_candidates);
+    std::sort(indices.begin(), indices.end());
+  }
+  return indices;
+}
+
+}  // namespace autoware::trajectory_optimizer
@@ -0,0 +1,105 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/trajectory_optimizer/optimizer_chain.hpp"
+
+#include "autoware/trajectory_optimizer/cycle_capture.hpp"
+#include "autoware/trajectory_optimizer/perf_counters.hpp"
+
+#include <optional>
+
+namespace autoware::trajectory_optimizer
+{
+
+OptimizerChain::OptimizerChain(
+  rclcpp::Node * node_ptr, const std::shared_ptr<autoware_utils_debug::TimeKeeper> time_keeper,
+  const TrajectoryOptimizerParams & params)
+{
+  eb_smoother_optimizer_ptr_ = std::make_shared<plugin::TrajectoryEBSmootherOptimizer>(
+    "eb_smoother_optimizer", node_ptr, time_keeper, params);
+  trajectory_extender_ptr_ = std::make_shared<plugin::TrajectoryExtender>(
+    "trajectory_extender", node_ptr, time_keeper, params);
+  trajectory_point_fixer_ptr_ = std::make_shared<plugin::TrajectoryPointFixer>(
+    "trajectory_point_fixer", node_ptr, time_keeper, params);
+  trajectory_spline_smoother_ptr_ = std::make_shared<plugin::TrajectorySplineSmoother>(
+    "trajectory_spline_smoother", node_ptr, time_keeper, params);
+  trajectory_velocity_optimizer_ptr_ = std::make_shared<plugin::TrajectoryVelocityOptimizer>(
+    "trajectory_velocity_optimizer", node_ptr, time_keeper, params);
+}
+
+namespace
+{
+// runs work of a plugin, timed as its stage
+template <typename Run>
+void run_timed(
+  const plugin::TrajectoryOptimizerPluginBase & plugin, const TrajectoryOptimizerParams & params,
+  Run && run)
+{
+  if (!params.detailed_timing && !params.perf_counter_aggregator && !params.stage_timings) {
+    run();
+    return;
+  }
+  const auto stage = plugin.get_name();
+  std::optional<autoware_utils::ScopedTimeTrack> time_track;
+  if (params.detailed_timing) {
+    time_track.emplace(stage, *plugin.get_time_keeper());
+  }
+  const ScopedStageTimer timer(params.stage_timings, stage);
+  const ScopedStagePerfCounters counters(params.perf_counter_aggregator, stage);
+  run();
+}
+
+void run_stage(
+  plugin::TrajectoryOptimizerPluginBase & plugin, TrajectoryPoints & traj_points,
+  const TrajectoryOptimizerParams & params)
+{
+  run_timed(plugin, params, [&]() { plugin.optimize_trajectory(traj_points, params); });
+}
+}  // namespace
+
+void OptimizerChain::optimize_trajectory(
+  TrajectoryPoints & traj_points, const TrajectoryOptimizerParams & params)
+{
+  run_stage(*trajectory_extender_ptr_, traj_points, params);
+  run_stage(*trajectory_point_fixer_ptr_, traj_points, params);
+  run_stage(*trajectory_velocity_optimizer_ptr_, traj_points, params);
+  run_stage(*eb_smoother_optimizer_ptr_, traj_points, params);
+  run_stage(*trajectory_spline_smoother_ptr_, traj_points, params);
+  run_stage(*trajectory_point_fixer_ptr_, traj_points, params);
+}
+
+void OptimizerChain::smooth_velocity(
+  TrajectoryPoints & traj_points, const TrajectoryOptimizerParams & params)
+{
+  auto & velocity_optimizer = *trajectory_velocity_optimizer_ptr_;
+  run_timed(
+    velocity_optimizer, params, [&]() { velocity_optimizer.smooth_velocity(traj_points, params); });
+}
+
+rcl_interfaces::msg::SetParametersResult OptimizerChain::on_parameter(
+  const std::vector<rclcpp::Parameter> & parameters)
+{
+  eb_smoother_optimizer_ptr_->on_parameter(parameters);
+  trajectory_extender_ptr_->on_parameter(parameters);
+  trajectory_point_fixer_ptr_->on_parameter(parameters);
+  trajectory_spline_smoother_ptr_->on_parameter(parameters);
+  trajectory_velocity_optimizer_ptr_->on_parameter(parameters);
+
+  rcl_interfaces::msg::SetParametersResult result;
+  result.successful = true;
+  result.reason = "success";
+  return result;
+}
+
+}  // namespace autoware::trajectory_optimizer
@@ -0,0 +1,210 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/trajectory_optimizer/perf_counters.hpp"
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cstring>
+
+namespace autoware::trajectory_optimizer
+{
+namespace
+{
+int open_counter(const uint64_t config, const int group_fd)
+{
+  perf_event_attr attr;
+  std::memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = PERF_TYPE_HARDWARE;
+  attr.config = config;
+  // the group is scheduled as a whole, so its times apply to every counter
+  attr.read_format =
+    PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+  // user space of this thread only, which is also what an unprivileged process may count
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0));
+}
+}  // namespace
+
+PerfCounterValues & PerfCounterValues::operator+=(const PerfCounterValues & other)
+{
+  cycles += other.cycles;
+  instructions += other.instructions;
+  cache_misses += other.cache_misses;
+  branch_misses += other.branch_misses;
+  time_enabled_ns += other.time_enabled_ns;
+  time_running_ns += other.time_running_ns;
+  return *this;
+}
+
+PerfCounterValues PerfCounterValues::operator-(const PerfCounterValues & other) const
+{
+  return PerfCounterValues{
+    cycles - other.cycles,
+    instructions - other.instructions,
+    cache_misses - other.cache_misses,
+    branch_misses - other.branch_misses,
+    time_enabled_ns - other.time_enabled_ns,
+    time_running_ns - other.time_running_ns};
+}
+
+std::optional<PerfCounterValues> scale_to_enabled_time(const PerfCounterValues & values)
+{
+  if (values.time_running_ns == 0) {
+    return std::nullopt;
+  }
+  if (values.time_running_ns >= values.time_enabled_ns) {
+    return values;
+  }
+  const double scale =
+    static_cast<double>(values.time_enabled_ns) / static_cast<double>(values.time_running_ns);
+  auto scaled = values;
+  for (const auto field :
+       {&PerfCounterValues::cycles, &PerfCounterValues::instructions,
+        &PerfCounterValues::cache_misses, &PerfCounterValues::branch_misses}) {
+    scaled.*field = static_cast<uint64_t>(static_cast<double>(values.*field) * scale + 0.5);
+  }
+  return scaled;
+}
+
+PerfCounterGroup::PerfCounterGroup()
+{
+  const std::array<std::pair<uint64_t, uint64_t PerfCounterValues::*>, 4> counters{{
+    {PERF_COUNT_HW_CPU_CYCLES, &PerfCounterValues::cycles},
+    {PERF_COUNT_HW_INSTRUCTIONS, &PerfCounterValues::instructions},
+    {PERF_COUNT_HW_CACHE_MISSES, &PerfCounterValues::cache_misses},
+    {PERF_COUNT_HW_BRANCH_MISSES, &PerfCounterValues::branch_misses},
+  }};
+  for (const auto & [config, field] : counters) {
+    // the first counter that opens leads the group, so that all of them are read at once
+    const int fd = open_counter(config, leader_fd_);
+    if (fd < 0) {
+      continue;
+    }
+    if (leader_fd_ < 0) {
+      leader_fd_ = fd;
+    }
+    fds_.push_back(fd);
+    fields_.push_back(field);
+  }
+}
+
+PerfCounterGroup::~PerfCounterGroup()
+{
+  for (const int fd : fds_) {
+    close(fd);
+  }
+}
+
+std::optional<PerfCounterValues> PerfCounterGroup::read() const
+{
+  if (!is_available()) {
+    return std::nullopt;
+  }
+  // layout of the group read: the number of counters, the enabled and running times, then the
+  // value of each counter
+  constexpr size_t header_size = 3;
+  std::array<uint64_t, header_size + 4> buffer{};
+  const auto expected_size =
+    static_cast<ssize_t>((header_size + fields_.size()) * sizeof(uint64_t));
+  if (::read(leader_fd_, buffer.data(), sizeof(buffer)) < expected_size) {
+    return std::nullopt;
+  }
+  PerfCounterValues values;
+  values.time_enabled_ns = buffer[1];
+  values.time_running_ns = buffer[2];
+  for (size_t i = 0; i < fields_.size() && i < buffer[0]; ++i) {
+    values.*fields_[i] = buffer[header_size + i];
+  }
+  return values;
+}
+
+PerfCounterGroup & PerfCounterGroup::for_current_thread()
+{
+  thread_local PerfCounterGroup group;
+  return group;
+}
+
+PerfCounterAggregator::StageTotals & PerfCounterAggregator::get_stage(
+  const std::string_view stage)
+{
+  auto it = stages_.find(stage);
+  if (it == stages_.end()) {
+    it = stages_.emplace(std::string(stage), StageTotals{}).first;
+  }
+  return it->second;
+}
+
+void PerfCounterAggregator::add(const std::string_view stage, const PerfCounterValues & values)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto & totals = get_stage(stage);
+  ++totals.calls;
+  if (values.time_running_ns < values.time_enabled_ns) {
+    ++totals.scaled_calls;
+  }
+  totals.values += values;
+}
+
+void PerfCounterAggregator::add_unmeasured(const std::string_view stage)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  ++get_stage(stage).unmeasured_calls;
+}
+
+std::vector<std::pair<std::string, PerfCounterAggregator::StageTotals>>
+PerfCounterAggregator::take()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::vector<std::pair<std::string, StageTotals>> totals;
+  totals.reserve(stages_.size());
+  for (auto & [stage, stage_totals] : stages_) {
+    // the entries are kept so that later cycles do not allocate them again
+    totals.emplace_back(stage, stage_totals);
+    stage_totals = StageTotals{};
+  }
+  return totals;
+}
+
+ScopedStagePerfCounters::ScopedStagePerfCounters(
+  PerfCounterAggregator * aggregator, const std::string_view stage)
+: aggregator_(aggregator), stage_(stage)
+{
+  if (aggregator_) {
+    start_ = PerfCounterGroup::for_current_thread().read();
+  }
+}
+
+ScopedStagePerfCounters::~ScopedStagePerfCounters()
+{
+  if (!start_) {
+    return;
+  }
+  const auto end = PerfCounterGroup::for_current_thread().read();
+  if (!end) {
+    return;
+  }
+  if (const auto values = scale_to_enabled_time(*end - *start_)) {
+    aggregator_->add(stage_, *values);
+  } else {
+    aggregator_->add_unmeasured(stage_);
+  }
+}
+
+}  // namespace autoware::trajectory_optimizer
@@ -0,0 +1,140 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/trajectory_optimizer/realtime_profile.hpp"
+
+#include <alloca.h>
+#include <malloc.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+namespace autoware::trajectory_optimizer
+{
+namespace
+{
+std::string describe_error(const std::string & setting, const int error_number)
+{
+  return setting + ": " + std::strerror(error_number);
+}
+
+PageFaults get_thread_page_faults()
+{
+  rusage usage{};
+  if (getrusage(RUSAGE_THREAD, &usage) != 0) {
+    return PageFaults{};
+  }
+  return PageFaults{usage.ru_minflt, usage.ru_majflt};
+}
+
+// touch every page of the requested stack depth so that later calls do not fault on it
+void prefault_stack(const size_t size_bytes)
+{
+  auto * stack = static_cast<volatile unsigned char *>(alloca(size_bytes));
+  const auto page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  for (size_t i = 0; i < size_bytes; i += page_size) {
+    stack[i] = 0;
+  }
+}
+}  // namespace
+
+std::vector<std::string> RealtimeProfile::apply_to_process() const
+{
+  std::vector<std::string> errors;
+  if (!params_.enable || !params_.lock_memory) {
+    return errors;
+  }
+  if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+    errors.push_back(describe_error("mlockall", errno));
+    return errors;
+  }
+  // keep freed memory in the process and serve large blocks from the locked heap
+  if (mallopt(M_TRIM_THRESHOLD, -1) == 0) {
+    errors.emplace_back("mallopt(M_TRIM_THRESHOLD): rejected");
+  }
+  if (mallopt(M_MMAP_MAX, 0) == 0) {
+    errors.emplace_back("mallopt(M_MMAP_MAX): rejected");
+  }
+  return errors;
+}
+
+std::vector<std::string> RealtimeProfile::apply_to_current_thread() const
+{
+  std::vector<std::string> errors;
+  if (!params_.enable) {
+    return errors;
+  }
+
+  if (params_.cpu_affinity_mask != 0) {
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    for (int cpu = 0; cpu < 64; ++cpu) {
+      if ((static_cast<uint64_t>(params_.cpu_affinity_mask) >> cpu) & 1U) {
+        CPU_SET(cpu, &cpu_set);
+      }
+    }
+    const int result = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set);
+    if (result != 0) {
+      errors.push_back(describe_error("pthread_setaffinity_np", result));
+    }
+  }
+
+  if (params_.sched_priority != 0) {
+    sched_param param{};
+    param.sched_priority = static_cast<int>(params_.sched_priority);
+    const int result = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+    if (result != 0) {
+      errors.push_back(describe_error("pthread_setschedparam(SCHED_FIFO)", result));
+    }
+  }
+
+  if (params_.prefault_stack_size_kb > 0) {
+    prefault_stack(static_cast<size_t>(params_.prefault_stack_size_kb) * 1024);
+  }
+  return errors;
+}
+
+std::vector<std::string> apply_idle_priority_to_current_thread()
+{
+  std::vector<std::string> errors;
+  sched_param param{};
+  param.sched_priority = 0;
+  const int result = pthread_setschedparam(pthread_self(), SCHED_IDLE, &param);
+  if (result != 0) {
+    errors.push_back(describe_error("pthread_setschedparam(SCHED_IDLE)", result));
+  }
+  return errors;
+}
+
+void PageFaultMonitor::begin_cycle()
+{
+  cycle_start_ = get_thread_page_faults();
+}
+
+std::optional<PageFaults> PageFaultMonitor::end_cycle()
+{
+  const auto cycle_end = get_thread_page_faults();
+  if (cycle_count_ < warmup_cycles_) {
+    ++cycle_count_;
+    return std::nullopt;
+  }
+  return PageFaults{cycle_end.minor - cycle_start_.minor, cycle_end.major - cycle_start_.major};
+}
+
+}  // namespace autoware::trajectory_optimizer
@@ -0,0 +1,337 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/trajectory_optimizer/scenario_generator.hpp"
+
+#include <rclcpp/duration.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace autoware::trajectory_optimizer::scenarios
+{
+
+namespace
+{
+void set_yaw(geometry_msgs::msg::Quaternion & orientation, const double yaw)
+{
+  orientation.x = 0.0;
+  orientation.y = 0.0;
+  orientation.z = std::sin(yaw / 2.0);
+  orientation.w = std::cos(yaw / 2.0);
+}
+
+double get_yaw(const geometry_msgs::msg::Quaternion & orientation)
+{
+  return 2.0 * std::atan2(orientation.z, orientation.w);
+}
+
+// curvature of a lateral shift of offset over length, starting at s = 0: one period of a sine,
+// whose small-angle lateral displacement is offset
+double get_shift_curvature(const double s, const double offset, const double length)
+{
+  if (s < 0.0 || s > length) {
+    return 0.0;
+  }
+  return 2.0 * M_PI * offset / (length * length) * std::sin(2.0 * M_PI * s / length);
+}
+}  // namespace
+
+const std::vector<ScenarioType> & all_scenario_types()
+{
+  static const std::vector<ScenarioType> types{
+    ScenarioType::LANE_FOLLOW, ScenarioType::LANE_CHANGE, ScenarioType::INTERSECTION_TURN,
+    ScenarioType::U_TURN,      ScenarioType::PULL_OVER,   ScenarioType::STOP_AND_GO};
+  return types;
+}
+
+std::string to_string(const ScenarioType type)
+{
+  switch (type) {
+    case ScenarioType::LANE_FOLLOW:
+      return "lane_follow";
+    case ScenarioType::LANE_CHANGE:
+      return "lane_change";
+    case ScenarioType::INTERSECTION_TURN:
+      return "intersection_turn";
+    case ScenarioType::U_TURN:
+      return "u_turn";
+    case ScenarioType::PULL_OVER:
+      return "pull_over";
+    case ScenarioType::STOP_AND_GO:
+      return "stop_and_go";
+  }
+  return "unknown";
+}
+
+double ScenarioGenerator::uniform()
+{
+  return static_cast<double>(engine_() >> 11) * 0x1.0p-53;
+}
+
+double ScenarioGenerator::uniform(const double min, const double max)
+{
+  return min + (max - min) * uniform();
+}
+
+double ScenarioGenerator::normal(const double stddev)
+{
+  // Box-Muller, 1 - uniform() is in (0, 1]
+  const auto u1 = 1.0 - uniform();
+  const auto u2 = uniform();
+  return stddev * std::sqrt(-2.0 * std::log(u1)) * std::cos(2.0 * M_PI * u2);
+}
+
+TrajectoryPoints ScenarioGenerator::generate_path(
+  const ScenarioParams & params, const double curvature_bias, const double speed_factor)
+{
+  const auto ds = params.point_interval_m;
+  const auto length = ds * static_cast<double>(std::max<size_t>(params.num_points, 1) - 1);
+  const auto cruise_speed = params.speed_mps * speed_factor;
+  const auto side = uniform() < 0.5 ? 1.0 : -1.0;
+
+  std::function<double(double)> curvature = [](double) { return 0.0; };
+  std::function<double(double)> speed = [cruise_speed](double) { return cruise_speed; };
+  switch (params.type) {
+    case ScenarioType::LANE_FOLLOW: {
+      // a gently curving road
+      const auto amplitude = uniform(0.0, 0.01);
+      const auto wavelength = uniform(100.0, 300.0);
+      const auto phase = uniform(0.0, 2.0 * M_PI);
+      curvature = [=](const double s) {
+        return amplitude * std::sin(2.0 * M_PI * s / wavelength + phase);
+      };
+      break;
+    }
+    case ScenarioType::LANE_CHANGE: {
+      const auto change_length = std::clamp(3.0 * cruise_speed, 20.0, std::max(length / 2.0, 1.0));
+      const auto start = uniform(0.1, 0.4) * length;
+      const auto offset = side * params.lane_width_m;
+      curvature = [=](const double s) {
+        return get_shift_curvature(s - start, offset, change_length);
+      };
+      break;
+    }
+    case ScenarioType::INTERSECTION_TURN:
+    case ScenarioType::U_TURN: {
+      const auto angle = params.type == ScenarioType::U_TURN ? M_PI : M_PI / 2.0;
+      const auto arc_length = angle * params.turn_radius_m;
+      const auto start = uniform(0.2, 0.5) * std::max(length - arc_length, 0.0);
+      curvature = [=](const double s) {
+        return s >= start && s < start + arc_length ? side / params.turn_radius_m : 0.0;
+      };
+      break;
+    }
+    case ScenarioType::PULL_OVER: {
+      // to the shoulder on the left or right, then to a stop at the end
+      const auto shift_length = std::clamp(2.0 * cruise_speed, 15.0, std::max(length / 2.0, 1.0));
+      const auto start = uniform(0.1, 0.3) * length;
+      const auto offset = side * params.lane_width_m / 2.0;
+      curvature = [=](const double s) {
+        return get_shift_curvature(s - start, offset, shift_length);
+      };
+      const auto stopping_distance = uniform(0.3, 0.5) * length;
+      speed = [=](const double s) {
+        return cruise_speed * std::sqrt(std::clamp((length - s) / stopping_distance, 0.0, 1.0));
+      };
+      break;
+    }
+    case ScenarioType::STOP_AND_GO: {
+      // traffic jam, starting from a stop
+      const auto period = uniform(30.0, 60.0);
+      speed = [=](const double s) {
+        return cruise_speed * 0.5 * (1.0 - std::cos(2.0 * M_PI * s / period));
+      };
+      break;
+    }
+  }
+
+  // speed limited by the lateral acceleration in curves, then by the longitudinal acceleration
+  std::vector<double> curvatures(params.num_points);
+  std::vector<double> speeds(params.num_points);
+  for (size_t i = 0; i < params.num_points; ++i) {
+    const auto s = static_cast<double>(i) * ds;
+    curvatures[i] = curvature(s) + curvature_bias;
+    const auto lateral_speed_limit =
+      std::abs(curvatures[i]) > 1e-9
+        ? std::sqrt(params.max_lateral_acc_mps2 / std::abs(curvatures[i]))
+        : std::numeric_limits<double>::max();
+    speeds[i] = std::min(speed(s), lateral_speed_limit);
+  }
+  for (size_t i = 1; i < speeds.size(); ++i) {
+    speeds[i] = std::min(
+      speeds[i], std::sqrt(speeds[i - 1] * speeds[i - 1] + 2.0 * params.max_acc_mps2 * ds));
+  }
+  for (size_t i = speeds.size(); i > 1; --i) {
+    speeds[i - 2] = std::min(
+      speeds[i - 2], std::sqrt(speeds[i - 1] * speeds[i - 1] + 2.0 * params.max_dec_mps2 * ds));
+  }
+
+  TrajectoryPoints points(params.num_points);
+  double x = 0.0;
+  double y = 0.0;
+  double yaw = 0.0;
+  double time_s = 0.0;
+  for (size_t i = 0; i < points.size(); ++i) {
+    const auto kappa = curvatures[i];
+    const auto v = speeds[i];
+    if (i > 0) {
+      const auto v_prev = speeds[i - 1];
+      points[i - 1].acceleration_mps2 = static_cast<float>((v * v - v_prev * v_prev) / (2.0 * ds));
+      time_s += ds / std::max((v + v_prev) / 2.0, 0.1);
+    }
+    auto & point = points[i];
+    point.pose.position.x = x;
+    point.pose.position.y = y;
+    set_yaw(point.pose.orientation, yaw);
+    point.longitudinal_velocity_mps = static_cast<float>(v);
+    point.heading_rate_rps = static_cast<float>(kappa * v);
+    point.time_from_start = rclcpp::Duration::from_seconds(time_s);
+
+    // midpoint integration of the pose to the next point
+    const auto mid_yaw = yaw + kappa * ds / 2.0;
+    x += ds * std::cos(mid_yaw);
+    y += ds * std::sin(mid_yaw);
+    yaw += kappa * ds;
+  }
+  return points;
+}
+
+void ScenarioGenerator::apply_defects(TrajectoryPoints & points, const DefectParams & defects)
+{
+  for (auto & point : points) {
+    if (defects.position_noise_stddev_m > 0.0) {
+      point.pose.position.x += normal(defects.position_noise_stddev_m);
+      point.pose.position.y += normal(defects.position_noise_stddev_m);
+    }
+    if (defects.yaw_noise_stddev_rad > 0.0) {
+      set_yaw(
+        point.pose.orientation,
+        get_yaw(point.pose.orientation) + normal(defects.yaw_noise_stddev_rad));
+    }
+    if (defects.velocity_noise_stddev_mps > 0.0) {
+      point.longitudinal_velocity_mps +=
+        static_cast<float>(normal(defects.velocity_noise_stddev_mps));
+    }
+  }
+
+  if (defects.duplicate_point_ratio > 0.0) {
+    TrajectoryPoints duplicated;
+    duplicated.reserve(points.size() * 2);
+    for (const auto & point : points) {
+      duplicated.push_back(point);
+      if (uniform() < defects.duplicate_point_ratio) {
+        duplicated.push_back(point);
+      }
+    }
+    points = std::move(duplicated);
+  }
+
+  if (defects.invalid_point_ratio > 0.0) {
+    for (auto & point : points) {
+      if (uniform() < defects.invalid_point_ratio) {
+        const auto nan = std::numeric_limits<double>::quiet_NaN();
+        switch (engine_() % 3) {
+          case 0:
+            point.pose.position.x = nan;
+            break;
+          case 1:
+            point.pose.position.y = nan;
+            break;
+          default:
+            point.pose.position.z = nan;
+            break;
+        }
+      }
+    }
+  }
+}
+
+Scenario ScenarioGenerator::generate(const ScenarioParams & params)
+{
+  Scenario scenario;
+  scenario.previous_trajectory = generate_path(params, 0.0, 1.0);
+  scenario.trajectory = scenario.previous_trajectory;
+  apply_defects(scenario.trajectory, params.defects);
+  if (scenario.previous_trajectory.empty()) {
+    return scenario;
+  }
+
+  // ego close to the start of the candidate, with a small tracking error
+  const auto & start = scenario.previous_trajectory.front();
+  auto & odometry = scenario.odometry;
+  odometry.header.frame_id = "map";
+  odometry.child_frame_id = "base_link";
+  odometry.pose.pose.position.y = uniform(-0.2, 0.2);
+  set_yaw(odometry.pose.pose.orientation, uniform(-0.02, 0.02));
+  odometry.twist.twist.linear.x = start.longitudinal_velocity_mps;
+  scenario.acceleration.header.frame_id = "base_link";
+  scenario.acceleration.accel.accel.linear.x = start.acceleration_mps2;
+
+  // driven straight up to the start
+  constexpr size_t num_history_points = 20;
+  for (size_t i = num_history_points; i > 0; --i) {
+    TrajectoryPoint point = start;
+    point.pose.position.x = -static_cast<double>(i) * params.point_interval_m;
+    set_yaw(point.pose.orientation, 0.0);
+    point.heading_rate_rps = 0.0f;
+    point.acceleration_mps2 = 0.0f;
+    scenario.ego_history_points.push_back(point);
+  }
+  return scenario;
+}
+
+autoware_new_planning_msgs::msg::Trajectories ScenarioGenerator::generate_candidates(
+  const ScenarioParams & params, const size_t num_modes, Scenario * scenario)
+{
+  autoware_new_planning_msgs::msg::Trajectories candidates;
+  if (num_modes == 0) {
+    return candidates;
+  }
+  auto first_mode = generate(params);
+
+  std::vector<double> scores(num_modes);
+  for (auto & score : scores) {
+    score = uniform(0.05, 1.0);
+  }
+  std::sort(scores.begin(), scores.end(), std::greater<>());
+  double total_score = 0.0;
+  for (const auto score : scores) {
+    total_score += score;
+  }
+
+  candidates.trajectories.resize(num_modes);
+  for (size_t i = 0; i < num_modes; ++i) {
+    auto & candidate = candidates.trajectories[i];
+    candidate.generator_id.uuid[0] = static_cast<uint8_t>(i);
+    candidate.score = scores[i] / total_score;
+    if (i == 0) {
+      candidate.points = first_mode.trajectory;
+      continue;
+    }
+    // the other modes redraw the maneuver, e.g. turn the other way, and diverge in shape and speed
+    candidate.points = generate_path(params, uniform(-0.01, 0.01), uniform(0.6, 1.2));
+    apply_defects(candidate.points, params.defects);
+  }
+  if (scenario) {
+    *scenario = std::move(first_mode);
+  }
+  return candidates;
+}
+
+}  // namespace autoware::trajectory_optimizer::scenarios
@@ -0,0 +1,206 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/trajectory_optimizer/shadow_chain.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <utility>
+
+namespace autoware::trajectory_optimizer
+{
+namespace
+{
+using autoware_planning_msgs::msg::TrajectoryPoint;
+
+double get_length(const std::vector<TrajectoryPoint> & points)
+{
+  double length = 0.0;
+  for (size_t i = 1; i < points.size(); ++i) {
+    length += std::hypot(
+      points[i].pose.position.x - points[i - 1].pose.position.x,
+      points[i].pose.position.y - points[i - 1].pose.position.y);
+  }
+  return length;
+}
+
+struct Projection
+{
+  double distance_m{std::numeric_limits<double>::infinity()};
+  double velocity_mps{0.0};
+};
+
+// nearest point of the primary path, by brute force since it only runs on the shadow thread and
+// a nearest-segment search that moves forward along the path would fail on hairpins
+Projection project(const std::vector<TrajectoryPoint> & path, const TrajectoryPoint & point)
+{
+  const auto & p = point.pose.position;
+  Projection nearest;
+  if (path.size() == 1) {
+    nearest.distance_m = std::hypot(p.x - path[0].pose.position.x, p.y - path[0].pose.position.y);
+    nearest.velocity_mps = path[0].longitudinal_velocity_mps;
+    return nearest;
+  }
+  for (size_t i = 1; i < path.size(); ++i) {
+    const auto & a = path[i - 1];
+    const auto & b = path[i];
+    const double dx = b.pose.position.x - a.pose.position.x;
+    const double dy = b.pose.position.y - a.pose.position.y;
+    const double squared_length = dx * dx + dy * dy;
+    const double ratio =
+      squared_length > 0.0
+        ? std::clamp(
+            ((p.x - a.pose.position.x) * dx + (p.y - a.pose.position.y) * dy) / squared_length,
+            0.0, 1.0)
+        : 0.0;
+    const double distance = std::hypot(
+      p.x - (a.pose.position.x + ratio * dx), p.y - (a.pose.position.y + ratio * dy));
+    if (distance < nearest.distance_m) {
+      nearest.distance_m = distance;
+      nearest.velocity_mps = a.longitudinal_velocity_mps +
+                             ratio * (b.longitudinal_velocity_mps - a.longitudinal_velocity_mps);
+    }
+  }
+  return nearest;
+}
+}  // namespace
+
+OutputDifference compare_outputs(
+  const std::vector<TrajectoryPoint> & primary, const std::vector<TrajectoryPoint> & shadow)
+{
+  OutputDifference difference;
+  if (primary.empty() || shadow.empty()) {
+    const auto nan = std::numeric_limits<double>::quiet_NaN();
+    return OutputDifference{nan, nan, nan, nan};
+  }
+  double total_deviation = 0.0;
+  for (const auto & point : shadow) {
+    const auto projection = project(primary, point);
+    total_deviation += projection.distance_m;
+    difference.max_position_deviation_m =
+      std::max(difference.max_position_deviation_m, projection.distance_m);
+    difference.max_velocity_difference_mps = std::max(
+      difference.max_velocity_difference_mps,
+      std::abs(point.longitudinal_velocity_mps - projection.velocity_mps));
+  }
+  difference.mean_position_deviation_m = total_deviation / static_cast<double>(shadow.size());
+  difference.length_difference_m = get_length(shadow) - get_length(primary);
+  return difference;
+}
+
+void add_to_metrics(const OutputDifference & difference, ShadowMetrics & metrics)
+{
+  ++metrics.num_candidates;
+  if (std::isnan(difference.max_position_deviation_m)) {
+    return;
+  }
+  // fmax() ignores the NaN the metrics start from
+  metrics.max_position_deviation_m =
+    std::fmax(metrics.max_position_deviation_m, difference.max_position_deviation_m);
+  metrics.max_velocity_difference_mps =
+    std::fmax(metrics.max_velocity_difference_mps, difference.max_velocity_difference_mps);
+  if (
+    std::isnan(metrics.max_length_difference_m) ||
+    std::abs(difference.length_difference_m) > std::abs(metrics.max_length_difference_m)) {
+    metrics.max_length_difference_m = difference.length_difference_m;
+  }
+  // running mean over the compared candidates, the first one replacing the NaN
+  ++metrics.num_compared_candidates;
+  const double previous_mean = std::isnan(metrics.mean_position_deviation_m)
+                                 ? 0.0
+                                 : metrics.mean_position_deviation_m;
+  metrics.mean_position_deviation_m =
+    previous_mean + (difference.mean_position_deviation_m - previous_mean) /
+                      static_cast<double>(metrics.num_compared_candidates);
+}
+
+std::vector<rclcpp::Parameter> get_shadow_overrides(
+  const std::vector<rclcpp::Parameter> & parameters)
+{
+  const std::string prefix(shadow_parameter_prefix);
+  std::vector<rclcpp::Parameter> overrides;
+  for (const auto & parameter : parameters) {
+    const auto & name = parameter.get_name();
+    if (name.size() > prefix.size() && name.compare(0, prefix.size(), prefix) == 0) {
+      overrides.emplace_back(name.substr(prefix.size()), parameter.get_parameter_value());
+    }
+  }
+  return overrides;
+}
+
+ShadowRunner::ShadowRunner(const std::function<void()> & on_start) : on_start_(on_start)
+{
+  thread_ = std::thread([this]() { run(); });
+}
+
+ShadowRunner::~ShadowRunner()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  task_available_.notify_one();
+  thread_.join();
+}
+
+bool ShadowRunner::try_reserve()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (reserved_) {
+    ++num_skipped_;
+    return false;
+  }
+  reserved_ = true;
+  return true;
+}
+
+void ShadowRunner::submit(std::function<void()> task)
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    task_ = std::move(task);
+  }
+  task_available_.notify_one();
+}
+
+uint32_t ShadowRunner::take_num_skipped()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return std::exchange(num_skipped_, 0);
+}
+
+void ShadowRunner::run()
+{
+  if (on_start_) {
+    on_start_();
+  }
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    task_available_.wait(lock, [this]() { return stop_ || task_; });
+    if (stop_) {
+      return;
+    }
+    auto task = std::move(task_);
+    task_ = nullptr;
+    lock.unlock();
+    task();
+    lock.lock();
+    reserved_ = false;
+  }
+}
+
+}  // namespace autoware::trajectory_optimizer
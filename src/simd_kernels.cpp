@@ -0,0 +1,603 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/trajectory_optimizer/simd_kernels.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+
+#if defined(__x86_64__)
+#define TRAJECTORY_OPTIMIZER_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+namespace autoware::trajectory_optimizer::simd
+{
+namespace
+{
+constexpr size_t stride = sizeof(TrajectoryPoint);
+static_assert(stride % alignof(double) == 0, "points must keep their doubles aligned");
+
+struct KernelTable
+{
+  Isa isa;
+  void (*flag_invalid_points)(const TrajectoryPoint *, size_t, uint8_t *);
+  void (*flag_close_pairs)(const TrajectoryPoint *, size_t, double, uint8_t *);
+  void (*clamp_min_velocity_and_acceleration)(TrajectoryPoint *, size_t, float, float);
+  void (*clamp_max_velocity)(TrajectoryPoint *, size_t, float);
+};
+
+// the squared distance is compared with a guard band around min_dist^2 that is much wider than its
+// rounding error, and only the pairs inside the band are decided with std::hypot like the scalar
+// version, so every version flags the same pairs
+constexpr double guard_band = 1e-9;
+
+bool is_valid(const TrajectoryPoint & point)
+{
+  return std::isfinite(point.pose.position.x) && std::isfinite(point.pose.position.y) &&
+         std::isfinite(point.pose.position.z) && std::isfinite(point.pose.orientation.x) &&
+         std::isfinite(point.pose.orientation.y) && std::isfinite(point.pose.orientation.z) &&
+         std::isfinite(point.pose.orientation.w) &&
+         std::isfinite(point.longitudinal_velocity_mps) && std::isfinite(point.acceleration_mps2);
+}
+
+bool is_close(const TrajectoryPoint & a, const TrajectoryPoint & b, const double min_dist)
+{
+  return std::hypot(
+           b.pose.position.x - a.pose.position.x, b.pose.position.y - a.pose.position.y) <
+         min_dist;
+}
+
+void flag_invalid_points_scalar(
+  const TrajectoryPoint * points, const size_t num_points, uint8_t * is_invalid)
+{
+  for (size_t i = 0; i < num_points; ++i) {
+    is_invalid[i] = !is_valid(points[i]);
+  }
+}
+
+void flag_close_pairs_scalar(
+  const TrajectoryPoint * points, const size_t num_points, const double min_dist,
+  uint8_t * is_close_pair)
+{
+  for (size_t i = 0; i + 1 < num_points; ++i) {
+    is_close_pair[i] = is_close(points[i], points[i + 1], min_dist);
+  }
+}
+
+void clamp_min_velocity_and_acceleration_scalar(
+  TrajectoryPoint * points, const size_t num_points, const float min_velocity,
+  const float min_acceleration)
+{
+  for (size_t i = 0; i < num_points; ++i) {
+    points[i].longitudinal_velocity_mps =
+      std::max(points[i].longitudinal_velocity_mps, min_velocity);
+    points[i].acceleration_mps2 = std::max(points[i].acceleration_mps2, min_acceleration);
+  }
+}
+
+void clamp_max_velocity_scalar(
+  TrajectoryPoint * points, const size_t num_points, const float max_velocity)
+{
+  for (size_t i = 0; i < num_points; ++i) {
+    points[i].longitudinal_velocity_mps =
+      std::min(points[i].longitudinal_velocity_mps, max_velocity);
+  }
+}
+
+constexpr KernelTable scalar_kernels{
+  Isa::SCALAR, flag_invalid_points_scalar, flag_close_pairs_scalar,
+  clamp_min_velocity_and_acceleration_scalar, clamp_max_velocity_scalar};
+
+#ifdef TRAJECTORY_OPTIMIZER_X86_KERNELS
+// NOTE: max(a, b) and min(a, b) return b when either is NaN, so max(limit, value) and
+// min(limit, value) match std::max(value, limit) and std::min(value, limit), including NaN and
+// signed zeros.
+
+// ---------------------------------------------------------------------------------------------
+// SSE4: two points at a time, loaded lane by lane
+// ---------------------------------------------------------------------------------------------
+// x - x is 0 for finite values and NaN otherwise
+__attribute__((target("sse4.2"))) __m128d is_finite2(const double a, const double b)
+{
+  const __m128d v = _mm_set_pd(b, a);
+  return _mm_cmpeq_pd(_mm_sub_pd(v, v), _mm_setzero_pd());
+}
+
+__attribute__((target("sse4.2"))) void flag_invalid_points_sse4(
+  const TrajectoryPoint * points, const size_t num_points, uint8_t * is_invalid)
+{
+  size_t i = 0;
+  for (; i + 2 <= num_points; i += 2) {
+    const auto & a = points[i];
+    const auto & b = points[i + 1];
+    __m128d valid = is_finite2(a.pose.position.x, b.pose.position.x);
+    valid = _mm_and_pd(valid, is_finite2(a.pose.position.y, b.pose.position.y));
+    valid = _mm_and_pd(valid, is_finite2(a.pose.position.z, b.pose.position.z));
+    valid = _mm_and_pd(valid, is_finite2(a.pose.orientation.x, b.pose.orientation.x));
+    valid = _mm_and_pd(valid, is_finite2(a.pose.orientation.y, b.pose.orientation.y));
+    valid = _mm_and_pd(valid, is_finite2(a.pose.orientation.z, b.pose.orientation.z));
+    valid = _mm_and_pd(valid, is_finite2(a.pose.orientation.w, b.pose.orientation.w));
+    const __m128 motion = _mm_set_ps(
+      b.acceleration_mps2, b.longitudinal_velocity_mps, a.acceleration_mps2,
+      a.longitudinal_velocity_mps);
+    const int motion_valid =
+      _mm_movemask_ps(_mm_cmpeq_ps(_mm_sub_ps(motion, motion), _mm_setzero_ps()));
+    const int pose_valid = _mm_movemask_pd(valid);
+    is_invalid[i] = !((pose_valid & 1) && (motion_valid & 0x3) == 0x3);
+    is_invalid[i + 1] = !((pose_valid & 2) && (motion_valid & 0xc) == 0xc);
+  }
+  flag_invalid_points_scalar(points + i, num_points - i, is_invalid + i);
+}
+
+__attribute__((target("sse4.2"))) void flag_close_pairs_sse4(
+  const TrajectoryPoint * points, const size_t num_points, const double min_dist,
+  uint8_t * is_close_pair)
+{
+  if (!(min_dist > 0.0)) {
+    std::fill(is_close_pair, is_close_pair + std::max<size_t>(num_points, 1) - 1, 0);
+    return;
+  }
+  const double min_dist2 = min_dist * min_dist;
+  const __m128d lower = _mm_set1_pd(min_dist2 * (1.0 - guard_band));
+  const __m128d upper = _mm_set1_pd(min_dist2 * (1.0 + guard_band));
+  size_t i = 0;
+  for (; i + 3 <= num_points; i += 2) {
+    const auto & a = points[i];
+    const auto & b = points[i + 1];
+    const auto & c = points[i + 2];
+    const __m128d dx = _mm_sub_pd(
+      _mm_set_pd(c.pose.position.x, b.pose.position.x),
+      _mm_set_pd(b.pose.position.x, a.pose.position.x));
+    const __m128d dy = _mm_sub_pd(
+      _mm_set_pd(c.pose.position.y, b.pose.position.y),
+      _mm_set_pd(b.pose.position.y, a.pose.position.y));
+    const __m128d d2 = _mm_add_pd(_mm_mul_pd(dx, dx), _mm_mul_pd(dy, dy));
+    const int close = _mm_movemask_pd(_mm_cmplt_pd(d2, lower));
+    const int far = _mm_movemask_pd(_mm_cmpge_pd(d2, upper));
+    for (size_t lane = 0; lane < 2; ++lane) {
+      is_close_pair[i + lane] = (close >> lane) & 1   ? 1
+                                : (far >> lane) & 1 ? 0
+                                                    : is_close(points[i + lane],
+                                                               points[i + lane + 1], min_dist);
+    }
+  }
+  flag_close_pairs_scalar(points + i, num_points - i, min_dist, is_close_pair + i);
+}
+
+__attribute__((target("sse4.2"))) void clamp_min_velocity_and_acceleration_sse4(
+  TrajectoryPoint * points, const size_t num_points, const float min_velocity,
+  const float min_acceleration)
+{
+  const __m128 limits = _mm_set_ps(min_acceleration, min_velocity, min_acceleration, min_velocity);
+  size_t i = 0;
+  for (; i + 2 <= num_points; i += 2) {
+    auto & a = points[i];
+    auto & b = points[i + 1];
+    const __m128 motion = _mm_set_ps(
+      b.acceleration_mps2, b.longitudinal_velocity_mps, a.acceleration_mps2,
+      a.longitudinal_velocity_mps);
+    alignas(16) float clamped[4];
+    _mm_store_ps(clamped, _mm_max_ps(limits, motion));
+    a.longitudinal_velocity_mps = clamped[0];
+    a.acceleration_mps2 = clamped[1];
+    b.longitudinal_velocity_mps = clamped[2];
+    b.acceleration_mps2 = clamped[3];
+  }
+  clamp_min_velocity_and_acceleration_scalar(
+    points + i, num_points - i, min_velocity, min_acceleration);
+}
+
+__attribute__((target("sse4.2"))) void clamp_max_velocity_sse4(
+  TrajectoryPoint * points, const size_t num_points, const float max_velocity)
+{
+  const __m128 limit = _mm_set1_ps(max_velocity);
+  size_t i = 0;
+  for (; i + 4 <= num_points; i += 4) {
+    const __m128 velocity = _mm_set_ps(
+      points[i + 3].longitudinal_velocity_mps, points[i + 2].longitudinal_velocity_mps,
+      points[i + 1].longitudinal_velocity_mps, points[i].longitudinal_velocity_mps);
+    alignas(16) float clamped[4];
+    _mm_store_ps(clamped, _mm_min_ps(limit, velocity));
+    for (size_t lane = 0; lane < 4; ++lane) {
+      points[i + lane].longitudinal_velocity_mps = clamped[lane];
+    }
+  }
+  clamp_max_velocity_scalar(points + i, num_points - i, max_velocity);
+}
+
+constexpr KernelTable sse4_kernels{
+  Isa::SSE4, flag_invalid_points_sse4, flag_close_pairs_sse4,
+  clamp_min_velocity_and_acceleration_sse4, clamp_max_velocity_sse4};
+
+// ---------------------------------------------------------------------------------------------
+// AVX2: four points at a time, gathered with the point size as stride
+// ---------------------------------------------------------------------------------------------
+__attribute__((target("avx2"))) __m256d gather4(const double & field, const __m256i offsets)
+{
+  return _mm256_i64gather_pd(&field, offsets, 1);
+}
+
+__attribute__((target("avx2"))) __m128 gather4(const float & field, const __m128i offsets)
+{
+  return _mm_i32gather_ps(&field, offsets, 1);
+}
+
+__attribute__((target("avx2"))) __m256d is_finite4(const double & field, const __m256i offsets)
+{
+  const __m256d v = gather4(field, offsets);
+  return _mm256_cmp_pd(_mm256_sub_pd(v, v), _mm256_setzero_pd(), _CMP_EQ_OQ);
+}
+
+__attribute__((target("avx2"))) __m128 is_finite4(const float & field, const __m128i offsets)
+{
+  const __m128 v = gather4(field, offsets);
+  return _mm_cmp_ps(_mm_sub_ps(v, v), _mm_setzero_ps(), _CMP_EQ_OQ);
+}
+
+__attribute__((target("avx2"))) void flag_invalid_points_avx2(
+  const TrajectoryPoint * points, const size_t num_points, uint8_t * is_invalid)
+{
+  const __m256i offsets = _mm256_set_epi64x(3 * stride, 2 * stride, stride, 0);
+  const __m128i offsets32 = _mm_set_epi32(3 * stride, 2 * stride, stride, 0);
+  size_t i = 0;
+  for (; i + 4 <= num_points; i += 4) {
+    const auto & pose = points[i].pose;
+    __m256d valid = is_finite4(pose.position.x, offsets);
+    valid = _mm256_and_pd(valid, is_finite4(pose.position.y, offsets));
+    valid = _mm256_and_pd(valid, is_finite4(pose.position.z, offsets));
+    valid = _mm256_and_pd(valid, is_finite4(pose.orientation.x, offsets));
+    valid = _mm256_and_pd(valid, is_finite4(pose.orientation.y, offsets));
+    valid = _mm256_and_pd(valid, is_finite4(pose.orientation.z, offsets));
+    valid = _mm256_and_pd(valid, is_finite4(pose.orientation.w, offsets));
+    const __m128 motion_valid = _mm_and_ps(
+      is_finite4(points[i].longitudinal_velocity_mps, offsets32),
+      is_finite4(points[i].acceleration_mps2, offsets32));
+    const int valid_mask = _mm256_movemask_pd(valid) & _mm_movemask_ps(motion_valid);
+    for (size_t lane = 0; lane < 4; ++lane) {
+      is_invalid[i + lane] = !((valid_mask >> lane) & 1);
+    }
+  }
+  flag_invalid_points_scalar(points + i, num_points - i, is_invalid + i);
+}
+
+__attribute__((target("avx2"))) void flag_close_pairs_avx2(
+  const TrajectoryPoint * points, const size_t num_points, const double min_dist,
+  uint8_t * is_close_pair)
+{
+  if (!(min_dist > 0.0)) {
+    std::fill(is_close_pair, is_close_pair + std::max<size_t>(num_points, 1) - 1, 0);
+    return;
+  }
+  const double min_dist2 = min_dist * min_dist;
+  const __m256d lower = _mm256_set1_pd(min_dist2 * (1.0 - guard_band));
+  const __m256d upper = _mm256_set1_pd(min_dist2 * (1.0 + guard_band));
+  const __m256i offsets = _mm256_set_epi64x(3 * stride, 2 * stride, stride, 0);
+  size_t i = 0;
+  for (; i + 5 <= num_points; i += 4) {
+    const __m256d dx = _mm256_sub_pd(
+      gather4(points[i + 1].pose.position.x, offsets),
+      gather4(points[i].pose.position.x, offsets));
+    const __m256d dy = _mm256_sub_pd(
+      gather4(points[i + 1].pose.position.y, offsets),
+      gather4(points[i].pose.position.y, offsets));
+    const __m256d d2 = _mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy));
+    const int close = _mm256_movemask_pd(_mm256_cmp_pd(d2, lower, _CMP_LT_OQ));
+    const int far = _mm256_movemask_pd(_mm256_cmp_pd(d2, upper, _CMP_GE_OQ));
+    for (size_t lane = 0; lane < 4; ++lane) {
+      is_close_pair[i + lane] = (close >> lane) & 1   ? 1
+                                : (far >> lane) & 1 ? 0
+                                                    : is_close(points[i + lane],
+                                                               points[i + lane + 1], min_dist);
+    }
+  }
+  flag_close_pairs_scalar(points + i, num_points - i, min_dist, is_close_pair + i);
+}
+
+__attribute__((target("avx2"))) void clamp_min_velocity_and_acceleration_avx2(
+  TrajectoryPoint * points, const size_t num_points, const float min_velocity,
+  const float min_acceleration)
+{
+  const __m128i offsets32 = _mm_set_epi32(3 * stride, 2 * stride, stride, 0);
+  const __m128 velocity_limit = _mm_set1_ps(min_velocity);
+  const __m128 acceleration_limit = _mm_set1_ps(min_acceleration);
+  size_t i = 0;
+  for (; i + 4 <= num_points; i += 4) {
+    alignas(16) float velocity[4];
+    alignas(16) float acceleration[4];
+    _mm_store_ps(
+      velocity,
+      _mm_max_ps(velocity_limit, gather4(points[i].longitudinal_velocity_mps, offsets32)));
+    _mm_store_ps(
+      acceleration,
+      _mm_max_ps(acceleration_limit, gather4(points[i].acceleration_mps2, offsets32)));
+    // AVX2 has no scatter
+    for (size_t lane = 0; lane < 4; ++lane) {
+      points[i + lane].longitudinal_velocity_mps = velocity[lane];
+      points[i + lane].acceleration_mps2 = acceleration[lane];
+    }
+  }
+  clamp_min_velocity_and_acceleration_scalar(
+    points + i, num_points - i, min_velocity, min_acceleration);
+}
+
+__attribute__((target("avx2"))) void clamp_max_velocity_avx2(
+  TrajectoryPoint * points, const size_t num_points, const float max_velocity)
+{
+  const __m128i offsets32 = _mm_set_epi32(3 * stride, 2 * stride, stride, 0);
+  const __m128 limit = _mm_set1_ps(max_velocity);
+  size_t i = 0;
+  for (; i + 4 <= num_points; i += 4) {
+    alignas(16) float velocity[4];
+    _mm_store_ps(
+      velocity, _mm_min_ps(limit, gather4(points[i].longitudinal_velocity_mps, offsets32)));
+    for (size_t lane = 0; lane < 4; ++lane) {
+      points[i + lane].longitudinal_velocity_mps = velocity[lane];
+    }
+  }
+  clamp_max_velocity_scalar(points + i, num_points - i, max_velocity);
+}
+
+constexpr KernelTable avx2_kernels{
+  Isa::AVX2, flag_invalid_points_avx2, flag_close_pairs_avx2,
+  clamp_min_velocity_and_acceleration_avx2, clamp_max_velocity_avx2};
+
+// ---------------------------------------------------------------------------------------------
+// AVX-512: eight points at a time, gathered and scattered with the point size as stride
+// ---------------------------------------------------------------------------------------------
+__attribute__((target("avx512f,avx512vl"))) __m512d gather8(
+  const double & field, const __m512i offsets)
+{
+  // the masked gather with an explicit source avoids a spurious -Wmaybe-uninitialized in GCC 12
+  return _mm512_mask_i64gather_pd(_mm512_setzero_pd(), 0xff, offsets, &field, 1);
+}
+
+__attribute__((target("avx512f,avx512vl"))) __m256 gather8(
+  const float & field, const __m256i offsets)
+{
+  return _mm256_i32gather_ps(&field, offsets, 1);
+}
+
+__attribute__((target("avx512f,avx512vl"))) __mmask8 is_finite8(
+  const double & field, const __m512i offsets)
+{
+  const __m512d v = gather8(field, offsets);
+  return _mm512_cmp_pd_mask(_mm512_sub_pd(v, v), _mm512_setzero_pd(), _CMP_EQ_OQ);
+}
+
+__attribute__((target("avx512f,avx512vl"))) __mmask8 is_finite8(
+  const float & field, const __m256i offsets)
+{
+  const __m256 v = gather8(field, offsets);
+  return _mm256_cmp_ps_mask(_mm256_sub_ps(v, v), _mm256_setzero_ps(), _CMP_EQ_OQ);
+}
+
+__attribute__((target("avx512f,avx512vl"))) void flag_invalid_points_avx512(
+  const TrajectoryPoint * points, const size_t num_points, uint8_t * is_invalid)
+{
+  const __m512i offsets = _mm512_set_epi64(
+    7 * stride, 6 * stride, 5 * stride, 4 * stride, 3 * stride, 2 * stride, stride, 0);
+  const __m256i offsets32 = _mm256_set_epi32(
+    7 * stride, 6 * stride, 5 * stride, 4 * stride, 3 * stride, 2 * stride, stride, 0);
+  size_t i = 0;
+  for (; i + 8 <= num_points; i += 8) {
+    const auto & pose = points[i].pose;
+    const __mmask8 valid =
+      is_finite8(pose.position.x, offsets) & is_finite8(pose.position.y, offsets) &
+      is_finite8(pose.position.z, offsets) & is_finite8(pose.orientation.x, offsets) &
+      is_finite8(pose.orientation.y, offsets) & is_finite8(pose.orientation.z, offsets) &
+      is_finite8(pose.orientation.w, offsets) &
+      is_finite8(points[i].longitudinal_velocity_mps, offsets32) &
+      is_finite8(points[i].acceleration_mps2, offsets32);
+    for (size_t lane = 0; lane < 8; ++lane) {
+      is_invalid[i + lane] = !((valid >> lane) & 1);
+    }
+  }
+  flag_invalid_points_scalar(points + i, num_points - i, is_invalid + i);
+}
+
+__attribute__((target("avx512f,avx512vl"))) void flag_close_pairs_avx512(
+  const TrajectoryPoint * points, const size_t num_points, const double min_dist,
+  uint8_t * is_close_pair)
+{
+  if (!(min_dist > 0.0)) {
+    std::fill(is_close_pair, is_close_pair + std::max<size_t>(num_points, 1) - 1, 0);
+    return;
+  }
+  const double min_dist2 = min_dist * min_dist;
+  const __m512d lower = _mm512_set1_pd(min_dist2 * (1.0 - guard_band));
+  const __m512d upper = _mm512_set1_pd(min_dist2 * (1.0 + guard_band));
+  const __m512i offsets = _mm512_set_epi64(
+    7 * stride, 6 * stride, 5 * stride, 4 * stride, 3 * stride, 2 * stride, stride, 0);
+  size_t i = 0;
+  for (; i + 9 <= num_points; i += 8) {
+    const __m512d dx = _mm512_sub_pd(
+      gather8(points[i + 1].pose.position.x, offsets),
+      gather8(points[i].pose.position.x, offsets));
+    const __m512d dy = _mm512_sub_pd(
+      gather8(points[i + 1].pose.position.y, offsets),
+      gather8(points[i].pose.position.y, offsets));
+    const __m512d d2 = _mm512_add_pd(_mm512_mul_pd(dx, dx), _mm512_mul_pd(dy, dy));
+    const __mmask8 close = _mm512_cmp_pd_mask(d2, lower, _CMP_LT_OQ);
+    const __mmask8 far = _mm512_cmp_pd_mask(d2, upper, _CMP_GE_OQ);
+    for (size_t lane = 0; lane < 8; ++lane) {
+      is_close_pair[i + lane] = (close >> lane) & 1   ? 1
+                                : (far >> lane) & 1 ? 0
+                                                    : is_close(points[i + lane],
+                                                               points[i + lane + 1], min_dist);
+    }
+  }
+  flag_close_pairs_scalar(points + i, num_points - i, min_dist, is_close_pair + i);
+}
+
+__attribute__((target("avx512f,avx512vl"))) void clamp_min_velocity_and_acceleration_avx512(
+  TrajectoryPoint * points, const size_t num_points, const float min_velocity,
+  const float min_acceleration)
+{
+  const __m256i offsets32 = _mm256_set_epi32(
+    7 * stride, 6 * stride, 5 * stride, 4 * stride, 3 * stride, 2 * stride, stride, 0);
+  const __m256 velocity_limit = _mm256_set1_ps(min_velocity);
+  const __m256 acceleration_limit = _mm256_set1_ps(min_acceleration);
+  size_t i = 0;
+  for (; i + 8 <= num_points; i += 8) {
+    auto & velocity = points[i].longitudinal_velocity_mps;
+    auto & acceleration = points[i].acceleration_mps2;
+    _mm256_i32scatter_ps(
+      &velocity, offsets32, _mm256_max_ps(velocity_limit, gather8(velocity, offsets32)), 1);
+    _mm256_i32scatter_ps(
+      &acceleration, offsets32, _mm256_max_ps(acceleration_limit, gather8(acceleration, offsets32)),
+      1);
+  }
+  clamp_min_velocity_and_acceleration_scalar(
+    points + i, num_points - i, min_velocity, min_acceleration);
+}
+
+__attribute__((target("avx512f,avx512vl"))) void clamp_max_velocity_avx512(
+  TrajectoryPoint * points, const size_t num_points, const float max_velocity)
+{
+  const __m256i offsets32 = _mm256_set_epi32(
+    7 * stride, 6 * stride, 5 * stride, 4 * stride, 3 * stride, 2 * stride, stride, 0);
+  const __m256 limit = _mm256_set1_ps(max_velocity);
+  size_t i = 0;
+  for (; i + 8 <= num_points; i += 8) {
+    auto & velocity = points[i].longitudinal_velocity_mps;
+    _mm256_i32scatter_ps(
+      &velocity, offsets32, _mm256_min_ps(limit, gather8(velocity, offsets32)), 1);
+  }
+  clamp_max_velocity_scalar(points + i, num_points - i, max_velocity);
+}
+
+constexpr KernelTable avx512_kernels{
+  Isa::AVX512, flag_invalid_points_avx512, flag_close_pairs_avx512,
+  clamp_min_velocity_and_acceleration_avx512, clamp_max_velocity_avx512};
+#endif  // TRAJECTORY_OPTIMIZER_X86_KERNELS
+
+const KernelTable & get_kernels(const Isa isa)
+{
+  switch (isa) {
+#ifdef TRAJECTORY_OPTIMIZER_X86_KERNELS
+    case Isa::AVX512:
+      return avx512_kernels;
+    case Isa::AVX2:
+      return avx2_kernels;
+    case Isa::SSE4:
+      return sse4_kernels;
+#endif
+    default:
+      return scalar_kernels;
+  }
+}
+
+Isa select_isa()
+{
+  const auto isas = supported_isas();
+  auto isa = isas.back();
+  if (const char * max_isa = std::getenv("TRAJECTORY_OPTIMIZER_MAX_ISA")) {
+    // an unknown name does not cap anything
+    for (const auto candidate : isas) {
+      if (to_string(candidate) == max_isa) {
+        isa = candidate;
+      }
+    }
+  }
+  return isa;
+}
+
+std::atomic<const KernelTable *> & active_kernels()
+{
+  static std::atomic<const KernelTable *> kernels{&get_kernels(select_isa())};
+  return kernels;
+}
+
+const KernelTable & kernels()
+{
+  return *active_kernels().load(std::memory_order_relaxed);
+}
+}  // namespace
+
+std::string to_string(const Isa isa)
+{
+  switch (isa) {
+    case Isa::SSE4:
+      return "sse4";
+    case Isa::AVX2:
+      return "avx2";
+    case Isa::AVX512:
+      return "avx512";
+    default:
+      return "scalar";
+  }
+}
+
+std::vector<Isa> supported_isas()
+{
+  std::vector<Isa> isas{Isa::SCALAR};
+#ifdef TRAJECTORY_OPTIMIZER_X86_KERNELS
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("sse4.2")) {
+    isas.push_back(Isa::SSE4);
+  }
+  if (__builtin_cpu_supports("avx2")) {
+    isas.push_back(Isa::AVX2);
+  }
+  if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vl")) {
+    isas.push_back(Isa::AVX512);
+  }
+#endif
+  return isas;
+}
+
+Isa active_isa()
+{
+  return kernels().isa;
+}
+
+bool set_active_isa(const Isa isa)
+{
+  const auto isas = supported_isas();
+  if (std::find(isas.begin(), isas.end(), isa) == isas.end()) {
+    return false;
+  }
+  active_kernels().store(&get_kernels(isa), std::memory_order_relaxed);
+  return true;
+}
+
+void flag_invalid_points(
+  const TrajectoryPoint * points, const size_t num_points, uint8_t * is_invalid)
+{
+  kernels().flag_invalid_points(points, num_points, is_invalid);
+}
+
+void flag_close_pairs(
+  const TrajectoryPoint * points, const size_t num_points, const double min_dist,
+  uint8_t * is_close)
+{
+  kernels().flag_close_pairs(points, num_points, min_dist, is_close);
+}
+
+void clamp_min_velocity_and_acceleration(
+  TrajectoryPoint * points, const size_t num_points, const float min_velocity,
+  const float min_acceleration)
+{
+  kernels().clamp_min_velocity_and_acceleration(
+    points, num_points, min_velocity, min_acceleration);
+}
+
+void clamp_max_velocity(TrajectoryPoint * points, const size_t num_points, const float max_velocity)
+{
+  kernels().clamp_max_velocity(points, num_points, max_velocity);
+}
+}  // namespace autoware::trajectory_optimizer::simd
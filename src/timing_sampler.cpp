@@ -0,0 +1,30 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/trajectory_optimizer/timing_sampler.hpp"
+
+namespace autoware::trajectory_optimizer
+{
+
+bool TimingSampler::sample_cycle()
+{
+  const auto cycle = num_cycles_.fetch_add(1, std::memory_order_relaxed);
+  if (forced_.exchange(false, std::memory_order_relaxed)) {
+    return true;
+  }
+  const auto period = period_.load(std::memory_order_relaxed);
+  return period > 0 && cycle % period == 0;
+}
+
+}  // namespace autoware::trajectory_optimizer
@@ -0,0 +1,77 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/trajectory_optimizer/trajectory_buffer_pool.hpp"
+
+#include <utility>
+
+namespace autoware::trajectory_optimizer
+{
+
+Trajectories & TrajectoryBufferPool::acquire(const Trajectories & input)
+{
+  auto & slots = message_.trajectories;
+  const auto num_candidates = input.trajectories.size();
+
+  // park surplus slots instead of destroying them so their buffers survive smaller cycles
+  while (slots.size() > num_candidates) {
+    spare_slots_.push_back(std::move(slots.back()));
+    slots.pop_back();
+  }
+  while (slots.size() < num_candidates) {
+    if (spare_slots_.empty()) {
+      slots.emplace_back();
+      continue;
+    }
+    slots.push_back(std::move(spare_slots_.back()));
+    spare_slots_.pop_back();
+  }
+
+  for (size_t i = 0; i < num_candidates; ++i) {
+    const auto & source = input.trajectories[i];
+    auto & slot = slots[i];
+    slot.header = source.header;
+    slot.generator_id = source.generator_id;
+    slot.score = source.score;
+    // assign() reuses the existing capacity of the slot
+    slot.points.assign(source.points.begin(), source.points.end());
+  }
+  message_.generator_info = input.generator_info;
+  return message_;
+}
+
+void TrajectoryBufferPool::reserve(const size_t num_slots, const size_t num_points)
+{
+  while (slot_count() < num_slots) {
+    spare_slots_.emplace_back();
+  }
+  auto prefault = [num_points](NewTrajectory & slot) {
+    if (slot.points.capacity() >= num_points) {
+      return;
+    }
+    // resize() writes every element, which faults the pages in; clear() keeps the capacity
+    slot.points.resize(num_points);
+    slot.points.clear();
+  };
+  for (auto & slot : message_.trajectories) {
+    if (slot.points.empty()) {
+      prefault(slot);
+    }
+  }
+  for (auto & slot : spare_slots_) {
+    prefault(slot);
+  }
+}
+
+}  // namespace autoware::trajectory_optimizer
@@ -13,6 +13,8 @@
 // limitations under the License.
 
 #include "autoware/motion_utils/resample/resample.hpp"
+#include "autoware/trajectory_optimizer/fixed_size_utils.hpp"
+#include "autoware/trajectory_optimizer/simd_kernels.hpp"
 #include "autoware/trajectory_optimizer/trajectory_optimizer.hpp"
 #include "autoware/trajectory_optimizer/utils.hpp"
 #include "autoware_utils/ros/parameter.hpp"
@@ -21,73 +23,482 @@
 #include <autoware/motion_utils/trajectory/trajectory.hpp>
 #include <autoware_utils/geometry/geometry.hpp>
 #include <autoware_utils/ros/update_param.hpp>
+#include <rclcpp/serialization.hpp>
 #include <autoware_vehicle_info_utils/vehicle_info_utils.hpp>
 
 #include <autoware_new_planning_msgs/msg/detail/trajectories__struct.hpp>
 #include <autoware_planning_msgs/msg/detail/trajectory_point__struct.hpp>
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
 #include <cstddef>
+#include <exception>
+#include <functional>
 #include <iostream>
+#include <limits>
 #include <numeric>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 namespace autoware::trajectory_optimizer
 {
+namespace
+{
+std::optional<int64_t> get_received_time_ns(const rclcpp::MessageInfo & message_info)
+{
+  // system time, 0 when the middleware does not report it
+  const auto received_timestamp = message_info.get_rmw_message_info().received_timestamp;
+  return received_timestamp > 0 ? std::make_optional<int64_t>(received_timestamp) : std::nullopt;
+}
+
+double get_age_ms(const rclcpp::Time & time, const builtin_interfaces::msg::Time & stamp)
+{
+  if (stamp.sec == 0 && stamp.nanosec == 0) {
+    return std::numeric_limits<double>::quiet_NaN();
+  }
+  return (time - rclcpp::Time(stamp, time.get_clock_type())).seconds() * 1e3;
+}
+}  // namespace
 
 TrajectoryInterpolator::TrajectoryInterpolator(const rclcpp::NodeOptions & options)
 : Node("trajectory_optimizer", options)
 {
   // create time_keeper and its publisher
   // NOTE: This has to be called before setupSmoother to pass the time_keeper to the smoother.
-  debug_processing_time_detail_ =
+  debug_processing_time_detail_pub_ =
     create_publisher<autoware_utils::ProcessingTimeDetail>("~/debug/processing_time_detail_ms", 1);
-  time_keeper_ = std::make_shared<autoware_utils::TimeKeeper>(debug_processing_time_detail_);
+  time_keeper_ = std::make_shared<autoware_utils::TimeKeeper>(debug_processing_time_detail_pub_);
+
+  RCLCPP_INFO(get_logger(), "Point kernels: %s", simd::to_string(simd::active_isa()).c_str());
 
   set_up_params();
+  set_up_perf_counters();
+  set_up_cost_model();
+  set_up_slow_cycle_capture();
+  set_up_realtime_profile();
+  set_up_shadow();
+  set_up_streams();
+
+  // requests are independent of each other and of the streams, so they may be served concurrently
+  service_callback_group_ = create_callback_group(rclcpp::CallbackGroupType::Reentrant);
+  optimize_trajectories_srv_ = create_service<OptimizeTrajectories>(
+    "~/optimize_trajectories",
+    std::bind(
+      &TrajectoryInterpolator::on_optimize_trajectories, this, std::placeholders::_1,
+      std::placeholders::_2),
+    rmw_qos_profile_services_default, service_callback_group_);
 
   // Parameter Callback
   set_param_res_ = add_on_set_parameters_callback(
     std::bind(&TrajectoryInterpolator::on_parameter, this, std::placeholders::_1));
 
-  // interface subscriber
-  trajectories_sub_ = create_subscription<Trajectories>(
-    "~/input/trajectories", 1,
-    std::bind(&TrajectoryInterpolator::on_traj, this, std::placeholders::_1));
-  // interface publisher
-  trajectories_pub_ = create_publisher<Trajectories>("~/output/trajectories", 1);
-  // debug time keeper
-  debug_processing_time_detail_pub_ =
-    create_publisher<autoware_utils::ProcessingTimeDetail>("~/debug/processing_time_detail_ms", 1);
-  time_keeper_ = std::make_shared<autoware_utils::TimeKeeper>(debug_processing_time_detail_pub_);
-  // last time a trajectory was received
-  last_time_ = std::make_shared<rclcpp::Time>(now());
+  start_stream_executors();
+}
+
+TrajectoryInterpolator::~TrajectoryInterpolator()
+{
+  for (const auto & executor : stream_executors_) {
+    executor->cancel();
+  }
+  for (auto & thread : stream_executor_threads_) {
+    thread.join();
+  }
+}
+
+void TrajectoryInterpolator::set_up_streams()
+{
+  using autoware_utils::get_or_declare_parameter;
+
+  // without server mode the node keeps its original, un-namespaced topics
+  std::vector<std::string> topic_prefixes{"~/"};
+  if (get_or_declare_parameter<bool>(*this, "server_mode.enable")) {
+    topic_prefixes.clear();
+    const auto stream_namespaces =
+      get_or_declare_parameter<std::vector<std::string>>(*this, "server_mode.stream_namespaces");
+    for (const auto & stream_namespace : stream_namespaces) {
+      topic_prefixes.push_back("~/" + stream_namespace + "/");
+    }
+  }
+
+  // lockstep mode synchronizes the inputs to the candidates' stamp instead of polling the latest
+  if (get_or_declare_parameter<bool>(*this, "lockstep_mode.enable")) {
+    lockstep_queue_size_ = static_cast<size_t>(
+      std::max<int64_t>(get_or_declare_parameter<int64_t>(*this, "lockstep_mode.queue_size"), 1));
+    // the velocity smoother of each worker warm-starts from its last candidate, so the output
+    // would depend on which worker picked up which candidate
+    if (num_worker_threads_ > 1) {
+      RCLCPP_WARN(
+        get_logger(),
+        "num_worker_threads is ignored in lockstep mode, candidates are optimized in order on the "
+        "callback thread");
+      num_worker_threads_ = 1;
+    }
+  }
+
+  // fixed-size messages that can be loaned instead of Trajectories, on separate topics
+  bounded_transport_ = get_or_declare_parameter<bool>(*this, "bounded_transport.enable");
+
+  // candidates are selected on the serialized message, before their points are decoded
+  lazy_deserialization_ = get_or_declare_parameter<bool>(*this, "lazy_deserialization.enable");
+
+  // lockstep mode has subscriptions of its own, on the full Trajectories message
+  if (lockstep_queue_size_ > 0 && bounded_transport_) {
+    RCLCPP_WARN(get_logger(), "bounded_transport.enable is ignored in lockstep mode");
+    bounded_transport_ = false;
+  }
+  if (lockstep_queue_size_ > 0 && lazy_deserialization_) {
+    RCLCPP_WARN(get_logger(), "lazy_deserialization.enable is ignored in lockstep mode");
+    lazy_deserialization_ = false;
+  }
+  max_selected_candidates_ = static_cast<size_t>(std::max<int64_t>(
+    get_or_declare_parameter<int64_t>(*this, "lazy_deserialization.max_candidates"), 0));
+  deduplicate_candidates_ =
+    get_or_declare_parameter<bool>(*this, "lazy_deserialization.deduplicate");
+
+  const bool streaming_output = get_or_declare_parameter<bool>(*this, "streaming_output.enable");
+
+  const auto metrics_window_s = get_or_declare_parameter<double>(*this, "cycle_metrics.window_s");
+  cycle_metrics_thresholds_.max_input_age_ms =
+    get_or_declare_parameter<double>(*this, "cycle_metrics.max_input_age_ms");
+  cycle_metrics_thresholds_.max_ego_state_age_ms =
+    get_or_declare_parameter<double>(*this, "cycle_metrics.max_ego_state_age_ms");
+  cycle_metrics_thresholds_.max_queueing_delay_ms =
+    get_or_declare_parameter<double>(*this, "cycle_metrics.max_queueing_delay_ms");
+  cycle_metrics_thresholds_.max_processing_time_ms =
+    get_or_declare_parameter<double>(*this, "cycle_metrics.max_processing_time_ms");
+  cycle_metrics_thresholds_.max_output_age_ms =
+    get_or_declare_parameter<double>(*this, "cycle_metrics.max_output_age_ms");
+
+  const auto & realtime_params = realtime_profile_ptr_->params();
+  for (const auto & topic_prefix : topic_prefixes) {
+    auto stream = std::make_unique<StreamContext>();
+    auto & stream_ref = *stream;
+    stream->topic_prefix = topic_prefix;
+    // the first stream keeps the topic of a single-stream node
+    stream->time_keeper = streams_.empty()
+                            ? time_keeper_
+                            : std::make_shared<autoware_utils::TimeKeeper>(
+                                create_publisher<autoware_utils::ProcessingTimeDetail>(
+                                  topic_prefix + "debug/processing_time_detail_ms", 1));
+    // each stream is serialized on its own, but different streams may run concurrently on a
+    // multi-threaded executor, or on executor threads of their own with the real-time profile
+    stream->callback_group = create_callback_group(
+      rclcpp::CallbackGroupType::MutuallyExclusive, !realtime_params.enable);
+    rclcpp::SubscriptionOptions subscription_options;
+    subscription_options.callback_group = stream->callback_group;
+
+    // interface subscriber
+    if (lockstep_queue_size_ > 0) {
+      set_up_lockstep_subscriptions(stream_ref, subscription_options);
+    } else if (bounded_transport_) {
+      stream->decoded_trajectories_ptr = std::make_shared<Trajectories>();
+      // the middleware hands out loaned messages by itself when it supports them
+      stream->bounded_trajectories_sub = create_subscription<BoundedTrajectories>(
+        topic_prefix + "input/bounded_trajectories", 1,
+        [this, &stream_ref](
+          const BoundedTrajectories::ConstSharedPtr msg, const rclcpp::MessageInfo & message_info) {
+          stream_ref.input_received_ns = get_received_time_ns(message_info);
+          from_bounded(*msg, *stream_ref.decoded_trajectories_ptr);
+          on_traj(stream_ref.decoded_trajectories_ptr, stream_ref);
+        },
+        subscription_options);
+    } else if (lazy_deserialization_) {
+      stream->decoded_trajectories_ptr = std::make_shared<Trajectories>();
+      // a serialized-message callback makes the subscription skip deserialization
+      stream->trajectories_sub = create_subscription<Trajectories>(
+        topic_prefix + "input/trajectories", 1,
+        [this, &stream_ref](
+          const std::shared_ptr<const rclcpp::SerializedMessage> serialized_msg,
+          const rclcpp::MessageInfo & message_info) {
+          stream_ref.input_received_ns = get_received_time_ns(message_info);
+          on_serialized_traj(*serialized_msg, stream_ref);
+        },
+        subscription_options);
+    } else {
+      stream->trajectories_sub = create_subscription<Trajectories>(
+        topic_prefix + "input/trajectories", 1,
+        [this, &stream_ref](
+          const Trajectories::ConstSharedPtr msg, const rclcpp::MessageInfo & message_info) {
+          stream_ref.input_received_ns = get_received_time_ns(message_info);
+          on_traj(msg, stream_ref);
+        },
+        subscription_options);
+    }
+    if (lockstep_queue_size_ == 0) {
+      stream->sub_current_odometry =
+        std::make_unique<autoware_utils::InterProcessPollingSubscriber<Odometry>>(
+          this, topic_prefix + "input/odometry");
+      stream->sub_current_acceleration = std::make_unique<
+        autoware_utils::InterProcessPollingSubscriber<AccelWithCovarianceStamped>>(
+        this, topic_prefix + "input/acceleration");
+      stream->sub_previous_trajectory =
+        std::make_unique<autoware_utils::InterProcessPollingSubscriber<Trajectory>>(
+          this, topic_prefix + "input/previous_trajectory");
+    }
+    // interface publisher
+    if (bounded_transport_) {
+      stream->bounded_trajectories_pub =
+        create_publisher<BoundedTrajectories>(topic_prefix + "output/bounded_trajectories", 1);
+    } else {
+      stream->trajectories_pub =
+        create_publisher<Trajectories>(topic_prefix + "output/trajectories", 1);
+    }
+    // end-to-end latency of each cycle of the stream
+    if (streaming_output) {
+      // each candidate as soon as it is optimized, ahead of the aggregate output
+      stream->candidate_pub =
+        create_publisher<OptimizedCandidate>(topic_prefix + "output/candidates", 10);
+    }
+    if (bounded_transport_) {
+      // the fallback message is too large for the stack
+      stream->bounded_output_ptr = std::make_unique<BoundedTrajectories>();
+    }
+    stream->processing_time_pub =
+      create_publisher<Float64Stamped>(topic_prefix + "debug/processing_time_ms", 1);
+    stream->cycle_metrics_pub =
+      create_publisher<CycleMetrics>(topic_prefix + "debug/cycle_metrics", 1);
+    stream->throughput_meter = ThroughputMeter(metrics_window_s);
+    if (shadow_runner_ptr_) {
+      stream->shadow_metrics_pub =
+        create_publisher<ShadowMetrics>(topic_prefix + "debug/shadow_metrics", 1);
+    }
+    if (slow_cycle_recorder_ptr_) {
+      stream->stage_timings_ptr = std::make_unique<StageTimings>();
+    }
+    if (cost_model_ptr_) {
+      stream->candidate_costs_pub =
+        create_publisher<CandidateCosts>(topic_prefix + "debug/candidate_costs", 1);
+    }
+    stream->last_time = now();
+
+    if (realtime_params.enable) {
+      stream->page_fault_monitor_ptr =
+        std::make_unique<PageFaultMonitor>(realtime_params.page_fault_warmup_cycles);
+      stream->buffer_pool.reserve(
+        static_cast<size_t>(std::max<int64_t>(realtime_params.prefault_trajectory_slots, 0)),
+        static_cast<size_t>(std::max<int64_t>(realtime_params.prefault_trajectory_points, 0)));
+    }
+    streams_.push_back(std::move(stream));
+  }
+}
+
+void TrajectoryInterpolator::set_up_lockstep_subscriptions(
+  StreamContext & stream, const rclcpp::SubscriptionOptions & subscription_options)
+{
+  // inputs must not be dropped by the transport, a faster-than-real-time sim may burst them
+  const auto qos = rclcpp::QoS(lockstep_queue_size_).reliable();
+
+  stream.trajectories_sub = create_subscription<Trajectories>(
+    stream.topic_prefix + "input/trajectories", qos,
+    [this, &stream](
+      const Trajectories::ConstSharedPtr msg, const rclcpp::MessageInfo & message_info) {
+      if (stream.pending_trajectories.size() >= lockstep_queue_size_) {
+        RCLCPP_WARN(
+          get_logger(), "Lockstep queue of %s is full, skipping the oldest candidates",
+          stream.topic_prefix.c_str());
+        skip_lockstep_cycle(*stream.pending_trajectories.front().first, stream);
+        stream.pending_trajectories.pop_front();
+      }
+      stream.pending_trajectories.emplace_back(msg, get_received_time_ns(message_info));
+      process_lockstep(stream);
+    },
+    subscription_options);
+  stream.odometry_sub = create_subscription<Odometry>(
+    stream.topic_prefix + "input/odometry", qos,
+    [this, &stream](const Odometry::ConstSharedPtr msg) {
+      stream.odometry_buffer.push(msg);
+      process_lockstep(stream);
+    },
+    subscription_options);
+  stream.acceleration_sub = create_subscription<AccelWithCovarianceStamped>(
+    stream.topic_prefix + "input/acceleration", qos,
+    [this, &stream](const AccelWithCovarianceStamped::ConstSharedPtr msg) {
+      stream.acceleration_buffer.push(msg);
+      process_lockstep(stream);
+    },
+    subscription_options);
+  stream.previous_trajectory_sub = create_subscription<Trajectory>(
+    stream.topic_prefix + "input/previous_trajectory", qos,
+    [this, &stream](const Trajectory::ConstSharedPtr msg) {
+      stream.previous_trajectory_buffer.push(msg);
+      process_lockstep(stream);
+    },
+    subscription_options);
 }
 
 void TrajectoryInterpolator::initialize_optimizers()
 {
-  if (initialized_optimizers_) {
+  // streams may reach their first cycle concurrently
+  std::call_once(initialize_optimizers_flag_, [this]() {
+    // NOTE: params_mutex_ is not held while building the chains, since declaring their parameters
+    // calls on_parameter() on this thread.
+    // the first chain declares the plugin parameters on this node, the helper nodes of the other
+    // chains are seeded with them
+    // a chain per stream and worker thread would multiply the smoothers and helper nodes by the
+    // number of streams, while the streams only ever use as many threads as the pool has
+    const auto num_stream_workers = std::max<size_t>(num_worker_threads_ / streams_.size(), 1);
+    std::vector<OptimizerWorkers> stream_workers;
+    for (size_t stream_index = 0; stream_index < streams_.size(); ++stream_index) {
+      const auto & stream = *streams_[stream_index];
+      stream_workers.push_back(create_workers(
+        stream.topic_prefix, stream_index == 0 ? "" : "_stream_" + std::to_string(stream_index),
+        num_stream_workers, stream.time_keeper));
+    }
+    auto service_workers = std::make_unique<OptimizerWorkers>(
+      create_workers("~/service/", "_service", num_worker_threads_, nullptr));
+    auto shadow_worker = shadow_runner_ptr_ ? create_shadow_worker() : nullptr;
+    {
+      std::lock_guard<std::mutex> lock(params_mutex_);
+      for (size_t stream_index = 0; stream_index < streams_.size(); ++stream_index) {
+        streams_[stream_index]->workers = std::move(stream_workers[stream_index]);
+      }
+      std::lock_guard<std::mutex> service_lock(service_workers_mutex_);
+      idle_service_workers_.push_back(service_workers.get());
+      num_service_worker_sets_ = 1;
+      service_workers_.push_back(std::move(service_workers));
+      shadow_worker_ptr_ = std::move(shadow_worker);
+    }
+    if (num_worker_threads_ > 1) {
+      worker_pool_ptr_ = std::make_unique<WorkerPool>(
+        num_worker_threads_, [this](const size_t) { configure_realtime_thread(); });
+    }
+  });
+}
+
+TrajectoryInterpolator::OptimizerWorkers TrajectoryInterpolator::create_workers(
+  const std::string & topic_prefix, const std::string & name_prefix, const size_t num_workers,
+  const std::shared_ptr<autoware_utils::TimeKeeper> & cycle_time_keeper)
+{
+  OptimizerWorkers workers;
+  for (size_t worker_id = 0; worker_id < num_workers; ++worker_id) {
+    workers.push_back(create_worker(topic_prefix, name_prefix, worker_id, cycle_time_keeper));
+  }
+  return workers;
+}
+
+std::unique_ptr<TrajectoryInterpolator::OptimizerWorker> TrajectoryInterpolator::create_worker(
+  const std::string & topic_prefix, const std::string & name_prefix, const size_t worker_id,
+  const std::shared_ptr<autoware_utils::TimeKeeper> & cycle_time_keeper)
+{
+  auto worker = std::make_unique<OptimizerWorker>();
+  {
+    std::lock_guard<std::mutex> lock(params_mutex_);
+    worker->params = params_;
+  }
+  const auto worker_name = "worker_" + std::to_string(worker_id);
+  rclcpp::Node * chain_node = this;
+  if (!name_prefix.empty() || worker_id > 0) {
+    worker->helper_node = create_helper_node(
+      name_prefix + "_" + worker_name, get_parameters(list_parameters({}, 0).names));
+    chain_node = worker->helper_node.get();
+  }
+  // a time keeper only nests the scopes of one thread, so the chains run by the worker threads
+  // record trees of their own; without the pool the chain runs on the thread of the cycle and is
+  // nested in its tree
+  worker->time_keeper = cycle_time_keeper;
+  if (!cycle_time_keeper) {
+    // never sampled, the plugins only hold on to it
+    worker->time_keeper = std::make_shared<autoware_utils::TimeKeeper>();
+  } else if (num_worker_threads_ > 1) {
+    // the first stream keeps the topics of a single-stream node
+    const auto debug_prefix = (name_prefix.empty() ? std::string("~/") : topic_prefix) + "debug/";
+    worker->time_keeper = std::make_shared<autoware_utils::TimeKeeper>(
+      create_publisher<autoware_utils::ProcessingTimeDetail>(
+        debug_prefix + worker_name + "/processing_time_detail_ms", 1));
+  }
+  worker->chain_ptr =
+    std::make_unique<TrajectoryOptimizerChain>(chain_node, worker->time_keeper, worker->params);
+  if (realtime_profile_ptr_->params().enable) {
+    worker->page_fault_monitor_ptr =
+      std::make_unique<PageFaultMonitor>(realtime_profile_ptr_->params().page_fault_warmup_cycles);
+  }
+  return worker;
+}
+
+rclcpp::Node::SharedPtr TrajectoryInterpolator::create_helper_node(
+  const std::string & name_suffix, const std::vector<rclcpp::Parameter> & parameters)
+{
+  rclcpp::NodeOptions helper_options;
+  helper_options.context(get_node_base_interface()->get_context())
+    .use_global_arguments(false)
+    .use_intra_process_comms(false)
+    .start_parameter_services(false)
+    .start_parameter_event_publisher(false)
+    .parameter_overrides(parameters);
+  return std::make_shared<rclcpp::Node>(
+    std::string(get_name()) + name_suffix, get_namespace(), helper_options);
+}
+
+void TrajectoryInterpolator::set_up_shadow()
+{
+  using autoware_utils::get_or_declare_parameter;
+
+  if (!get_or_declare_parameter<bool>(*this, "shadow.enable")) {
     return;
   }
-  // initialize optimizer pointers
-  eb_smoother_optimizer_ptr_ = std::make_shared<plugin::TrajectoryEBSmootherOptimizer>(
-    "eb_smoother_optimizer", this, time_keeper_, params_);
-  trajectory_extender_ptr_ = std::make_shared<plugin::TrajectoryExtender>(
-    "trajectory_extender", this, time_keeper_, params_);
-  trajectory_point_fixer_ptr_ = std::make_shared<plugin::TrajectoryPointFixer>(
-    "trajectory_point_fixer", this, time_keeper_, params_);
-  trajectory_spline_smoother_ptr_ = std::make_shared<plugin::TrajectorySplineSmoother>(
-    "trajectory_spline_smoother", this, time_keeper_, params_);
-  trajectory_velocity_optimizer_ptr_ = std::make_shared<plugin::TrajectoryVelocityOptimizer>(
-    "trajectory_velocity_optimizer", this, time_keeper_, params_);
-  initialized_optimizers_ = true;
+  shadow_sampler_.set_period(static_cast<size_t>(
+    std::max<int64_t>(get_or_declare_parameter<int64_t>(*this, "shadow.sample_period"), 0)));
+
+  // the overrides are only known from the node options, declaring them lets them be changed at
+  // runtime
+  std::vector<rclcpp::Parameter> parameters;
+  const std::string prefix(shadow_parameter_prefix);
+  for (const auto & [name, value] : get_node_parameters_interface()->get_parameter_overrides()) {
+    if (name.compare(0, prefix.size(), prefix) == 0) {
+      parameters.emplace_back(name, declare_parameter(name, value));
+    }
+  }
+  shadow_overrides_ = get_shadow_overrides(parameters);
+
+  shadow_runner_ptr_ = std::make_unique<ShadowRunner>([this]() {
+    for (const auto & error : apply_idle_priority_to_current_thread()) {
+      RCLCPP_WARN(
+        get_logger(), "Failed to lower the priority of the shadow chain: %s", error.c_str());
+    }
+  });
+}
+
+std::unique_ptr<TrajectoryInterpolator::OptimizerWorker>
+TrajectoryInterpolator::create_shadow_worker()
+{
+  auto worker = std::make_unique<OptimizerWorker>();
+  std::vector<rclcpp::Parameter> overrides;
+  {
+    std::lock_guard<std::mutex> lock(params_mutex_);
+    worker->params = params_;
+    overrides = shadow_overrides_;
+  }
+  update_optimizer_params(overrides, worker->params);
+
+  // the plugins read the overridden values from the helper node when they declare them
+  auto parameters = get_parameters(list_parameters({}, 0).names);
+  for (const auto & override_parameter : overrides) {
+    const auto it = std::find_if(parameters.begin(), parameters.end(), [&](const auto & parameter) {
+      return parameter.get_name() == override_parameter.get_name();
+    });
+    if (it != parameters.end()) {
+      *it = override_parameter;
+    } else {
+      parameters.push_back(override_parameter);
+    }
+  }
+  worker->helper_node = create_helper_node("_shadow", parameters);
+  // the shadow chain never records the processing time detail
+  worker->time_keeper = std::make_shared<autoware_utils::TimeKeeper>();
+  worker->chain_ptr = std::make_unique<TrajectoryOptimizerChain>(
+    worker->helper_node.get(), worker->time_keeper, worker->params);
+  return worker;
 }
 
-rcl_interfaces::msg::SetParametersResult TrajectoryInterpolator::on_parameter(
-  const std::vector<rclcpp::Parameter> & parameters)
+void TrajectoryInterpolator::update_optimizer_params(
+  const std::vector<rclcpp::Parameter> & parameters, TrajectoryOptimizerParams & params)
 {
   using autoware_utils::update_param;
-  auto params = params_;
 
   update_param<double>(parameters, "keep_last_trajectory_s", params.keep_last_trajectory_s);
   update_param<double>(parameters, "nearest_dist_threshold_m", params.nearest_dist_threshold_m);
@@ -109,25 +520,84 @@ rcl_interfaces::msg::SetParametersResult TrajectoryInterpolator::on_parameter(
   update_param<bool>(parameters, "publish_last_trajectory", params.publish_last_trajectory);
   update_param<bool>(parameters, "keep_last_trajectory", params.keep_last_trajectory);
   update_param<bool>(parameters, "extend_trajectory_backward", params.extend_trajectory_backward);
+}
 
+rcl_interfaces::msg::SetParametersResult TrajectoryInterpolator::on_parameter(
+  const std::vector<rclcpp::Parameter> & parameters)
+{
+  using autoware_utils::update_param;
+  std::lock_guard<std::mutex> params_lock(params_mutex_);
+  auto params = params_;
+  update_optimizer_params(parameters, params);
   params_ = params;
 
-  // call update_param for all optimizer plugins
-
-  if (eb_smoother_optimizer_ptr_) {
-    eb_smoother_optimizer_ptr_->on_parameter(parameters);
+  int64_t sample_period = 0;
+  if (update_param<int64_t>(parameters, "profiling.sample_period", sample_period)) {
+    timing_sampler_.set_period(static_cast<size_t>(std::max<int64_t>(sample_period, 0)));
   }
-  if (trajectory_extender_ptr_) {
-    trajectory_extender_ptr_->on_parameter(parameters);
+  bool profile_after_breach = profile_after_breach_;
+  if (update_param<bool>(parameters, "profiling.sample_after_breach", profile_after_breach)) {
+    profile_after_breach_ = profile_after_breach;
   }
-  if (trajectory_point_fixer_ptr_) {
-    trajectory_point_fixer_ptr_->on_parameter(parameters);
+  if (update_param<int64_t>(parameters, "shadow.sample_period", sample_period)) {
+    shadow_sampler_.set_period(static_cast<size_t>(std::max<int64_t>(sample_period, 0)));
+  }
+
+  // call update_param for all optimizer plugins, waiting for the cycles that are using them
+  const auto forward_to_worker =
+    [](OptimizerWorker & worker, const std::vector<rclcpp::Parameter> & worker_parameters) {
+      std::lock_guard<std::mutex> worker_lock(worker.mutex);
+      if (worker.helper_node) {
+        // plugins that re-read their settings from the node must see the update on the helper too
+        for (const auto & parameter : worker_parameters) {
+          if (worker.helper_node->has_parameter(parameter.get_name())) {
+            worker.helper_node->set_parameter(parameter);
+          }
+        }
+      }
+      worker.chain_ptr->on_parameter(worker_parameters);
+    };
+  for (auto & stream : streams_) {
+    for (auto & worker : stream->workers) {
+      forward_to_worker(*worker, parameters);
+    }
   }
-  if (trajectory_spline_smoother_ptr_) {
-    trajectory_spline_smoother_ptr_->on_parameter(parameters);
+  {
+    std::lock_guard<std::mutex> service_lock(service_workers_mutex_);
+    for (auto & workers : service_workers_) {
+      for (auto & worker : *workers) {
+        forward_to_worker(*worker, parameters);
+      }
+    }
   }
-  if (trajectory_velocity_optimizer_ptr_) {
-    trajectory_velocity_optimizer_ptr_->on_parameter(parameters);
+
+  if (shadow_runner_ptr_) {
+    const auto shadow_updates = get_shadow_overrides(parameters);
+    for (const auto & update : shadow_updates) {
+      const auto it = std::find_if(
+        shadow_overrides_.begin(), shadow_overrides_.end(),
+        [&](const auto & parameter) { return parameter.get_name() == update.get_name(); });
+      if (it != shadow_overrides_.end()) {
+        *it = update;
+      } else {
+        shadow_overrides_.push_back(update);
+      }
+    }
+    // the shadow chain follows the primary parameters it does not override
+    std::vector<rclcpp::Parameter> shadow_parameters = shadow_updates;
+    for (const auto & parameter : parameters) {
+      const bool is_overridden = std::any_of(
+        shadow_overrides_.begin(), shadow_overrides_.end(),
+        [&](const auto & override_parameter) {
+          return override_parameter.get_name() == parameter.get_name();
+        });
+      if (!is_overridden) {
+        shadow_parameters.push_back(parameter);
+      }
+    }
+    if (shadow_worker_ptr_ && !shadow_parameters.empty()) {
+      forward_to_worker(*shadow_worker_ptr_, shadow_parameters);
+    }
   }
 
   rcl_interfaces::msg::SetParametersResult result;
@@ -177,72 +647,903 @@ void TrajectoryInterpolator::set_up_params()
   params_.keep_last_trajectory = get_or_declare_parameter<bool>(*this, "keep_last_trajectory");
   params_.extend_trajectory_backward =
     get_or_declare_parameter<bool>(*this, "extend_trajectory_backward");
+
+  num_worker_threads_ = static_cast<size_t>(
+    std::max<int64_t>(get_or_declare_parameter<int64_t>(*this, "num_worker_threads"), 1));
+
+  if (get_or_declare_parameter<bool>(*this, "candidate_clustering.enable")) {
+    clustering_tolerance_m_ =
+      std::max(get_or_declare_parameter<double>(*this, "candidate_clustering.tolerance_m"), 0.0);
+  }
+
+  timing_sampler_.set_period(static_cast<size_t>(
+    std::max<int64_t>(get_or_declare_parameter<int64_t>(*this, "profiling.sample_period"), 0)));
+  profile_after_breach_ = get_or_declare_parameter<bool>(*this, "profiling.sample_after_breach");
 }
 
-void TrajectoryInterpolator::on_traj([[maybe_unused]] const Trajectories::ConstSharedPtr msg)
+void TrajectoryInterpolator::set_up_perf_counters()
 {
-  autoware_utils::ScopedTimeTrack st(__func__, *time_keeper_);
-  initialize_optimizers();
+  using autoware_utils::get_or_declare_parameter;
+
+  if (!get_or_declare_parameter<bool>(*this, "perf_counters.enable")) {
+    return;
+  }
+  // every thread opens its own counters, this only checks whether the kernel allows it at all
+  if (!PerfCounterGroup::for_current_thread().is_available()) {
+    RCLCPP_WARN(
+      get_logger(),
+      "Hardware performance counters are not available (see perf_event_paranoid), stage counters "
+      "are disabled");
+    return;
+  }
+  perf_counter_aggregator_ptr_ = std::make_unique<PerfCounterAggregator>();
+  params_.perf_counter_aggregator = perf_counter_aggregator_ptr_.get();
+  perf_counters_pub_ = create_publisher<PerfCounters>("~/debug/perf_counters", 1);
+}
+
+void TrajectoryInterpolator::set_up_cost_model()
+{
+  using autoware_utils::get_or_declare_parameter;
+
+  if (!get_or_declare_parameter<bool>(*this, "cost_model.enable")) {
+    return;
+  }
+  cost_model_ptr_ = std::make_unique<CandidateCostModel>(
+    get_or_declare_parameter<double>(*this, "cost_model.forgetting_factor"));
+}
+
+void TrajectoryInterpolator::publish_candidate_costs(
+  StreamContext & stream, const double makespan_ms)
+{
+  if (!stream.candidate_costs_pub) {
+    return;
+  }
+  const auto & schedule = stream.schedule;
+  const auto num_candidates = schedule.actual_ms.size();
+  CandidateCosts costs;
+  costs.stamp = now();
+  costs.cycle_id = stream.cycle_id;
+  costs.predicted_ms = schedule.predicted_ms;
+  costs.actual_ms = schedule.actual_ms;
+  costs.dispatch_rank.resize(num_candidates);
+  for (size_t rank = 0; rank < num_candidates; ++rank) {
+    // a single worker keeps the input order
+    const auto index = worker_pool_ptr_ ? schedule.order[rank] : rank;
+    costs.dispatch_rank[index] = static_cast<uint32_t>(rank);
+  }
+  costs.num_workers = static_cast<uint32_t>(stream.workers.size());
+  costs.makespan_ms = makespan_ms;
+  double total_ms = 0.0;
+  double longest_ms = 0.0;
+  for (const auto actual_ms : schedule.actual_ms) {
+    total_ms += actual_ms;
+    longest_ms = std::max(longest_ms, actual_ms);
+  }
+  costs.makespan_lower_bound_ms = std::max(longest_ms, total_ms / costs.num_workers);
+  stream.candidate_costs_pub->publish(costs);
+}
+
+void TrajectoryInterpolator::publish_perf_counters()
+{
+  if (!perf_counter_aggregator_ptr_) {
+    return;
+  }
+  PerfCounters perf_counters;
+  perf_counters.stamp = now();
+  for (const auto & [stage, totals] : perf_counter_aggregator_ptr_->take()) {
+    StagePerfCounters stage_counters;
+    stage_counters.stage = stage;
+    stage_counters.calls = totals.calls;
+    stage_counters.scaled_calls = totals.scaled_calls;
+    stage_counters.unmeasured_calls = totals.unmeasured_calls;
+    stage_counters.cycles = totals.values.cycles;
+    stage_counters.instructions = totals.values.instructions;
+    stage_counters.cache_misses = totals.values.cache_misses;
+    stage_counters.branch_misses = totals.values.branch_misses;
+    perf_counters.stages.push_back(stage_counters);
+  }
+  perf_counters_pub_->publish(perf_counters);
+}
+
+void TrajectoryInterpolator::set_up_slow_cycle_capture()
+{
+  using autoware_utils::get_or_declare_parameter;
+
+  if (!get_or_declare_parameter<bool>(*this, "slow_cycle_capture.enable")) {
+    return;
+  }
+  CycleCaptureParams capture_params;
+  capture_params.threshold_ms =
+    get_or_declare_parameter<double>(*this, "slow_cycle_capture.threshold_ms");
+  capture_params.directory =
+    get_or_declare_parameter<std::string>(*this, "slow_cycle_capture.directory");
+  capture_params.min_interval_s =
+    get_or_declare_parameter<double>(*this, "slow_cycle_capture.min_interval_s");
+  capture_params.max_captures = static_cast<size_t>(std::max<int64_t>(
+    get_or_declare_parameter<int64_t>(*this, "slow_cycle_capture.max_captures"), 0));
+  slow_cycle_recorder_ptr_ =
+    std::make_unique<SlowCycleRecorder>(capture_params, get_fully_qualified_name(), get_logger());
+}
+
+void TrajectoryInterpolator::capture_slow_cycle(
+  StreamContext & stream, const double processing_time_ms, const Trajectories & trajectories,
+  const Odometry & current_odometry, const AccelWithCovarianceStamped & current_acceleration,
+  const Trajectory::ConstSharedPtr previous_trajectory_ptr, const rclcpp::Time & cycle_time)
+{
+  // taken on every cycle so that a capture only holds the stage times of its own cycle
+  auto stage_timings = stream.stage_timings_ptr->take();
+  if (!slow_cycle_recorder_ptr_->should_capture(
+        processing_time_ms, std::chrono::steady_clock::now())) {
+    return;
+  }
+
+  // the copies are only made for the rare captured cycles, the files are written on another thread
+  CycleCapture capture;
+  // "~/" is resolved against the node name, so that the bag can be played back to the node
+  capture.topic_prefix = std::string(get_fully_qualified_name()) + stream.topic_prefix.substr(1);
+  capture.cycle_id = stream.cycle_id;
+  capture.stamp = cycle_time;
+  capture.processing_time_ms = processing_time_ms;
+  capture.trajectories = trajectories;
+  if (stream.serialized_input_ptr) {
+    capture.serialized_trajectories = *stream.serialized_input_ptr;
+  }
+  capture.odometry = current_odometry;
+  capture.acceleration = current_acceleration;
+  if (previous_trajectory_ptr) {
+    capture.previous_trajectory = *previous_trajectory_ptr;
+  }
+  capture.ego_history_points = stream.cycle_params.ego_history_points;
+  capture.parameters = get_parameters(
+    list_parameters({}, rcl_interfaces::srv::ListParameters::Request::DEPTH_RECURSIVE).names);
+  capture.stage_timings = std::move(stage_timings);
+  slow_cycle_recorder_ptr_->record(std::move(capture));
+}
+
+void TrajectoryInterpolator::set_up_realtime_profile()
+{
+  using autoware_utils::get_or_declare_parameter;
+
+  RealtimeProfileParams realtime_params;
+  realtime_params.enable = get_or_declare_parameter<bool>(*this, "realtime_profile.enable");
+  realtime_params.cpu_affinity_mask =
+    get_or_declare_parameter<int64_t>(*this, "realtime_profile.cpu_affinity_mask");
+  realtime_params.sched_priority =
+    get_or_declare_parameter<int64_t>(*this, "realtime_profile.sched_priority");
+  realtime_params.lock_memory =
+    get_or_declare_parameter<bool>(*this, "realtime_profile.lock_memory");
+  realtime_params.prefault_stack_size_kb =
+    get_or_declare_parameter<int64_t>(*this, "realtime_profile.prefault_stack_size_kb");
+  realtime_params.prefault_trajectory_slots =
+    get_or_declare_parameter<int64_t>(*this, "realtime_profile.prefault_trajectory_slots");
+  realtime_params.prefault_trajectory_points =
+    get_or_declare_parameter<int64_t>(*this, "realtime_profile.prefault_trajectory_points");
+  realtime_params.page_fault_warmup_cycles =
+    get_or_declare_parameter<int64_t>(*this, "realtime_profile.page_fault_warmup_cycles");
+
+  realtime_profile_ptr_ = std::make_unique<RealtimeProfile>(realtime_params);
+  if (!realtime_params.enable) {
+    return;
+  }
+  for (const auto & error : realtime_profile_ptr_->apply_to_process()) {
+    RCLCPP_ERROR(get_logger(), "Failed to apply real-time profile: %s", error.c_str());
+  }
+}
+
+void TrajectoryInterpolator::start_stream_executors()
+{
+  if (!realtime_profile_ptr_->params().enable) {
+    return;
+  }
+  // the threads of the executor the node is added to also run the callbacks of other nodes of the
+  // process, so they are never given the real-time profile
+  for (const auto & stream : streams_) {
+    auto executor = std::make_shared<rclcpp::executors::SingleThreadedExecutor>();
+    executor->add_callback_group(stream->callback_group, get_node_base_interface());
+    stream_executor_threads_.emplace_back([this, executor]() {
+      configure_realtime_thread();
+      executor->spin();
+    });
+    stream_executors_.push_back(std::move(executor));
+  }
+}
+
+void TrajectoryInterpolator::configure_realtime_thread()
+{
+  // stream executor and pool threads can only be configured from inside them, once each
+  if (!realtime_profile_ptr_->params().enable) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(realtime_threads_mutex_);
+    if (!realtime_threads_.insert(std::this_thread::get_id()).second) {
+      return;
+    }
+  }
+  for (const auto & error : realtime_profile_ptr_->apply_to_current_thread()) {
+    RCLCPP_ERROR(get_logger(), "Failed to apply real-time profile: %s", error.c_str());
+  }
+}
+
+void TrajectoryInterpolator::report_page_faults(
+  const PageFaults & page_faults, const std::string & context)
+{
+  if (page_faults.minor > 0 || page_faults.major > 0) {
+    RCLCPP_WARN_THROTTLE(
+      get_logger(), *get_clock(), 1000,
+      "Page faults in steady-state cycle of %s: %" PRId64 " minor, %" PRId64 " major",
+      context.c_str(), page_faults.minor, page_faults.major);
+  }
+}
+
+double TrajectoryInterpolator::optimize_candidate(
+  NewTrajectory & trajectory, const TrajectoryOptimizerParams & cycle_params,
+  OptimizerWorker & worker, const CandidateFeatures * features, const uint64_t batch_id)
+{
+  std::lock_guard<std::mutex> lock(worker.mutex);
+  // nested in the tree of the cycle, or of the worker thread, on sampled cycles only
+  std::optional<autoware_utils::ScopedTimeTrack> st;
+  if (cycle_params.detailed_timing) {
+    st.emplace(__func__, *worker.time_keeper);
+  }
+  const ScopedPageFaultCycle page_fault_cycle(
+    worker.page_fault_monitor_ptr.get(), [this](const PageFaults & page_faults) {
+      report_page_faults(page_faults, "optimizer worker");
+    });
+
+  if (features && worker.params_batch_id != batch_id) {
+    // the stage times of this candidate alone, forwarded to the stream's timings afterwards; the
+    // copy is made once per worker and batch, and reuses the buffers of the previous one
+    worker.params = cycle_params;
+    worker.params.stage_timings = &worker.candidate_stage_timings;
+    worker.params_batch_id = batch_id;
+  }
+  // apply optimizers
+  const auto start = std::chrono::steady_clock::now();
+  worker.chain_ptr->optimize_trajectory(trajectory.points, features ? worker.params : cycle_params);
+  const auto elapsed_ms =
+    std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+  if (features) {
+    worker.candidate_stage_timings.take_each(
+      [&](const std::string_view stage, const StageTimings::StageTime & time) {
+        cost_model_ptr_->update(stage, *features, time.total_ms);
+        if (cycle_params.stage_timings) {
+          cycle_params.stage_timings->add(stage, time);
+        }
+      });
+  }
+  return elapsed_ms;
+}
 
-  auto create_output_trajectory_from_past = [&]() {
-    NewTrajectory previous_trajectory;
-    previous_trajectory.points = previous_trajectory_ptr_->points;
-    previous_trajectory.header = previous_trajectory_ptr_->header;
-    previous_trajectory.header.stamp = now();
-    previous_trajectory.generator_id = msg->trajectories.front().generator_id;
-    previous_trajectory.score = 1.0;
-    motion_utils::calculate_time_from_start(
-      previous_trajectory.points, current_odometry_ptr_->pose.pose.position);
-    return previous_trajectory;
+void TrajectoryInterpolator::optimize_candidates(
+  Trajectories & trajectories, const TrajectoryOptimizerParams & cycle_params,
+  OptimizerWorkers & workers, CandidateSchedule & schedule, CandidateClusters & clusters,
+  const std::function<void(size_t)> & on_candidate_optimized)
+{
+  auto & candidates = trajectories.trajectories;
+  if (cost_model_ptr_) {
+    cost_model_ptr_->schedule(candidates, schedule);
+  }
+  const auto batch_id = ++num_candidate_batches_;
+  if (clustering_tolerance_m_) {
+    cluster_candidates(candidates, *clustering_tolerance_m_, clusters);
+  } else {
+    clusters.representative_of.clear();
+    clusters.num_clusters = 0;
+  }
+  const auto run_chain = [&](const size_t index, OptimizerWorker & worker) {
+    if (cost_model_ptr_) {
+      schedule.actual_ms[index] =
+        optimize_candidate(
+          candidates[index], cycle_params, worker, &schedule.features[index], batch_id);
+    } else {
+      optimize_candidate(candidates[index], cycle_params, worker);
+    }
+    if (on_candidate_optimized) {
+      on_candidate_optimized(index);
+    }
   };
-  previous_trajectory_ptr_ = sub_previous_trajectory_.take_data();
-  current_odometry_ptr_ = sub_current_odometry_.take_data();
-  current_acceleration_ptr_ = sub_current_acceleration_.take_data();
-  params_.current_odometry = *current_odometry_ptr_;
-  params_.current_acceleration = *current_acceleration_ptr_;
-
-  const auto keep_last_trajectory_s = params_.keep_last_trajectory_s;
-  const auto keep_last_trajectory = params_.keep_last_trajectory;
-
-  if (previous_trajectory_ptr_ && keep_last_trajectory) {
-    auto current_time = now();
-    auto time_diff = (rclcpp::Time(current_time) - *last_time_).seconds();
-    if (time_diff < keep_last_trajectory_s) {
-      Trajectories output_trajectories = *msg;
-      output_trajectories.trajectories.clear();
-      output_trajectories.trajectories.push_back(create_output_trajectory_from_past());
-      trajectories_pub_->publish(output_trajectories);
+  const auto optimize = [&](const size_t index, OptimizerWorker & worker) {
+    if (!clustering_tolerance_m_) {
+      run_chain(index, worker);
       return;
     }
+    // members come after their representative and are handled by the same worker
+    if (!clusters.is_representative(index)) {
+      return;
+    }
+    run_chain(index, worker);
+    for (size_t member = index + 1; member < candidates.size(); ++member) {
+      if (clusters.representative_of[member] != index) {
+        continue;
+      }
+      // a representative rejected by the chain leaves nothing to project onto
+      if (candidates[index].points.size() < 2) {
+        run_chain(member, worker);
+        continue;
+      }
+      const auto start = std::chrono::steady_clock::now();
+      project_cluster_member(candidates[index], candidates[member], cycle_params, worker);
+      if (cost_model_ptr_) {
+        schedule.actual_ms[member] =
+          std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+            .count();
+      }
+      if (on_candidate_optimized) {
+        on_candidate_optimized(member);
+      }
+    }
+  };
+  if (worker_pool_ptr_) {
+    // one task per chain, taking candidates until none is left, so that a sampled cycle records
+    // one tree per chain rather than one per candidate; the chains of several streams share the
+    // threads of the pool
+    std::atomic<size_t> next_task_index{0};
+    worker_pool_ptr_->parallel_for(workers.size(), [&](const size_t lane, const size_t) {
+      auto & worker = *workers[lane];
+      std::optional<autoware_utils::ScopedTimeTrack> st;
+      if (cycle_params.detailed_timing) {
+        st.emplace(__func__, *worker.time_keeper);
+      }
+      // idle workers take the next task, so the short candidates fill in at the end
+      for (auto task_index = next_task_index++; task_index < candidates.size();
+           task_index = next_task_index++) {
+        optimize(cost_model_ptr_ ? schedule.order[task_index] : task_index, worker);
+      }
+    });
+    return;
+  }
+  for (size_t i = 0; i < candidates.size(); ++i) {
+    optimize(i, *workers.front());
+  }
+}
+
+void TrajectoryInterpolator::project_cluster_member(
+  const NewTrajectory & representative, NewTrajectory & member,
+  const TrajectoryOptimizerParams & cycle_params, OptimizerWorker & worker)
+{
+  project_onto_representative(representative.points, member.points);
+
+  // the clamps of TrajectoryVelocityOptimizer, in one pass
+  const auto current_speed = cycle_params.current_odometry.twist.twist.linear.x;
+  const auto initial_motion = utils::get_initial_motion(cycle_params);
+  constexpr auto infinity = std::numeric_limits<float>::infinity();
+  const bool set_engage_speed =
+    cycle_params.set_engage_speed && (current_speed < cycle_params.target_pull_out_speed_mps);
+  if (set_engage_speed || cycle_params.limit_speed) {
+    utils::fixed_size::clamp_velocities(
+      member.points, set_engage_speed ? static_cast<float>(initial_motion.speed_mps) : -infinity,
+      set_engage_speed ? static_cast<float>(initial_motion.acc_mps2) : -infinity,
+      cycle_params.limit_speed ? static_cast<float>(cycle_params.max_speed_mps) : infinity);
+  }
+  if (cycle_params.smooth_velocities) {
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    smooth_velocity(*worker.chain_ptr, member.points, cycle_params);
+  }
+  // the times of the representative follow its own velocities
+  motion_utils::calculate_time_from_start(
+    member.points, cycle_params.current_odometry.pose.pose.position);
+}
+
+void TrajectoryInterpolator::offer_shadow_cycle(
+  StreamContext & stream, const Trajectories & input, const Trajectories & primary_output,
+  const size_t num_candidates, const TrajectoryOptimizerParams & cycle_params,
+  const double primary_processing_time_ms)
+{
+  if (
+    !shadow_runner_ptr_ || !shadow_sampler_.sample_cycle() || !shadow_runner_ptr_->try_reserve()) {
+    return;
+  }
+
+  // copied, since the stream reuses the input and output buffers in its next cycle
+  auto shadow_params = cycle_params;
+  {
+    std::lock_guard<std::mutex> lock(params_mutex_);
+    update_optimizer_params(shadow_overrides_, shadow_params);
+  }
+  // the shadow chain does not add to the measurements of the primary chain
+  shadow_params.stage_timings = nullptr;
+  shadow_params.perf_counter_aggregator = nullptr;
+  shadow_params.detailed_timing = false;
+  std::vector<TrajectoryPoints> primary_points;
+  primary_points.reserve(num_candidates);
+  for (size_t i = 0; i < num_candidates; ++i) {
+    primary_points.push_back(primary_output.trajectories[i].points);
+  }
+
+  shadow_runner_ptr_->submit([this, &stream, cycle_id = stream.cycle_id,
+                              candidates = input.trajectories,
+                              representative_of = stream.clusters.representative_of,
+                              primary_points = std::move(primary_points),
+                              shadow_params = std::move(shadow_params),
+                              primary_processing_time_ms]() mutable {
+    const auto start = std::chrono::steady_clock::now();
+    try {
+      // with the clustering of the primary chain, so that only the chain configurations differ
+      for (size_t i = 0; i < candidates.size(); ++i) {
+        const auto representative = i < representative_of.size() ? representative_of[i] : i;
+        if (representative == i || candidates[representative].points.size() < 2) {
+          optimize_candidate(candidates[i], shadow_params, *shadow_worker_ptr_);
+        } else {
+          project_cluster_member(
+            candidates[representative], candidates[i], shadow_params, *shadow_worker_ptr_);
+        }
+      }
+    } catch (const std::exception & e) {
+      RCLCPP_WARN_THROTTLE(
+        get_logger(), *get_clock(), 5000, "Shadow chain failed on %s: %s",
+        stream.topic_prefix.c_str(), e.what());
+      return;
+    }
+
+    ShadowMetrics metrics;
+    metrics.cycle_id = cycle_id;
+    metrics.primary_processing_time_ms = primary_processing_time_ms;
+    metrics.shadow_processing_time_ms =
+      std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    metrics.max_position_deviation_m = std::numeric_limits<double>::quiet_NaN();
+    metrics.mean_position_deviation_m = std::numeric_limits<double>::quiet_NaN();
+    metrics.max_velocity_difference_mps = std::numeric_limits<double>::quiet_NaN();
+    metrics.max_length_difference_m = std::numeric_limits<double>::quiet_NaN();
+    for (size_t i = 0; i < primary_points.size() && i < candidates.size(); ++i) {
+      add_to_metrics(compare_outputs(primary_points[i], candidates[i].points), metrics);
+    }
+    metrics.num_skipped_cycles = shadow_runner_ptr_->take_num_skipped();
+    metrics.stamp = now();
+    stream.shadow_metrics_pub->publish(metrics);
+  });
+}
+
+void TrajectoryInterpolator::publish_candidate(
+  StreamContext & stream, const size_t index, const size_t total, const NewTrajectory & trajectory)
+{
+  if (!stream.candidate_pub) {
+    return;
+  }
+  // called from the worker threads, publishers are thread-safe
+  auto candidate = std::make_unique<OptimizedCandidate>();
+  candidate->cycle_id = stream.cycle_id;
+  candidate->index = static_cast<uint32_t>(index);
+  candidate->total = static_cast<uint32_t>(total);
+  candidate->trajectory = trajectory;
+  stream.candidate_pub->publish(std::move(candidate));
+}
+
+NewTrajectory TrajectoryInterpolator::create_output_trajectory_from_past(
+  const Trajectory & previous_trajectory, const Trajectories & input,
+  const Odometry & current_odometry, const rclcpp::Time & stamp) const
+{
+  NewTrajectory output_trajectory;
+  output_trajectory.points = previous_trajectory.points;
+  output_trajectory.header = previous_trajectory.header;
+  output_trajectory.header.stamp = stamp;
+  if (!input.trajectories.empty()) {
+    output_trajectory.generator_id = input.trajectories.front().generator_id;
+  }
+  output_trajectory.score = 1.0;
+  motion_utils::calculate_time_from_start(
+    output_trajectory.points, current_odometry.pose.pose.position);
+  return output_trajectory;
+}
+
+void TrajectoryInterpolator::on_optimize_trajectories(
+  const OptimizeTrajectories::Request::SharedPtr request,
+  OptimizeTrajectories::Response::SharedPtr response)
+{
+  initialize_optimizers();
+
+  // every input comes with the request, and each request in flight runs on chains of its own; the
+  // requests stay out of the sampled timing and perf counters of the streams
+  TrajectoryOptimizerParams cycle_params;
+  {
+    std::lock_guard<std::mutex> lock(params_mutex_);
+    cycle_params = params_;
+  }
+  cycle_params.detailed_timing = false;
+  cycle_params.perf_counter_aggregator = nullptr;
+  cycle_params.stage_timings = nullptr;
+  cycle_params.current_odometry = request->odometry;
+  cycle_params.current_acceleration = request->acceleration;
+  cycle_params.ego_history_points = request->ego_history_points;
+
+  response->trajectories = request->trajectories;
+  auto & workers = acquire_service_workers();
+  try {
+    CandidateSchedule schedule;
+    CandidateClusters clusters;
+    optimize_candidates(response->trajectories, cycle_params, workers, schedule, clusters);
+    response->success = true;
+  } catch (const std::exception & e) {
+    response->trajectories.trajectories.clear();
+    response->success = false;
+    response->message = e.what();
+  }
+  release_service_workers(workers);
+  if (!response->success) {
+    return;
+  }
+
+  if (!request->previous_trajectory.points.empty() && cycle_params.publish_last_trajectory) {
+    response->trajectories.trajectories.push_back(create_output_trajectory_from_past(
+      request->previous_trajectory, request->trajectories, request->odometry, now()));
+  }
+  response->message = "success";
+}
+
+TrajectoryInterpolator::OptimizerWorkers & TrajectoryInterpolator::acquire_service_workers()
+{
+  size_t set_index = 0;
+  {
+    std::lock_guard<std::mutex> lock(service_workers_mutex_);
+    if (!idle_service_workers_.empty()) {
+      auto & workers = *idle_service_workers_.back();
+      idle_service_workers_.pop_back();
+      return workers;
+    }
+    set_index = num_service_worker_sets_++;
+  }
+  // built without the locks, like the first set in initialize_optimizers()
+  auto workers = std::make_unique<OptimizerWorkers>(create_workers(
+    "~/service/", "_service_" + std::to_string(set_index), num_worker_threads_, nullptr));
+  auto & acquired = *workers;
+  std::lock_guard<std::mutex> params_lock(params_mutex_);
+  std::lock_guard<std::mutex> lock(service_workers_mutex_);
+  service_workers_.push_back(std::move(workers));
+  return acquired;
+}
+
+void TrajectoryInterpolator::release_service_workers(OptimizerWorkers & workers)
+{
+  std::lock_guard<std::mutex> lock(service_workers_mutex_);
+  idle_service_workers_.push_back(&workers);
+}
+
+void TrajectoryInterpolator::on_traj(
+  const Trajectories::ConstSharedPtr msg, StreamContext & stream)
+{
+  run_cycle(
+    msg, stream, now(), stream.sub_current_odometry->take_data(),
+    stream.sub_current_acceleration->take_data(), stream.sub_previous_trajectory->take_data());
+}
+
+void TrajectoryInterpolator::on_serialized_traj(
+  const rclcpp::SerializedMessage & serialized_msg, StreamContext & stream)
+{
+  if (!decode_selected_candidates(serialized_msg, stream)) {
+    RCLCPP_WARN_THROTTLE(
+      get_logger(), *get_clock(), 5000,
+      "Unsupported trajectories encoding on %s, deserializing the whole message",
+      stream.topic_prefix.c_str());
+    deserialize_selected_candidates(serialized_msg, stream);
+  }
+  // only read by a slow cycle capture, while the message is alive
+  stream.serialized_input_ptr = &serialized_msg;
+  on_traj(stream.decoded_trajectories_ptr, stream);
+  stream.serialized_input_ptr = nullptr;
+}
+
+bool TrajectoryInterpolator::decode_selected_candidates(
+  const rclcpp::SerializedMessage & serialized_msg, StreamContext & stream)
+{
+  auto & view = stream.trajectories_view;
+  auto & decoded = *stream.decoded_trajectories_ptr;
+  if (!view.parse(serialized_msg) || !view.decode_generator_info(decoded.generator_info)) {
+    return false;
+  }
+
+  const auto & candidates = view.candidates();
+  std::vector<double> scores(candidates.size());
+  std::vector<uint64_t> hashes(deduplicate_candidates_ ? candidates.size() : 0);
+  for (size_t i = 0; i < candidates.size(); ++i) {
+    scores[i] = candidates[i].score;
+    if (deduplicate_candidates_) {
+      hashes[i] = view.hash_points(i);
+    }
+  }
+  const auto selected = select_candidates(scores, hashes, max_selected_candidates_);
+
+  // resize() keeps the point buffers of the slots that survive from the previous message
+  decoded.trajectories.resize(selected.size());
+  for (size_t i = 0; i < selected.size(); ++i) {
+    const auto & candidate = candidates[selected[i]];
+    auto & trajectory = decoded.trajectories[i];
+    trajectory.header = candidate.header;
+    trajectory.generator_id = candidate.generator_id;
+    trajectory.score = candidate.score;
+    view.decode_points(selected[i], trajectory.points);
+  }
+  return true;
+}
+
+void TrajectoryInterpolator::deserialize_selected_candidates(
+  const rclcpp::SerializedMessage & serialized_msg, StreamContext & stream)
+{
+  auto & decoded = *stream.decoded_trajectories_ptr;
+  rclcpp::Serialization<Trajectories>().deserialize_message(&serialized_msg, &decoded);
+
+  std::vector<double> scores;
+  std::vector<uint64_t> hashes;
+  for (const auto & trajectory : decoded.trajectories) {
+    scores.push_back(trajectory.score);
+    if (deduplicate_candidates_) {
+      hashes.push_back(hash_points(trajectory.points));
+    }
   }
-  last_time_ = std::make_shared<rclcpp::Time>(now());
+  const auto selected = select_candidates(scores, hashes, max_selected_candidates_);
+  for (size_t i = 0; i < selected.size(); ++i) {
+    if (selected[i] != i) {
+      decoded.trajectories[i] = std::move(decoded.trajectories[selected[i]]);
+    }
+  }
+  decoded.trajectories.resize(selected.size());
+}
 
-  if (!current_odometry_ptr_ || !current_acceleration_ptr_) {
-    RCLCPP_ERROR(get_logger(), "No odometry or acceleration data");
+void TrajectoryInterpolator::publish_output(
+  const Trajectories & output_trajectories, StreamContext & stream)
+{
+  if (!stream.bounded_trajectories_pub) {
+    stream.trajectories_pub->publish(output_trajectories);
     return;
   }
 
-  if (params_.extend_trajectory_backward) {
+  bool complete = true;
+  if (stream.bounded_trajectories_pub->can_loan_messages()) {
+    // written in place in middleware memory, e.g. shared memory, so the message is never copied
+    auto loaned_msg = stream.bounded_trajectories_pub->borrow_loaned_message();
+    complete = to_bounded(output_trajectories, loaned_msg.get());
+    stream.bounded_trajectories_pub->publish(std::move(loaned_msg));
+  } else {
+    auto & bounded_msg = *stream.bounded_output_ptr;
+    complete = to_bounded(output_trajectories, bounded_msg);
+    stream.bounded_trajectories_pub->publish(bounded_msg);
+  }
+  if (!complete) {
+    RCLCPP_WARN_THROTTLE(
+      get_logger(), *get_clock(), 5000,
+      "Output of %s exceeds the bounded message capacity and was truncated",
+      stream.topic_prefix.c_str());
+  }
+}
+
+void TrajectoryInterpolator::process_lockstep(StreamContext & stream)
+{
+  // candidates are processed strictly in arrival order, each one once the inputs at its stamp can
+  // no longer change; every one of them gets an output, possibly empty, so that the output
+  // sequence stays aligned with the input
+  while (!stream.pending_trajectories.empty()) {
+    const auto [msg, received_ns] = stream.pending_trajectories.front();
+    if (msg->trajectories.empty()) {
+      // nothing to synchronize to
+      stream.pending_trajectories.pop_front();
+      publish_empty_output(*msg, stream);
+      continue;
+    }
+
+    // on the node clock, since it is compared with stream.last_time
+    const rclcpp::Time cycle_time(
+      msg->trajectories.front().header.stamp, get_clock()->get_clock_type());
+    const auto stamp = cycle_time.nanoseconds();
+    if (stream.last_lockstep_stamp && stamp < *stream.last_lockstep_stamp) {
+      RCLCPP_WARN(
+        get_logger(), "Skipping candidates older than the last processed ones on %s",
+        stream.topic_prefix.c_str());
+      stream.pending_trajectories.pop_front();
+      skip_lockstep_cycle(*msg, stream);
+      continue;
+    }
+    if (
+      !stream.odometry_buffer.is_complete(stamp) ||
+      !stream.acceleration_buffer.is_complete(stamp)) {
+      break;
+    }
+    // the previous trajectory is the downstream output of the last processed candidates, which
+    // is stamped at or after them
+    bool uses_previous_trajectory = false;
+    {
+      std::lock_guard<std::mutex> lock(params_mutex_);
+      uses_previous_trajectory = params_.publish_last_trajectory || params_.keep_last_trajectory;
+    }
+    if (
+      uses_previous_trajectory && stream.last_lockstep_stamp &&
+      !stream.previous_trajectory_buffer.is_complete(*stream.last_lockstep_stamp)) {
+      break;
+    }
+
+    stream.pending_trajectories.pop_front();
+    const auto odometry = stream.odometry_buffer.find_latest_at(stamp);
+    const auto acceleration = stream.acceleration_buffer.find_latest_at(stamp);
+    if (!odometry || !acceleration) {
+      // stamped before the oldest input, e.g. the first candidates of a recording; the candidates
+      // are not processed, so the previous trajectory still answers the last processed ones
+      RCLCPP_WARN(
+        get_logger(), "No odometry or acceleration at the stamp of the candidates on %s, skipping",
+        stream.topic_prefix.c_str());
+      skip_lockstep_cycle(*msg, stream);
+      continue;
+    }
+    if (!stream.last_lockstep_stamp) {
+      // the keep_last_trajectory hold compares stamps, the wall time set at startup would hold the
+      // last trajectory for as long as the stamps stay behind it, e.g. when replaying a recording
+      stream.last_time = cycle_time;
+    }
+    stream.last_lockstep_stamp = stamp;
+    // the queueing delay includes the wait for the inputs
+    stream.input_received_ns = received_ns;
+    run_cycle(
+      msg, stream, cycle_time, odometry, acceleration,
+      stream.previous_trajectory_buffer.find_latest_at(stamp));
+    // later candidates are stamped at or after these ones
+    stream.odometry_buffer.discard_before(stamp);
+    stream.acceleration_buffer.discard_before(stamp);
+    stream.previous_trajectory_buffer.discard_before(stamp);
+  }
+  if (stream.pending_trajectories.empty()) {
+    // no candidate waits for the inputs, which are only bounded until the next ones arrive; those
+    // stamped before the oldest input left are skipped
+    stream.odometry_buffer.discard_oldest(lockstep_queue_size_);
+    stream.acceleration_buffer.discard_oldest(lockstep_queue_size_);
+    stream.previous_trajectory_buffer.discard_oldest(lockstep_queue_size_);
+  }
+}
+
+void TrajectoryInterpolator::skip_lockstep_cycle(const Trajectories & input, StreamContext & stream)
+{
+  ++stream.num_skipped_cycles;
+  publish_empty_output(input, stream);
+}
+
+void TrajectoryInterpolator::publish_empty_output(
+  const Trajectories & input, StreamContext & stream)
+{
+  Trajectories output_trajectories;
+  output_trajectories.generator_info = input.generator_info;
+  publish_output(output_trajectories, stream);
+}
+
+void TrajectoryInterpolator::run_cycle(
+  const Trajectories::ConstSharedPtr msg, StreamContext & stream, const rclcpp::Time & cycle_time,
+  const Odometry::ConstSharedPtr current_odometry_ptr,
+  const AccelWithCovarianceStamped::ConstSharedPtr current_acceleration_ptr,
+  const Trajectory::ConstSharedPtr previous_trajectory_ptr)
+{
+  const auto cycle_start = std::chrono::steady_clock::now();
+  const auto callback_time = now();
+  const auto callback_system_ns =
+    std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::system_clock::now().time_since_epoch())
+      .count();
+  // ended on every return below, including the early ones
+  const ScopedPageFaultCycle page_fault_cycle(
+    stream.page_fault_monitor_ptr.get(), [this, &stream](const PageFaults & page_faults) {
+      report_page_faults(page_faults, stream.topic_prefix);
+    });
+  initialize_optimizers();
+
+  if (!current_odometry_ptr || !current_acceleration_ptr) {
+    RCLCPP_ERROR(
+      get_logger(), "No odometry or acceleration data on %s", stream.topic_prefix.c_str());
+    return;
+  }
+
+  ++stream.cycle_id;
+  auto & cycle_params = stream.cycle_params;
+  {
+    std::lock_guard<std::mutex> lock(params_mutex_);
+    cycle_params = params_;
+  }
+  cycle_params.current_odometry = *current_odometry_ptr;
+  cycle_params.current_acceleration = *current_acceleration_ptr;
+  cycle_params.stage_timings = stream.stage_timings_ptr.get();
+  cycle_params.detailed_timing = timing_sampler_.sample_cycle();
+  // one tree per sampled cycle, in which the candidates optimized on this thread are nested
+  std::optional<autoware_utils::ScopedTimeTrack> st;
+  if (cycle_params.detailed_timing) {
+    st.emplace(__func__, *stream.time_keeper);
+  }
+
+  auto publish_processing_time = [&]() {
+    Float64Stamped processing_time;
+    processing_time.stamp = now();
+    processing_time.data =
+      std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - cycle_start)
+        .count();
+    stream.processing_time_pub->publish(processing_time);
+    return processing_time.data;
+  };
+
+  const auto input_stamp = msg->trajectories.empty() ? builtin_interfaces::msg::Time{}
+                                                      : msg->trajectories.front().header.stamp;
+  CycleMetrics metrics;
+  metrics.cycle_id = stream.cycle_id;
+  metrics.input_age_ms = get_age_ms(callback_time, input_stamp);
+  metrics.odometry_age_ms = get_age_ms(callback_time, current_odometry_ptr->header.stamp);
+  metrics.acceleration_age_ms = get_age_ms(callback_time, current_acceleration_ptr->header.stamp);
+  metrics.queueing_delay_ms =
+    stream.input_received_ns
+      ? static_cast<double>(callback_system_ns - *stream.input_received_ns) * 1e-6
+      : std::numeric_limits<double>::quiet_NaN();
+  auto publish_cycle_metrics = [&](const size_t num_candidates, const double processing_time_ms) {
+    metrics.stamp = now();
+    metrics.num_skipped_cycles = std::exchange(stream.num_skipped_cycles, 0);
+    metrics.num_candidates = static_cast<uint32_t>(num_candidates);
+    metrics.processing_time_ms = processing_time_ms;
+    metrics.output_age_ms = get_age_ms(metrics.stamp, input_stamp);
+    stream.throughput_meter.add(std::chrono::steady_clock::now(), num_candidates);
+    metrics.cycles_per_second = stream.throughput_meter.cycles_per_second();
+    metrics.candidates_per_second = stream.throughput_meter.candidates_per_second();
+    if (apply_thresholds(cycle_metrics_thresholds_, metrics)) {
+      if (profile_after_breach_) {
+        timing_sampler_.force_next();
+      }
+      RCLCPP_WARN_THROTTLE(
+        get_logger(), *get_clock(), 1000, "Stale or slow cycle on %s: %s",
+        stream.topic_prefix.c_str(), metrics.message.c_str());
+    }
+    stream.cycle_metrics_pub->publish(metrics);
+  };
+
+  if (previous_trajectory_ptr && cycle_params.keep_last_trajectory) {
+    const auto time_diff = (cycle_time - stream.last_time).seconds();
+    if (time_diff < cycle_params.keep_last_trajectory_s) {
+      Trajectories output_trajectories;
+      output_trajectories.generator_info = msg->generator_info;
+      output_trajectories.trajectories.push_back(create_output_trajectory_from_past(
+        *previous_trajectory_ptr, *msg, *current_odometry_ptr, cycle_time));
+      publish_candidate(stream, 0, 1, output_trajectories.trajectories.front());
+      publish_output(output_trajectories, stream);
+      publish_cycle_metrics(1, publish_processing_time());
+      return;
+    }
+  }
+  stream.last_time = cycle_time;
+
+  if (cycle_params.extend_trajectory_backward) {
+    // Note: it is ok to add the same ego state several times, the function skips repeated states
     utils::add_ego_state_to_trajectory(
-      past_ego_state_trajectory_.points, *current_odometry_ptr_, params_);
+      stream.past_ego_state_trajectory.points, *current_odometry_ptr, cycle_params);
+    const auto & ego_history_points = stream.past_ego_state_trajectory.points;
+    cycle_params.ego_history_points.assign(ego_history_points.begin(), ego_history_points.end());
   }
 
-  Trajectories output_trajectories = *msg;
-  for (auto & trajectory : output_trajectories.trajectories) {
-    // apply optimizers
-    trajectory_extender_ptr_->optimize_trajectory(trajectory.points, params_);
-    trajectory_point_fixer_ptr_->optimize_trajectory(trajectory.points, params_);
-    trajectory_velocity_optimizer_ptr_->optimize_trajectory(trajectory.points, params_);
-    eb_smoother_optimizer_ptr_->optimize_trajectory(trajectory.points, params_);
-    trajectory_spline_smoother_ptr_->optimize_trajectory(trajectory.points, params_);
-    trajectory_point_fixer_ptr_->optimize_trajectory(trajectory.points, params_);
+  auto & output_trajectories = stream.buffer_pool.acquire(*msg);
+  const bool append_previous_trajectory =
+    previous_trajectory_ptr && cycle_params.publish_last_trajectory;
+  const auto num_candidates = output_trajectories.trajectories.size();
+  const auto num_outputs = num_candidates + (append_previous_trajectory ? 1 : 0);
+  const auto optimization_start = std::chrono::steady_clock::now();
+  if (stream.candidate_pub) {
+    optimize_candidates(
+      output_trajectories, cycle_params, stream.workers, stream.schedule, stream.clusters,
+      [&](const size_t index) {
+        publish_candidate(stream, index, num_outputs, output_trajectories.trajectories[index]);
+      });
+  } else {
+    optimize_candidates(
+      output_trajectories, cycle_params, stream.workers, stream.schedule, stream.clusters);
   }
+  const auto optimization_time_ms =
+    std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - optimization_start)
+      .count();
+  publish_candidate_costs(stream, optimization_time_ms);
 
-  if (previous_trajectory_ptr_ && params_.publish_last_trajectory) {
-    output_trajectories.trajectories.push_back(create_output_trajectory_from_past());
+  if (append_previous_trajectory) {
+    output_trajectories.trajectories.push_back(create_output_trajectory_from_past(
+      *previous_trajectory_ptr, *msg, *current_odometry_ptr, cycle_time));
+    publish_candidate(stream, num_candidates, num_outputs, output_trajectories.trajectories.back());
   }
 
-  trajectories_pub_->publish(output_trajectories);
+  publish_output(output_trajectories, stream);
+  const auto processing_time_ms = publish_processing_time();
+  publish_cycle_metrics(output_trajectories.trajectories.size(), processing_time_ms);
+  publish_perf_counters();
+  offer_shadow_cycle(
+    stream, *msg, output_trajectories, num_candidates, cycle_params, optimization_time_ms);
+  if (slow_cycle_recorder_ptr_) {
+    capture_slow_cycle(
+      stream, processing_time_ms, *msg, *current_odometry_ptr, *current_acceleration_ptr,
+      previous_trajectory_ptr, cycle_time);
+  }
 }
 
 }  // namespace autoware::trajectory_optimizer
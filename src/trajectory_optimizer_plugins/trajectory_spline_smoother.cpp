@@ -23,7 +23,7 @@ void TrajectorySplineSmoother::optimize_trajectory(
 {
   // Apply spline to smooth the trajectory
   if (params.use_akima_spline_interpolation) {
-    utils::apply_spline(traj_points, params);
+    utils::apply_spline(traj_points, params, scratch_points_);
   }
 }
 
@@ -14,10 +14,13 @@
 
 #include "autoware/trajectory_optimizer/trajectory_optimizer_plugins/trajectory_velocity_optimizer.hpp"
 
+#include "autoware/trajectory_optimizer/fixed_size_utils.hpp"
 #include "autoware/trajectory_optimizer/utils.hpp"
 
 #include <autoware_vehicle_info_utils/vehicle_info_utils.hpp>
 
+#include <limits>
+
 namespace autoware::trajectory_optimizer::plugin
 {
 
@@ -28,57 +31,57 @@ TrajectoryVelocityOptimizer::TrajectoryVelocityOptimizer(
 : TrajectoryOptimizerPluginBase(name, node_ptr, time_keeper, params)
 {
   if (params.smooth_velocities) {
-    set_up_velocity_smoother(node_ptr, time_keeper);
+    set_up_velocity_smoother(node_ptr);
   }
 }
 
-void TrajectoryVelocityOptimizer::set_up_velocity_smoother(
-  rclcpp::Node * node_ptr, const std::shared_ptr<autoware_utils_debug::TimeKeeper> time_keeper)
+void TrajectoryVelocityOptimizer::set_up_velocity_smoother(rclcpp::Node * node_ptr)
 {
   const auto vehicle_info =
     autoware::vehicle_info_utils::VehicleInfoUtils(*node_ptr).getVehicleInfo();
   double wheelbase = vehicle_info.wheel_base_m;  // vehicle_info.wheel_base_m;
-  jerk_filtered_smoother_ = std::make_shared<JerkFilteredSmoother>(*node_ptr, time_keeper);
+  jerk_filtered_smoother_ =
+    std::make_shared<SampledJerkFilteredSmoother>(*node_ptr, silent_time_keeper_);
   jerk_filtered_smoother_->setWheelBase(wheelbase);
 }
 
 void TrajectoryVelocityOptimizer::optimize_trajectory(
   TrajectoryPoints & traj_points, [[maybe_unused]] const TrajectoryOptimizerParams & params)
 {
-  const auto & current_odometry = params.current_odometry;
-  const auto & current_acceleration = params.current_acceleration;
-  const auto & current_speed = current_odometry.twist.twist.linear.x;
-  const auto & current_linear_acceleration = current_acceleration.accel.accel.linear.x;
+  const auto & current_speed = params.current_odometry.twist.twist.linear.x;
   const double & target_pull_out_speed_mps = params.target_pull_out_speed_mps;
-  const double & target_pull_out_acc_mps2 = params.target_pull_out_acc_mps2;
   const double & max_speed_mps = params.max_speed_mps;
+  const auto initial_motion = utils::get_initial_motion(params);
 
-  auto initial_motion_speed =
-    (current_speed > target_pull_out_speed_mps) ? current_speed : target_pull_out_speed_mps;
-  auto initial_motion_acc = (current_speed > target_pull_out_speed_mps)
-                              ? current_linear_acceleration
-                              : target_pull_out_acc_mps2;
-
-  // Set engage speed and acceleration
-  if (params.set_engage_speed && (current_speed < target_pull_out_speed_mps)) {
-    utils::clamp_velocities(
-      traj_points, static_cast<float>(initial_motion_speed),
-      static_cast<float>(initial_motion_acc));
+  // Set engage speed and acceleration, and limit ego speed, in one pass
+  constexpr auto infinity = std::numeric_limits<float>::infinity();
+  const bool set_engage_speed =
+    params.set_engage_speed && (current_speed < target_pull_out_speed_mps);
+  if (set_engage_speed || params.limit_speed) {
+    utils::fixed_size::clamp_velocities(
+      traj_points, set_engage_speed ? static_cast<float>(initial_motion.speed_mps) : -infinity,
+      set_engage_speed ? static_cast<float>(initial_motion.acc_mps2) : -infinity,
+      params.limit_speed ? static_cast<float>(max_speed_mps) : infinity);
   }
 
-  // Limit ego speed
-  if (params.limit_speed) {
-    utils::set_max_velocity(traj_points, static_cast<float>(max_speed_mps));
-  }
+  smooth_velocity(traj_points, params);
+}
 
+void TrajectoryVelocityOptimizer::smooth_velocity(
+  TrajectoryPoints & traj_points, const TrajectoryOptimizerParams & params)
+{
   // Smooth velocity profile
   if (params.smooth_velocities) {
     if (!jerk_filtered_smoother_) {
-      set_up_velocity_smoother(get_node_ptr(), get_time_keeper());
+      set_up_velocity_smoother(get_node_ptr());
     }
-    InitialMotion initial_motion{initial_motion_speed, initial_motion_acc};
+    // the smoother's scopes are nested in the stage's on sampled cycles; on the others they would
+    // each publish a tree of their own
+    jerk_filtered_smoother_->set_time_keeper(
+      params.detailed_timing ? get_time_keeper() : silent_time_keeper_);
     utils::filter_velocity(
-      traj_points, initial_motion, params, jerk_filtered_smoother_, current_odometry);
+      traj_points, utils::get_initial_motion(params), params, jerk_filtered_smoother_,
+      params.current_odometry);
   }
 }
 
@@ -18,6 +18,8 @@
 #include "autoware/trajectory/interpolator/interpolator.hpp"
 #include "autoware/trajectory/pose.hpp"
 #include "autoware/trajectory/trajectory_point.hpp"
+#include "autoware/trajectory_optimizer/fixed_size_utils.hpp"
+#include "autoware/trajectory_optimizer/simd_kernels.hpp"
 #include "autoware/trajectory_optimizer/trajectory_optimizer_structs.hpp"
 
 #include <autoware/motion_utils/trajectory/trajectory.hpp>
@@ -29,6 +31,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <iostream>
 
 namespace autoware::trajectory_optimizer::utils
@@ -42,6 +45,43 @@ rclcpp::Logger get_logger()
   return rclcpp::get_logger("trajectory_optimizer");
 }
 
+namespace
+{
+/**
+ * @brief Erases the flagged points from the first one on, keeping the order of the others.
+ * @details The points are flagged in blocks on the stack, so nothing is allocated. A point is only
+ * ever overwritten by itself or a later one, so the flags of a block may look at the original
+ * previous points, as with std::remove_if.
+ *
+ * @param points The points.
+ * @param first The index of the first point that may be erased.
+ * @param flag_block Called as flag_block(begin, count, flags) to set flags[i] to 1 if the point at
+ * begin + i is to be erased and 0 otherwise.
+ */
+template <typename FlagBlock>
+void erase_flagged_points(TrajectoryPoints & points, const size_t first, FlagBlock && flag_block)
+{
+  constexpr size_t block_size = 64;
+  uint8_t flags[block_size];
+  size_t num_kept = first;
+  for (size_t begin = first; begin < points.size(); begin += block_size) {
+    const size_t count = std::min(block_size, points.size() - begin);
+    flag_block(begin, count, flags);
+    for (size_t i = 0; i < count; ++i) {
+      if (flags[i]) {
+        continue;
+      }
+      if (num_kept != begin + i) {
+        points[num_kept] = std::move(points[begin + i]);
+      }
+      ++num_kept;
+    }
+  }
+  points.erase(
+    points.begin() + static_cast<TrajectoryPoints::difference_type>(num_kept), points.end());
+}
+}  // namespace
+
 void smooth_trajectory_with_elastic_band(
   TrajectoryPoints & traj_points, const Odometry & current_odometry,
   const std::shared_ptr<EBPathSmoother> & eb_path_smoother_ptr)
@@ -63,14 +103,17 @@ void remove_invalid_points(TrajectoryPoints & input_trajectory)
     RCLCPP_ERROR(get_logger(), "No enough points in trajectory after overlap points removal");
     return;
   }
-  // remove points with nan or inf values
-  input_trajectory.erase(
-    std::remove_if(
-      input_trajectory.begin(), input_trajectory.end(),
-      [](const TrajectoryPoint & point) { return !validate_point(point); }),
-    input_trajectory.end());
-
-  utils::remove_close_proximity_points(input_trajectory, 1E-2);
+  constexpr double min_dist = 1E-2;
+  // the outputs of fixed-size generators usually have nothing to remove
+  if (!fixed_size::are_valid_and_apart(input_trajectory, min_dist)) {
+    // remove points with nan or inf values
+    erase_flagged_points(
+      input_trajectory, 0, [&](const size_t begin, const size_t count, uint8_t * is_invalid) {
+        simd::flag_invalid_points(input_trajectory.data() + begin, count, is_invalid);
+      });
+
+    utils::remove_close_proximity_points(input_trajectory, min_dist);
+  }
   const bool is_driving_forward = true;
   autoware::motion_utils::insertOrientation(input_trajectory, is_driving_forward);
 
@@ -91,36 +134,35 @@ void remove_close_proximity_points(TrajectoryPoints & input_trajectory_array, co
     return;
   }
 
-  input_trajectory_array.erase(
-    std::remove_if(
-      std::next(input_trajectory_array.begin()),  // Start from second element
-      input_trajectory_array.end(),
-      [&](const TrajectoryPoint & point) {
-        const auto prev_it = std::prev(&point);
-        const auto dist = autoware_utils::calc_distance2d(point, *prev_it);
-        return dist < min_dist;
-      }),
-    input_trajectory_array.end());
+  // Start from second element, each point is compared with the one before it
+  erase_flagged_points(
+    input_trajectory_array, 1, [&](const size_t begin, const size_t count, uint8_t * is_close) {
+      simd::flag_close_pairs(
+        input_trajectory_array.data() + begin - 1, count + 1, min_dist, is_close);
+    });
+}
+
+InitialMotion get_initial_motion(const TrajectoryOptimizerParams & params)
+{
+  const auto current_speed = params.current_odometry.twist.twist.linear.x;
+  const auto current_linear_acceleration = params.current_acceleration.accel.accel.linear.x;
+  const bool is_moving = current_speed > params.target_pull_out_speed_mps;
+  return InitialMotion{
+    is_moving ? current_speed : params.target_pull_out_speed_mps,
+    is_moving ? current_linear_acceleration : params.target_pull_out_acc_mps2};
 }
 
 void clamp_velocities(
   TrajectoryPoints & input_trajectory_array, float min_velocity, float min_acceleration)
 {
-  std::for_each(
-    input_trajectory_array.begin(), input_trajectory_array.end(),
-    [min_velocity, min_acceleration](TrajectoryPoint & point) {
-      point.longitudinal_velocity_mps = std::max(point.longitudinal_velocity_mps, min_velocity);
-      point.acceleration_mps2 = std::max(point.acceleration_mps2, min_acceleration);
-    });
+  simd::clamp_min_velocity_and_acceleration(
+    input_trajectory_array.data(), input_trajectory_array.size(), min_velocity, min_acceleration);
 }
 
 void set_max_velocity(TrajectoryPoints & input_trajectory_array, const float max_velocity)
 {
-  std::for_each(
-    input_trajectory_array.begin(), input_trajectory_array.end(),
-    [max_velocity](TrajectoryPoint & point) {
-      point.longitudinal_velocity_mps = std::min(point.longitudinal_velocity_mps, max_velocity);
-    });
+  simd::clamp_max_velocity(
+    input_trajectory_array.data(), input_trajectory_array.size(), max_velocity);
 }
 
 void filter_velocity(
@@ -160,13 +202,10 @@ void filter_velocity(
   const size_t traj_closest = autoware::motion_utils::findFirstNearestIndexWithSoftConstraints(
     input_trajectory, current_odometry.pose.pose, nearest_dist_threshold, nearest_yaw_threshold);
 
-  // // Clip trajectory from closest point
-  TrajectoryPoints clipped;
-  clipped.insert(
-    clipped.end(),
-    input_trajectory.begin() + static_cast<TrajectoryPoints::difference_type>(traj_closest),
-    input_trajectory.end());
-  input_trajectory = clipped;
+  // Clip trajectory from closest point
+  input_trajectory.erase(
+    input_trajectory.begin(),
+    input_trajectory.begin() + static_cast<TrajectoryPoints::difference_type>(traj_closest));
 
   std::vector<TrajectoryPoints> debug_trajectories;
   if (!smoother->apply(
@@ -190,6 +229,14 @@ bool validate_point(const TrajectoryPoint & point)
 }
 
 void apply_spline(TrajectoryPoints & traj_points, const TrajectoryOptimizerParams & params)
+{
+  TrajectoryPoints output_points;
+  apply_spline(traj_points, params, output_points);
+}
+
+void apply_spline(
+  TrajectoryPoints & traj_points, const TrajectoryOptimizerParams & params,
+  TrajectoryPoints & output_points)
 {
   if (traj_points.size() < 5) {
     RCLCPP_ERROR(get_logger(), "Not enough points in trajectory for akima spline interpolation");
@@ -204,10 +251,11 @@ void apply_spline(TrajectoryPoints & traj_points, const TrajectoryOptimizerParam
     return;
   }
   trajectory_interpolation_util->align_orientation_with_trajectory_direction();
-  TrajectoryPoints output_points{traj_points.front()};
   constexpr double epsilon{1e-2};
   const auto ds = std::max(params.spline_interpolation_resolution_m, epsilon);
-  output_points.reserve(static_cast<size_t>(trajectory_interpolation_util->length() / ds));
+  output_points.clear();
+  output_points.reserve(static_cast<size_t>(trajectory_interpolation_util->length() / ds) + 2);
+  output_points.push_back(traj_points.front());
 
   for (auto s = ds; s <= trajectory_interpolation_util->length(); s += ds) {
     auto p = trajectory_interpolation_util->compute(s);
@@ -226,7 +274,7 @@ void apply_spline(TrajectoryPoints & traj_points, const TrajectoryOptimizerParam
 
   if (!validate_point(original_trajectory_last_point)) {
     RCLCPP_WARN(get_logger(), "Last point in original trajectory is invalid. Removing last point");
-    traj_points = output_points;
+    traj_points.swap(output_points);
     return;
   }
 
@@ -235,7 +283,7 @@ void apply_spline(TrajectoryPoints & traj_points, const TrajectoryOptimizerParam
   if (d > epsilon) {
     output_points.push_back(original_trajectory_last_point);
   };
-  traj_points = output_points;
+  traj_points.swap(output_points);
 }
 
 void interpolate_trajectory(
@@ -337,7 +385,7 @@ void add_ego_state_to_trajectory(
   size_t clip_idx = 0;
   double accumulated_length = 0.0;
   for (size_t i = traj_points.size() - 1; i > 0; i--) {
-    accumulated_length += autoware_utils::calc_distance2d(traj_points.at(i - 1), traj_points.at(i));
+    accumulated_length += autoware_utils::calc_distance2d(traj_points[i - 1], traj_points[i]);
     if (accumulated_length > params.backward_trajectory_extension_m) {
       clip_idx = i;
       break;
@@ -354,6 +402,8 @@ void expand_trajectory_with_ego_history(
     return;
   }
 
+  // every history point may be inserted at the front, reserve so that the inserts do not reallocate
+  traj_points.reserve(traj_points.size() + ego_history_points.size());
   const auto & first_trajectory_point = traj_points.front();
   const auto distance_to_first_point = std::abs(autoware::motion_utils::calcSignedArcLength(
     traj_points, first_trajectory_point.pose.position, current_odometry.pose.pose.position));
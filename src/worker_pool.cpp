@@ -0,0 +1,97 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/trajectory_optimizer/worker_pool.hpp"
+
+namespace autoware::trajectory_optimizer
+{
+
+WorkerPool::WorkerPool(
+  const size_t num_workers, const std::function<void(size_t)> & on_worker_start)
+: on_worker_start_(on_worker_start)
+{
+  threads_.reserve(num_workers);
+  for (size_t i = 0; i < num_workers; ++i) {
+    threads_.emplace_back([this, i]() { run_worker(i); });
+  }
+}
+
+WorkerPool::~WorkerPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  work_available_.notify_all();
+  for (auto & thread : threads_) {
+    thread.join();
+  }
+}
+
+void WorkerPool::parallel_for(const size_t num_tasks, const Task & task)
+{
+  if (num_tasks == 0) {
+    return;
+  }
+  Batch batch;
+  batch.num_tasks = num_tasks;
+  batch.task = &task;
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  batches_.push_back(&batch);
+  work_available_.notify_all();
+  batch.done.wait(lock, [&batch]() { return batch.completed == batch.num_tasks; });
+  if (batch.exception) {
+    std::rethrow_exception(batch.exception);
+  }
+}
+
+void WorkerPool::run_worker(const size_t worker_id)
+{
+  if (on_worker_start_) {
+    on_worker_start_(worker_id);
+  }
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    work_available_.wait(lock, [this]() { return stop_ || !batches_.empty(); });
+    if (batches_.empty()) {
+      return;
+    }
+    auto * batch = batches_.front();
+    const auto task_index = batch->next_index++;
+    // the batch leaves the queue once its last task is handed out, not when it completes
+    if (batch->next_index == batch->num_tasks) {
+      batches_.pop_front();
+    }
+    lock.unlock();
+
+    std::exception_ptr exception;
+    try {
+      (*batch->task)(task_index, worker_id);
+    } catch (...) {
+      exception = std::current_exception();
+    }
+
+    lock.lock();
+    if (exception && !batch->exception) {
+      batch->exception = exception;
+    }
+    if (++batch->completed == batch->num_tasks) {
+      batch->done.notify_all();
+    }
+  }
+}
+
+}  // namespace autoware::trajectory_optimizer
@@ -0,0 +1,177 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "differential.hpp"
+
+#include <builtin_interfaces/msg/duration.hpp>
+
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <tuple>
+#include <utility>
+
+namespace autoware::trajectory_optimizer::reference
+{
+namespace
+{
+bool is_within(const double reference, const double production, const double tolerance)
+{
+  if (std::isnan(reference) || std::isnan(production)) {
+    return std::isnan(reference) && std::isnan(production);
+  }
+  if (reference == production) {
+    return true;  // also covers infinities of the same sign
+  }
+  return std::abs(reference - production) <= tolerance;
+}
+
+double to_seconds(const builtin_interfaces::msg::Duration & duration)
+{
+  return duration.sec + duration.nanosec * 1e-9;
+}
+
+TrajectoryPoint make_point(const double x, const double y, const double yaw, const float velocity)
+{
+  TrajectoryPoint point;
+  point.pose.position.x = x;
+  point.pose.position.y = y;
+  point.pose.orientation.z = std::sin(yaw / 2.0);
+  point.pose.orientation.w = std::cos(yaw / 2.0);
+  point.longitudinal_velocity_mps = velocity;
+  return point;
+}
+
+TrajectoryPoints make_straight(const size_t num_points, const double interval_m)
+{
+  TrajectoryPoints points;
+  for (size_t i = 0; i < num_points; ++i) {
+    points.push_back(make_point(static_cast<double>(i) * interval_m, 0.0, 0.0, 5.0f));
+  }
+  return points;
+}
+}  // namespace
+
+std::optional<std::string> find_first_divergence(
+  const TrajectoryPoints & reference, const TrajectoryPoints & production,
+  const Tolerance & tolerance)
+{
+  if (reference.size() != production.size()) {
+    std::ostringstream message;
+    message << "size: reference " << reference.size() << ", production " << production.size();
+    return message.str();
+  }
+  for (size_t i = 0; i < reference.size(); ++i) {
+    const auto & r = reference[i];
+    const auto & p = production[i];
+    const std::pair<const char *, std::tuple<double, double, double>> fields[] = {
+      {"pose.position.x", {r.pose.position.x, p.pose.position.x, tolerance.position_m}},
+      {"pose.position.y", {r.pose.position.y, p.pose.position.y, tolerance.position_m}},
+      {"pose.position.z", {r.pose.position.z, p.pose.position.z, tolerance.position_m}},
+      {"pose.orientation.x", {r.pose.orientation.x, p.pose.orientation.x, tolerance.orientation}},
+      {"pose.orientation.y", {r.pose.orientation.y, p.pose.orientation.y, tolerance.orientation}},
+      {"pose.orientation.z", {r.pose.orientation.z, p.pose.orientation.z, tolerance.orientation}},
+      {"pose.orientation.w", {r.pose.orientation.w, p.pose.orientation.w, tolerance.orientation}},
+      {"longitudinal_velocity_mps",
+       {r.longitudinal_velocity_mps, p.longitudinal_velocity_mps, tolerance.velocity_mps}},
+      {"lateral_velocity_mps",
+       {r.lateral_velocity_mps, p.lateral_velocity_mps, tolerance.velocity_mps}},
+      {"acceleration_mps2",
+       {r.acceleration_mps2, p.acceleration_mps2, tolerance.acceleration_mps2}},
+      {"heading_rate_rps", {r.heading_rate_rps, p.heading_rate_rps, tolerance.orientation}},
+      {"time_from_start",
+       {to_seconds(r.time_from_start), to_seconds(p.time_from_start), tolerance.time_s}},
+    };
+    for (const auto & [name, values] : fields) {
+      const auto [reference_value, production_value, field_tolerance] = values;
+      if (!is_within(reference_value, production_value, field_tolerance)) {
+        std::ostringstream message;
+        message.precision(17);
+        message << "point " << i << " of " << reference.size() << ", " << name << ": reference "
+                << reference_value << ", production " << production_value << ", tolerance "
+                << field_tolerance;
+        return message.str();
+      }
+    }
+  }
+  return std::nullopt;
+}
+
+std::vector<std::pair<std::string, TrajectoryPoints>> make_edge_cases()
+{
+  constexpr double nan = std::numeric_limits<double>::quiet_NaN();
+  constexpr double inf = std::numeric_limits<double>::infinity();
+  std::vector<std::pair<std::string, TrajectoryPoints>> cases;
+
+  cases.emplace_back("empty", TrajectoryPoints{});
+  cases.emplace_back("single point", make_straight(1, 1.0));
+  cases.emplace_back("two points", make_straight(2, 1.0));
+  cases.emplace_back("all at the same position", make_straight(10, 0.0));
+
+  auto duplicates = make_straight(20, 1.0);
+  for (size_t i = 0; i < duplicates.size(); i += 3) {
+    duplicates.insert(duplicates.begin() + static_cast<std::ptrdiff_t>(i), duplicates[i]);
+  }
+  cases.emplace_back("duplicates", duplicates);
+
+  auto below_min_dist = make_straight(20, 1.0);
+  below_min_dist[5].pose.position.x = below_min_dist[4].pose.position.x + 0.005;
+  below_min_dist[10].pose.position.x = below_min_dist[9].pose.position.x + 0.01;
+  cases.emplace_back("spacing around 1cm", below_min_dist);
+
+  auto nan_front = make_straight(20, 1.0);
+  nan_front.front().pose.position.x = nan;
+  cases.emplace_back("nan at the front", nan_front);
+
+  auto nan_back = make_straight(20, 1.0);
+  nan_back.back().pose.position.y = nan;
+  cases.emplace_back("nan at the back", nan_back);
+
+  auto inf_velocity = make_straight(20, 1.0);
+  inf_velocity.back().longitudinal_velocity_mps = static_cast<float>(inf);
+  inf_velocity[7].acceleration_mps2 = static_cast<float>(-inf);
+  cases.emplace_back("inf velocity and acceleration", inf_velocity);
+
+  auto nan_orientation = make_straight(20, 1.0);
+  nan_orientation[3].pose.orientation.w = nan;
+  cases.emplace_back("nan orientation", nan_orientation);
+
+  TrajectoryPoints all_invalid = make_straight(5, 1.0);
+  for (auto & point : all_invalid) {
+    point.pose.position.x = nan;
+  }
+  cases.emplace_back("all invalid", all_invalid);
+
+  // 180 degree turn with a 2 m radius, tighter than the spacing of the spline output
+  TrajectoryPoints hairpin = make_straight(10, 1.0);
+  for (int i = 1; i <= 8; ++i) {
+    const double angle = M_PI * i / 8.0;
+    hairpin.push_back(make_point(
+      9.0 + 2.0 * std::sin(angle), 2.0 - 2.0 * std::cos(angle), angle, 3.0f));
+  }
+  for (int i = 1; i <= 10; ++i) {
+    hairpin.push_back(make_point(9.0 - i, 4.0, M_PI, 5.0f));
+  }
+  cases.emplace_back("hairpin", hairpin);
+
+  // the path goes back over itself
+  TrajectoryPoints reversal = make_straight(10, 1.0);
+  for (int i = 1; i <= 10; ++i) {
+    reversal.push_back(make_point(9.0 - i * 0.9, 0.0, 0.0, 2.0f));
+  }
+  cases.emplace_back("reversal", reversal);
+
+  return cases;
+}
+}  // namespace autoware::trajectory_optimizer::reference
@@ -0,0 +1,65 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef REFERENCE__DIFFERENTIAL_HPP_
+#define REFERENCE__DIFFERENTIAL_HPP_
+
+#include <autoware_planning_msgs/msg/trajectory_point.hpp>
+
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace autoware::trajectory_optimizer::reference
+{
+using autoware_planning_msgs::msg::TrajectoryPoint;
+using TrajectoryPoints = std::vector<TrajectoryPoint>;
+
+/**
+ * @brief Absolute tolerance of each compared field, 0 requiring the same value.
+ */
+struct Tolerance
+{
+  double position_m{0.0};
+  double orientation{0.0};
+  double velocity_mps{0.0};
+  double acceleration_mps2{0.0};
+  double time_s{0.0};
+};
+
+/**
+ * @brief Compares the output of a production kernel with the output of its reference.
+ * @details NaN is equal to NaN, as both kernels are expected to pass the same invalid values on.
+ *
+ * @param reference The reference output.
+ * @param production The production output.
+ * @param tolerance The tolerance of each field.
+ * @return A description of the size mismatch or of the first point and field that differ, or
+ * nullopt if the outputs match.
+ */
+std::optional<std::string> find_first_divergence(
+  const TrajectoryPoints & reference, const TrajectoryPoints & production,
+  const Tolerance & tolerance = Tolerance{});
+
+/**
+ * @brief Hand-written edge cases: empty, single point, duplicates, NaN and inf at the boundaries,
+ * a hairpin and a reversal.
+ *
+ * @return The named inputs.
+ */
+std::vector<std::pair<std::string, TrajectoryPoints>> make_edge_cases();
+}  // namespace autoware::trajectory_optimizer::reference
+
+#endif  // REFERENCE__DIFFERENTIAL_HPP_
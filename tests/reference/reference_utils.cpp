@@ -0,0 +1,227 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "reference_utils.hpp"
+
+#include "autoware/trajectory/interpolator/akima_spline.hpp"
+#include "autoware/trajectory/interpolator/interpolator.hpp"
+#include "autoware/trajectory/pose.hpp"
+#include "autoware/trajectory/trajectory_point.hpp"
+
+#include <autoware/motion_utils/trajectory/trajectory.hpp>
+#include <autoware_utils/geometry/geometry.hpp>
+#include <autoware_utils/math/normalization.hpp>
+#include <rclcpp/logging.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace autoware::trajectory_optimizer::reference
+{
+using autoware::experimental::trajectory::interpolator::AkimaSpline;
+using InterpolationTrajectory =
+  autoware::experimental::trajectory::Trajectory<autoware_planning_msgs::msg::TrajectoryPoint>;
+
+namespace
+{
+rclcpp::Logger get_logger()
+{
+  return rclcpp::get_logger("trajectory_optimizer_reference");
+}
+}  // namespace
+
+bool validate_point(const TrajectoryPoint & point)
+{
+  return std::isfinite(point.longitudinal_velocity_mps) && std::isfinite(point.acceleration_mps2) &&
+         std::isfinite(point.pose.position.x) && std::isfinite(point.pose.position.y) &&
+         std::isfinite(point.pose.position.z) && std::isfinite(point.pose.orientation.x) &&
+         std::isfinite(point.pose.orientation.y) && std::isfinite(point.pose.orientation.z) &&
+         std::isfinite(point.pose.orientation.w) && !std::isnan(point.pose.position.x) &&
+         !std::isnan(point.pose.position.y) && !std::isnan(point.pose.position.z) &&
+         !std::isnan(point.pose.orientation.x) && !std::isnan(point.pose.orientation.y) &&
+         !std::isnan(point.pose.orientation.z) && !std::isnan(point.pose.orientation.w) &&
+         !std::isnan(point.longitudinal_velocity_mps) && !std::isnan(point.acceleration_mps2);
+}
+
+void remove_close_proximity_points(TrajectoryPoints & input_trajectory_array, const double min_dist)
+{
+  if (std::size(input_trajectory_array) < 2) {
+    return;
+  }
+
+  input_trajectory_array.erase(
+    std::remove_if(
+      std::next(input_trajectory_array.begin()),  // Start from second element
+      input_trajectory_array.end(),
+      [&](const TrajectoryPoint & point) {
+        const auto prev_it = std::prev(&point);
+        const auto dist = autoware_utils::calc_distance2d(point, *prev_it);
+        return dist < min_dist;
+      }),
+    input_trajectory_array.end());
+}
+
+void remove_invalid_points(TrajectoryPoints & input_trajectory)
+{
+  if (input_trajectory.size() < 2) {
+    RCLCPP_ERROR(get_logger(), "No enough points in trajectory after overlap points removal");
+    return;
+  }
+  // remove points with nan or inf values
+  input_trajectory.erase(
+    std::remove_if(
+      input_trajectory.begin(), input_trajectory.end(),
+      [](const TrajectoryPoint & point) { return !validate_point(point); }),
+    input_trajectory.end());
+
+  remove_close_proximity_points(input_trajectory, 1E-2);
+  const bool is_driving_forward = true;
+  autoware::motion_utils::insertOrientation(input_trajectory, is_driving_forward);
+
+  autoware::motion_utils::removeFirstInvalidOrientationPoints(input_trajectory);
+  size_t previous_size{input_trajectory.size()};
+  do {
+    previous_size = input_trajectory.size();
+    // Set the azimuth orientation to the next point at each point
+    autoware::motion_utils::insertOrientation(input_trajectory, is_driving_forward);
+    // Use azimuth orientation to remove points in reverse order
+    autoware::motion_utils::removeFirstInvalidOrientationPoints(input_trajectory);
+  } while (previous_size != input_trajectory.size());
+}
+
+void apply_spline(TrajectoryPoints & traj_points, const TrajectoryOptimizerParams & params)
+{
+  if (traj_points.size() < 5) {
+    RCLCPP_ERROR(get_logger(), "Not enough points in trajectory for akima spline interpolation");
+    return;
+  }
+  auto trajectory_interpolation_util =
+    InterpolationTrajectory::Builder{}
+      .set_xy_interpolator<AkimaSpline>()  // Set interpolator for x-y plane
+      .build(traj_points);
+  if (!trajectory_interpolation_util) {
+    RCLCPP_WARN(get_logger(), "Failed to build interpolation trajectory");
+    return;
+  }
+  trajectory_interpolation_util->align_orientation_with_trajectory_direction();
+  TrajectoryPoints output_points{traj_points.front()};
+  constexpr double epsilon{1e-2};
+  const auto ds = std::max(params.spline_interpolation_resolution_m, epsilon);
+  output_points.reserve(static_cast<size_t>(trajectory_interpolation_util->length() / ds));
+
+  for (auto s = ds; s <= trajectory_interpolation_util->length(); s += ds) {
+    auto p = trajectory_interpolation_util->compute(s);
+    if (!validate_point(p)) {
+      continue;
+    }
+    output_points.push_back(p);
+  }
+
+  if (output_points.size() < 2) {
+    RCLCPP_WARN(get_logger(), "Not enough points in trajectory after akima spline interpolation");
+    return;
+  }
+  auto last_interpolated_point = output_points.back();
+  auto & original_trajectory_last_point = traj_points.back();
+
+  if (!validate_point(original_trajectory_last_point)) {
+    RCLCPP_WARN(get_logger(), "Last point in original trajectory is invalid. Removing last point");
+    traj_points = output_points;
+    return;
+  }
+
+  auto d = autoware_utils::calc_distance2d(
+    last_interpolated_point.pose.position, original_trajectory_last_point.pose.position);
+  if (d > epsilon) {
+    output_points.push_back(original_trajectory_last_point);
+  };
+  traj_points = output_points;
+}
+
+void add_ego_state_to_trajectory(
+  TrajectoryPoints & traj_points, const Odometry & current_odometry,
+  const TrajectoryOptimizerParams & params)
+{
+  TrajectoryPoint ego_state;
+  ego_state.pose = current_odometry.pose.pose;
+  ego_state.longitudinal_velocity_mps = current_odometry.twist.twist.linear.x;
+
+  if (traj_points.empty()) {
+    traj_points.push_back(ego_state);
+    return;
+  }
+  const auto & last_point = traj_points.back();
+  const auto yaw_diff = std::abs(
+    autoware_utils::normalize_degree(ego_state.pose.orientation.z - last_point.pose.orientation.z));
+  const auto distance = autoware_utils::calc_distance2d(last_point, ego_state);
+  constexpr double epsilon{1e-2};
+  const bool is_change_small = distance < epsilon && yaw_diff < epsilon;
+  if (is_change_small) {
+    return;
+  }
+
+  const bool is_change_large =
+    distance > params.nearest_dist_threshold_m || yaw_diff > params.nearest_yaw_threshold_rad;
+  if (is_change_large) {
+    traj_points = {ego_state};
+    return;
+  }
+
+  traj_points.push_back(ego_state);
+
+  size_t clip_idx = 0;
+  double accumulated_length = 0.0;
+  for (size_t i = traj_points.size() - 1; i > 0; i--) {
+    accumulated_length += autoware_utils::calc_distance2d(traj_points.at(i - 1), traj_points.at(i));
+    if (accumulated_length > params.backward_trajectory_extension_m) {
+      clip_idx = i;
+      break;
+    }
+  }
+  traj_points.erase(traj_points.begin(), traj_points.begin() + static_cast<int>(clip_idx));
+}
+
+void expand_trajectory_with_ego_history(
+  TrajectoryPoints & traj_points, const TrajectoryPoints & ego_history_points,
+  const Odometry & current_odometry, const TrajectoryOptimizerParams & params)
+{
+  if (ego_history_points.empty() || traj_points.empty()) {
+    return;
+  }
+
+  const auto & first_trajectory_point = traj_points.front();
+  const auto distance_to_first_point = std::abs(autoware::motion_utils::calcSignedArcLength(
+    traj_points, first_trajectory_point.pose.position, current_odometry.pose.pose.position));
+
+  const auto first_traj_point_position = traj_points.front().pose.position;
+
+  std::for_each(ego_history_points.rbegin(), ego_history_points.rend(), [&](auto point) {
+    const auto arc_length = autoware::motion_utils::calcSignedArcLength(
+      traj_points, first_traj_point_position, point.pose.position);
+    const auto distance = std::abs(arc_length);
+
+    const bool is_outside_of_relevant_range =
+      distance < distance_to_first_point || distance > params.backward_trajectory_extension_m;
+    const bool is_ahead_of_first_point = arc_length > 0.0;
+
+    if (is_ahead_of_first_point || is_outside_of_relevant_range) {
+      return;  // Skip points that are ahead of the first trajectory point
+      // Skip points that are too close or too far from the first trajectory point
+    }
+
+    point.longitudinal_velocity_mps = traj_points.front().longitudinal_velocity_mps;
+    traj_points.insert(traj_points.begin(), point);
+  });
+}
+}  // namespace autoware::trajectory_optimizer::reference
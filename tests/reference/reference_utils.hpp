@@ -0,0 +1,52 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef REFERENCE__REFERENCE_UTILS_HPP_
+#define REFERENCE__REFERENCE_UTILS_HPP_
+
+#include "autoware/trajectory_optimizer/trajectory_optimizer_structs.hpp"
+
+#include <autoware_planning_msgs/msg/trajectory_point.hpp>
+#include <nav_msgs/msg/odometry.hpp>
+
+#include <vector>
+
+// Frozen copies of the utils kernels, kept as the specification that faster rewrites of the
+// production versions in src/utils.cpp are tested against in test_differential.cpp. Do not
+// optimize or fix them: a behavior change of the production path is only intended if it comes with
+// a matching change here, reviewed as such.
+namespace autoware::trajectory_optimizer::reference
+{
+using autoware_planning_msgs::msg::TrajectoryPoint;
+using TrajectoryPoints = std::vector<TrajectoryPoint>;
+
+bool validate_point(const TrajectoryPoint & point);
+
+void remove_close_proximity_points(
+  TrajectoryPoints & input_trajectory_array, const double min_dist);
+
+void remove_invalid_points(TrajectoryPoints & input_trajectory);
+
+void apply_spline(TrajectoryPoints & traj_points, const TrajectoryOptimizerParams & params);
+
+void add_ego_state_to_trajectory(
+  TrajectoryPoints & traj_points, const Odometry & current_odometry,
+  const TrajectoryOptimizerParams & params);
+
+void expand_trajectory_with_ego_history(
+  TrajectoryPoints & traj_points, const TrajectoryPoints & ego_history_points,
+  const Odometry & current_odometry, const TrajectoryOptimizerParams & params);
+}  // namespace autoware::trajectory_optimizer::reference
+
+#endif  // REFERENCE__REFERENCE_UTILS_HPP_
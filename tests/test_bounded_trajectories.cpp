@@ -0,0 +1,106 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/trajectory_optimizer/bounded_trajectories.hpp"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+
+using autoware::trajectory_optimizer::BoundedTrajectories;
+using autoware::trajectory_optimizer::from_bounded;
+using autoware::trajectory_optimizer::to_bounded;
+using autoware::trajectory_optimizer::Trajectories;
+using autoware_trajectory_optimizer::msg::BoundedGeneratorInfo;
+using autoware_trajectory_optimizer::msg::BoundedTrajectory;
+
+namespace
+{
+Trajectories create_trajectories(const size_t num_candidates, const size_t num_points)
+{
+  Trajectories trajectories;
+  trajectories.trajectories.resize(num_candidates);
+  for (size_t i = 0; i < num_candidates; ++i) {
+    auto & trajectory = trajectories.trajectories[i];
+    trajectory.header.frame_id = "map";
+    trajectory.header.stamp.sec = static_cast<int32_t>(i);
+    trajectory.generator_id.uuid[0] = static_cast<uint8_t>(i);
+    trajectory.score = static_cast<double>(i);
+    trajectory.points.resize(num_points);
+    for (size_t j = 0; j < num_points; ++j) {
+      trajectory.points[j].pose.position.x = static_cast<double>(j);
+    }
+  }
+  trajectories.generator_info.resize(2);
+  for (size_t i = 0; i < trajectories.generator_info.size(); ++i) {
+    auto & generator_info = trajectories.generator_info[i];
+    generator_info.generator_id.uuid[0] = static_cast<uint8_t>(i);
+    generator_info.generator_name.data = "generator_" + std::to_string(i);
+  }
+  return trajectories;
+}
+}  // namespace
+
+TEST(BoundedTrajectoriesTest, RoundTrip)
+{
+  const auto trajectories = create_trajectories(3, 20);
+  // too large for the stack
+  auto bounded_trajectories = std::make_unique<BoundedTrajectories>();
+  EXPECT_TRUE(to_bounded(trajectories, *bounded_trajectories));
+  EXPECT_EQ(bounded_trajectories->num_trajectories, 3u);
+
+  Trajectories converted;
+  from_bounded(*bounded_trajectories, converted);
+  EXPECT_EQ(converted, trajectories);
+}
+
+TEST(BoundedTrajectoriesTest, HoldsCandidatesAndPreviousTrajectoryOfFullCycle)
+{
+  // 64 candidates and the previous trajectory of publish_last_trajectory
+  const auto trajectories = create_trajectories(65, 2);
+  auto bounded_trajectories = std::make_unique<BoundedTrajectories>();
+  EXPECT_TRUE(to_bounded(trajectories, *bounded_trajectories));
+
+  Trajectories converted;
+  from_bounded(*bounded_trajectories, converted);
+  EXPECT_EQ(converted, trajectories);
+}
+
+TEST(BoundedTrajectoriesTest, TruncatesToCapacity)
+{
+  auto trajectories =
+    create_trajectories(BoundedTrajectories::MAX_TRAJECTORIES + 1, BoundedTrajectory::MAX_POINTS);
+  trajectories.trajectories.front().points.resize(BoundedTrajectory::MAX_POINTS + 1);
+  trajectories.trajectories.front().header.frame_id =
+    std::string(BoundedTrajectory::MAX_FRAME_ID_LENGTH, 'a');
+  trajectories.generator_info.resize(BoundedTrajectories::MAX_GENERATOR_INFO + 1);
+  trajectories.generator_info.front().generator_name.data =
+    std::string(BoundedGeneratorInfo::MAX_NAME_LENGTH, 'b');
+
+  auto bounded_trajectories = std::make_unique<BoundedTrajectories>();
+  EXPECT_FALSE(to_bounded(trajectories, *bounded_trajectories));
+
+  Trajectories converted;
+  from_bounded(*bounded_trajectories, converted);
+  ASSERT_EQ(converted.trajectories.size(), BoundedTrajectories::MAX_TRAJECTORIES);
+  EXPECT_EQ(converted.trajectories.front().points.size(), BoundedTrajectory::MAX_POINTS);
+  EXPECT_EQ(
+    converted.trajectories.front().header.frame_id,
+    std::string(BoundedTrajectory::MAX_FRAME_ID_LENGTH - 1, 'a'));
+  ASSERT_EQ(converted.generator_info.size(), BoundedTrajectories::MAX_GENERATOR_INFO);
+  EXPECT_EQ(
+    converted.generator_info.front().generator_name.data,
+    std::string(BoundedGeneratorInfo::MAX_NAME_LENGTH - 1, 'b'));
+}
@@ -0,0 +1,143 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/trajectory_optimizer/candidate_batch.hpp"
+#include "autoware/trajectory_optimizer/scenario_generator.hpp"
+#include "autoware/trajectory_optimizer/static_pipeline.hpp"
+#include "autoware/trajectory_optimizer/trajectory_optimizer_structs.hpp"
+#include "autoware/trajectory_optimizer/utils.hpp"
+#include "reference/differential.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using autoware::trajectory_optimizer::CandidateBatch;
+using autoware::trajectory_optimizer::NewTrajectory;
+using autoware::trajectory_optimizer::TrajectoryOptimizerParams;
+using autoware::trajectory_optimizer::pipeline::Pipeline;
+namespace reference = autoware::trajectory_optimizer::reference;
+namespace scenarios = autoware::trajectory_optimizer::scenarios;
+namespace stages = autoware::trajectory_optimizer::pipeline::stages;
+namespace utils = autoware::trajectory_optimizer::utils;
+
+namespace
+{
+// short candidates with invalid and duplicated points, and an empty one in the middle
+std::vector<NewTrajectory> create_candidates()
+{
+  scenarios::ScenarioParams params;
+  params.type = scenarios::ScenarioType::INTERSECTION_TURN;
+  params.num_points = 12;
+  params.defects.invalid_point_ratio = 0.1;
+  params.defects.duplicate_point_ratio = 0.1;
+  auto candidates = scenarios::ScenarioGenerator(4).generate_candidates(params, 8).trajectories;
+  candidates[3].points.clear();
+  candidates[5].points[2].longitudinal_velocity_mps = std::nanf("");
+  candidates[7].points.back().pose.position.x = std::nan("");
+  return candidates;
+}
+
+TrajectoryOptimizerParams create_params()
+{
+  TrajectoryOptimizerParams params;
+  params.set_engage_speed = true;
+  params.limit_speed = true;
+  params.target_pull_out_speed_mps = 1.0;
+  params.target_pull_out_acc_mps2 = 0.5;
+  params.max_speed_mps = 5.0;
+  return params;
+}
+
+void expect_same_points(
+  const std::vector<NewTrajectory> & expected, const std::vector<NewTrajectory> & actual)
+{
+  ASSERT_EQ(expected.size(), actual.size());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    if (
+      const auto divergence =
+        reference::find_first_divergence(expected[i].points, actual[i].points)) {
+      ADD_FAILURE() << "candidate " << i << ": " << *divergence;
+    }
+  }
+}
+}  // namespace
+
+TEST(CandidateBatchTest, AssignAndCopyBack)
+{
+  const auto candidates = create_candidates();
+  CandidateBatch batch;
+  batch.assign(candidates);
+  ASSERT_EQ(batch.num_candidates(), candidates.size());
+  size_t num_points = 0;
+  for (size_t i = 0; i < candidates.size(); ++i) {
+    EXPECT_EQ(batch.offsets()[i], num_points);
+    EXPECT_EQ(batch.size(i), candidates[i].points.size());
+    num_points += candidates[i].points.size();
+  }
+  EXPECT_EQ(batch.num_points(), num_points);
+
+  auto copied = candidates;
+  for (auto & candidate : copied) {
+    candidate.points.clear();
+  }
+  batch.copy_to(copied);
+  expect_same_points(candidates, copied);
+
+  batch.assign({});
+  EXPECT_EQ(batch.num_candidates(), 0u);
+  EXPECT_EQ(batch.num_points(), 0u);
+}
+
+TEST(CandidateBatchTest, KernelsMatchThePerCandidateUtils)
+{
+  auto expected = create_candidates();
+  for (auto & candidate : expected) {
+    auto & points = candidate.points;
+    points.erase(
+      std::remove_if(
+        points.begin(), points.end(), [](const auto & p) { return !utils::validate_point(p); }),
+      points.end());
+    utils::clamp_velocities(points, 1.0f, 0.5f);
+    utils::set_max_velocity(points, 5.0f);
+  }
+
+  auto candidates = create_candidates();
+  CandidateBatch batch;
+  batch.assign(candidates);
+  batch.remove_non_finite_points();
+  batch.clamp_velocities(1.0f, 0.5f);
+  batch.set_max_velocity(5.0f);
+  batch.copy_to(candidates);
+  expect_same_points(expected, candidates);
+}
+
+TEST(CandidateBatchTest, ElementWisePipelineRunsOnTheBatch)
+{
+  const auto params = create_params();
+  Pipeline<stages::EngageSpeedClamp, stages::MaxSpeedLimit, stages::ValidPointFilter> pipeline{};
+  auto expected = create_candidates();
+  for (auto & candidate : expected) {
+    pipeline.optimize_trajectory(candidate.points, params);
+  }
+
+  auto candidates = create_candidates();
+  CandidateBatch batch;
+  batch.assign(candidates);
+  pipeline.optimize_trajectories(batch, params);
+  batch.copy_to(candidates);
+  expect_same_points(expected, candidates);
+}
@@ -0,0 +1,152 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/trajectory_optimizer/candidate_clustering.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+using autoware::trajectory_optimizer::CandidateClusters;
+using autoware::trajectory_optimizer::NewTrajectory;
+using autoware::trajectory_optimizer::TrajectoryPoint;
+using autoware::trajectory_optimizer::cluster_candidates;
+using autoware::trajectory_optimizer::compute_max_deviation;
+using autoware::trajectory_optimizer::project_onto_representative;
+
+namespace
+{
+// points along the x axis from start_m to end_m every interval_m, at y = offset_m, moving at x m/s
+std::vector<TrajectoryPoint> create_line(
+  const double start_m, const double end_m, const double interval_m, const double offset_m = 0.0)
+{
+  std::vector<TrajectoryPoint> points;
+  for (double x = start_m; x <= end_m + 1e-9; x += interval_m) {
+    TrajectoryPoint point;
+    point.pose.position.x = x;
+    point.pose.position.y = offset_m;
+    point.longitudinal_velocity_mps = static_cast<float>(x);
+    points.push_back(point);
+  }
+  return points;
+}
+
+// points on a left turn of the given radius, starting at the origin along the x axis
+std::vector<TrajectoryPoint> create_arc(
+  const size_t num_points, const double interval_m, const double radius,
+  const double offset_m = 0.0)
+{
+  std::vector<TrajectoryPoint> points(num_points);
+  for (size_t i = 0; i < num_points; ++i) {
+    const double angle = interval_m * static_cast<double>(i) / radius;
+    points[i].pose.position.x = (radius - offset_m) * std::sin(angle);
+    points[i].pose.position.y = radius - (radius - offset_m) * std::cos(angle);
+  }
+  return points;
+}
+
+NewTrajectory create_candidate(const std::vector<TrajectoryPoint> & points)
+{
+  NewTrajectory candidate;
+  candidate.points = points;
+  return candidate;
+}
+}  // namespace
+
+TEST(CandidateClusteringTest, MaxDeviationIsSymmetricAndIndependentOfTheResolution)
+{
+  const auto line = create_line(0.0, 10.0, 1.0);
+  EXPECT_NEAR(compute_max_deviation(line, create_line(0.0, 10.0, 0.25, 0.05)), 0.05, 1e-9);
+  EXPECT_NEAR(compute_max_deviation(create_line(0.0, 10.0, 0.25, 0.05), line), 0.05, 1e-9);
+  // the tail of the longer path is far from the end of the shorter one, either way round
+  EXPECT_NEAR(compute_max_deviation(line, create_line(0.0, 13.0, 1.0)), 3.0, 1e-9);
+  EXPECT_NEAR(compute_max_deviation(create_line(0.0, 13.0, 1.0), line), 3.0, 1e-9);
+  EXPECT_NEAR(compute_max_deviation(line, create_line(2.0, 10.0, 1.0)), 2.0, 1e-9);
+  EXPECT_NEAR(
+    compute_max_deviation(create_arc(41, 0.5, 15.0), create_arc(81, 0.25, 15.0)), 0.0, 1e-2);
+
+  // stops early, with a value above the bound
+  EXPECT_GT(compute_max_deviation(line, create_line(0.0, 10.0, 1.0, 0.5), 0.1), 0.1);
+
+  const auto infinity = std::numeric_limits<double>::infinity();
+  EXPECT_EQ(compute_max_deviation(line, {}), infinity);
+  auto invalid = create_line(0.0, 10.0, 1.0);
+  invalid[4].pose.position.x = std::numeric_limits<double>::quiet_NaN();
+  // invalid points never match, whichever path they are on
+  EXPECT_GT(compute_max_deviation(line, invalid, 1.0), 1.0);
+  EXPECT_GT(compute_max_deviation(invalid, line, 1.0), 1.0);
+}
+
+TEST(CandidateClusteringTest, ClustersBundlesGreedilyInInputOrder)
+{
+  std::vector<NewTrajectory> candidates;
+  candidates.push_back(create_candidate(create_line(0.0, 20.0, 1.0)));
+  candidates.push_back(create_candidate(create_line(0.0, 20.0, 0.5, 0.05)));
+  candidates.push_back(create_candidate(create_arc(40, 0.5, 10.0)));
+  candidates.push_back(create_candidate(create_line(0.0, 20.0, 1.0, -0.04)));
+  candidates.push_back(create_candidate(create_arc(40, 0.5, 10.0, 0.03)));
+  candidates.push_back(create_candidate(create_line(0.0, 0.0, 1.0)));
+  // within tolerance of the second candidate only, which is not a representative
+  candidates.push_back(create_candidate(create_line(0.0, 20.0, 1.0, 0.12)));
+
+  CandidateClusters clusters;
+  cluster_candidates(candidates, 0.1, clusters);
+  EXPECT_EQ(clusters.representative_of, (std::vector<size_t>{0, 0, 2, 0, 2, 5, 6}));
+  EXPECT_EQ(clusters.num_clusters, 4u);
+
+  // reused across cycles
+  candidates.resize(2);
+  cluster_candidates(candidates, 0.01, clusters);
+  EXPECT_EQ(clusters.representative_of, (std::vector<size_t>{0, 1}));
+  EXPECT_EQ(clusters.num_clusters, 2u);
+}
+
+TEST(CandidateClusteringTest, ProjectionKeepsTheRepresentativePathAndTheMemberVelocities)
+{
+  // the optimized representative, with ego history before the start of the candidates and
+  // extending past the end of the member
+  auto representative = create_line(-1.0, 11.0, 0.5);
+  for (auto & point : representative) {
+    point.longitudinal_velocity_mps = 1.0f;
+    point.heading_rate_rps = 0.25f;
+  }
+  auto member = create_line(0.0, 10.0, 1.0, 0.05);
+  for (auto & point : member) {
+    point.acceleration_mps2 = 0.5f;
+  }
+  project_onto_representative(representative, member);
+
+  ASSERT_EQ(member.size(), representative.size());
+  for (size_t i = 0; i < member.size(); ++i) {
+    const double x = representative[i].pose.position.x;
+    EXPECT_EQ(member[i].pose.position.x, x);
+    EXPECT_EQ(member[i].pose.position.y, 0.0);
+    EXPECT_EQ(member[i].heading_rate_rps, 0.25f);
+    if (x < 0.0) {
+      EXPECT_EQ(member[i].longitudinal_velocity_mps, 1.0f) << x;
+      EXPECT_EQ(member[i].acceleration_mps2, 0.0f) << x;
+    } else {
+      EXPECT_NEAR(member[i].longitudinal_velocity_mps, std::min(x, 10.0), 1e-5) << x;
+      EXPECT_EQ(member[i].acceleration_mps2, 0.5f) << x;
+    }
+  }
+
+  // a member without points takes the representative as is
+  std::vector<TrajectoryPoint> empty;
+  project_onto_representative(representative, empty);
+  EXPECT_EQ(empty.size(), representative.size());
+}
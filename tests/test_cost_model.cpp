@@ -0,0 +1,191 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/trajectory_optimizer/cost_model.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <vector>
+
+using autoware::trajectory_optimizer::CandidateCostModel;
+using autoware::trajectory_optimizer::CandidateFeatures;
+using autoware::trajectory_optimizer::CandidateSchedule;
+using autoware::trajectory_optimizer::NewTrajectory;
+using autoware::trajectory_optimizer::OnlineCostRegression;
+using autoware::trajectory_optimizer::TrajectoryPoint;
+using autoware::trajectory_optimizer::compute_candidate_features;
+using autoware::trajectory_optimizer::list_schedule_makespan;
+using autoware::trajectory_optimizer::order_longest_first;
+
+namespace
+{
+// num_points points on an arc of the given radius, every interval_m, or on a line if radius is 0
+std::vector<TrajectoryPoint> create_arc(
+  const size_t num_points, const double interval_m, const double radius)
+{
+  std::vector<TrajectoryPoint> points(num_points);
+  for (size_t i = 0; i < num_points; ++i) {
+    const double s = interval_m * static_cast<double>(i);
+    if (radius == 0.0) {
+      points[i].pose.position.x = s;
+    } else {
+      points[i].pose.position.x = radius * std::sin(s / radius);
+      points[i].pose.position.y = radius * (1.0 - std::cos(s / radius));
+    }
+  }
+  return points;
+}
+
+// stage times that depend on the shape as the fixer and the EB smoother do
+double fixer_ms(const CandidateFeatures & features)
+{
+  return 0.05 + 0.002 * static_cast<double>(features.num_points);
+}
+
+double smoother_ms(const CandidateFeatures & features)
+{
+  return 0.5 + 0.02 * features.arc_length_m + 1.5 * features.total_turning_rad;
+}
+}  // namespace
+
+TEST(CostModelTest, FeaturesOfLinesAndArcs)
+{
+  const auto line = compute_candidate_features(create_arc(11, 1.0, 0.0));
+  EXPECT_EQ(line.num_points, 11u);
+  EXPECT_NEAR(line.arc_length_m, 10.0, 1e-9);
+  EXPECT_NEAR(line.total_turning_rad, 0.0, 1e-9);
+  EXPECT_NEAR(line.max_curvature, 0.0, 1e-9);
+
+  // a quarter circle of radius 10, chords of a fine arc
+  const double quarter_m = 0.5 * M_PI * 10.0;
+  const auto arc = compute_candidate_features(create_arc(101, quarter_m / 100.0, 10.0));
+  EXPECT_NEAR(arc.arc_length_m, quarter_m, 1e-3);
+  EXPECT_NEAR(arc.total_turning_rad, 0.5 * M_PI, 0.02);
+  EXPECT_NEAR(arc.max_curvature, 0.1, 1e-3);
+
+  // duplicated points add no length and no heading change
+  auto points = create_arc(11, 1.0, 0.0);
+  points.insert(points.begin() + 5, points[5]);
+  const auto duplicated = compute_candidate_features(points);
+  EXPECT_NEAR(duplicated.arc_length_m, 10.0, 1e-9);
+  EXPECT_NEAR(duplicated.max_curvature, 0.0, 1e-9);
+
+  EXPECT_EQ(compute_candidate_features({}).num_points, 0u);
+}
+
+TEST(CostModelTest, RegressionConvergesToALinearCost)
+{
+  OnlineCostRegression regression(1.0);
+  EXPECT_EQ(regression.predict(CandidateFeatures{}), 0.0);
+  std::mt19937_64 random(0);
+  std::uniform_int_distribution<size_t> num_points(20, 400);
+  std::uniform_real_distribution<double> radius(0.0, 30.0);
+  for (size_t i = 0; i < 200; ++i) {
+    const auto features =
+      compute_candidate_features(create_arc(num_points(random), 0.5, 10.0 + radius(random)));
+    regression.update(features, smoother_ms(features));
+  }
+  for (const double radius_m : {0.0, 8.0, 50.0}) {
+    const auto features = compute_candidate_features(create_arc(150, 0.5, radius_m));
+    EXPECT_NEAR(regression.predict(features), smoother_ms(features), 0.05) << radius_m;
+  }
+}
+
+TEST(CostModelTest, ForgettingFollowsACostChange)
+{
+  OnlineCostRegression regression(0.9);
+  const auto short_features = compute_candidate_features(create_arc(40, 0.5, 0.0));
+  const auto long_features = compute_candidate_features(create_arc(300, 0.5, 0.0));
+  for (size_t i = 0; i < 100; ++i) {
+    regression.update(short_features, 1.0);
+    regression.update(long_features, 3.0);
+  }
+  EXPECT_NEAR(regression.predict(long_features), 3.0, 1e-3);
+  // e.g. a smoother enabled at runtime
+  for (size_t i = 0; i < 100; ++i) {
+    regression.update(short_features, 2.0);
+    regression.update(long_features, 9.0);
+  }
+  EXPECT_NEAR(regression.predict(short_features), 2.0, 1e-2);
+  EXPECT_NEAR(regression.predict(long_features), 9.0, 1e-2);
+}
+
+TEST(CostModelTest, OrderLongestFirstKeepsTiesInInputOrder)
+{
+  std::vector<size_t> order;
+  order_longest_first({1.0, 3.0, 0.0, 3.0, 2.0}, order);
+  EXPECT_EQ(order, (std::vector<size_t>{1, 3, 4, 0, 2}));
+  order_longest_first({0.0, 0.0, 0.0}, order);
+  EXPECT_EQ(order, (std::vector<size_t>{0, 1, 2}));
+}
+
+TEST(CostModelTest, ScheduleLearnsPerStageAndShortensTheMakespan)
+{
+  // a few long, curved candidates among many short straight ones, the long ones last as
+  // generators tend to emit their fallback candidates
+  std::vector<NewTrajectory> candidates;
+  std::mt19937_64 random(1);
+  std::uniform_int_distribution<size_t> num_points(30, 60);
+  for (size_t i = 0; i < 13; ++i) {
+    NewTrajectory candidate;
+    candidate.points = create_arc(num_points(random), 0.5, 0.0);
+    candidates.push_back(candidate);
+  }
+  for (size_t i = 0; i < 3; ++i) {
+    NewTrajectory candidate;
+    candidate.points = create_arc(300, 0.5, 6.0 + 2.0 * static_cast<double>(i));
+    candidates.push_back(candidate);
+  }
+
+  CandidateCostModel model(0.99);
+  CandidateSchedule schedule;
+  model.schedule(candidates, schedule);
+  ASSERT_EQ(schedule.order.size(), candidates.size());
+  EXPECT_EQ(schedule.predicted_ms[0], 0.0);
+  EXPECT_TRUE(std::isnan(schedule.actual_ms[0]));
+  std::vector<size_t> input_order(candidates.size());
+  std::iota(input_order.begin(), input_order.end(), size_t{0});
+  EXPECT_EQ(schedule.order, input_order);
+
+  std::vector<double> actual_ms(candidates.size());
+  for (size_t cycle = 0; cycle < 5; ++cycle) {
+    for (size_t i = 0; i < candidates.size(); ++i) {
+      const auto & features = schedule.features[i];
+      model.update("trajectory_point_fixer", features, fixer_ms(features));
+      model.update("eb_smoother_optimizer", features, smoother_ms(features));
+      actual_ms[i] = fixer_ms(features) + smoother_ms(features);
+    }
+    model.schedule(candidates, schedule);
+  }
+  for (size_t i = 0; i < candidates.size(); ++i) {
+    EXPECT_NEAR(schedule.predicted_ms[i], actual_ms[i], 0.05 * actual_ms[i]) << i;
+  }
+  for (size_t rank = 0; rank < 3; ++rank) {
+    EXPECT_GE(schedule.order[rank], 13u);
+  }
+
+  constexpr size_t num_workers = 4;
+  const double total_ms = std::accumulate(actual_ms.begin(), actual_ms.end(), 0.0);
+  const double longest_first_ms = list_schedule_makespan(actual_ms, schedule.order, num_workers);
+  const double input_order_ms = list_schedule_makespan(actual_ms, input_order, num_workers);
+  EXPECT_LT(longest_first_ms, input_order_ms);
+  const double longest_ms = *std::max_element(actual_ms.begin(), actual_ms.end());
+  const double lower_bound_ms = std::max(longest_ms, total_ms / num_workers);
+  EXPECT_LE(longest_first_ms, 4.0 / 3.0 * lower_bound_ms + 1e-9);
+}
@@ -0,0 +1,100 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/trajectory_optimizer/cycle_capture.hpp"
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using autoware::trajectory_optimizer::CycleCapture;
+using autoware::trajectory_optimizer::CycleCaptureParams;
+using autoware::trajectory_optimizer::ScopedStageTimer;
+using autoware::trajectory_optimizer::SlowCycleRecorder;
+using autoware::trajectory_optimizer::StageTimings;
+
+TEST(CycleCaptureTest, RateLimitsCaptures)
+{
+  CycleCaptureParams params;
+  params.threshold_ms = 50.0;
+  params.min_interval_s = 1.0;
+  params.max_captures = 2;
+  params.directory = std::filesystem::temp_directory_path().string();
+  SlowCycleRecorder recorder(params, "/trajectory_optimizer", rclcpp::get_logger("test"));
+
+  const auto start = std::chrono::steady_clock::now();
+  EXPECT_FALSE(recorder.should_capture(10.0, start));
+  EXPECT_TRUE(recorder.should_capture(60.0, start));
+  // too soon after the previous capture
+  EXPECT_FALSE(recorder.should_capture(60.0, start + std::chrono::milliseconds(500)));
+  EXPECT_TRUE(recorder.should_capture(60.0, start + std::chrono::seconds(2)));
+  // the capture budget is spent
+  EXPECT_FALSE(recorder.should_capture(60.0, start + std::chrono::seconds(10)));
+}
+
+TEST(CycleCaptureTest, TimesStages)
+{
+  StageTimings timings;
+  {
+    const ScopedStageTimer timer(&timings, "stage");
+  }
+  {
+    const ScopedStageTimer timer(nullptr, "ignored");
+  }
+  const auto times = timings.take();
+  ASSERT_EQ(times.size(), 1u);
+  EXPECT_EQ(times.front().second.calls, 1u);
+  EXPECT_GE(times.front().second.total_ms, 0.0);
+}
+
+TEST(CycleCaptureTest, WritesParametersThatCanBeLoadedBack)
+{
+  CycleCapture capture;
+  capture.topic_prefix = "/trajectory_optimizer/";
+  capture.cycle_id = 3;
+  capture.stamp = rclcpp::Time(10, 0);
+  capture.processing_time_ms = 120.0;
+  capture.parameters = {
+    rclcpp::Parameter("max_speed_mps", 10.0), rclcpp::Parameter("num_worker_threads", 2),
+    rclcpp::Parameter("server_mode.stream_namespaces", std::vector<std::string>{"ego"}),
+    rclcpp::Parameter("empty", std::vector<int64_t>{})};
+  capture.stage_timings = {{"stage", StageTimings::StageTime{2, 1.5}}};
+  capture.ego_history_points.resize(3);
+
+  const auto directory =
+    std::filesystem::temp_directory_path() / ("test_cycle_capture_" + std::to_string(getpid()));
+  const auto path = SlowCycleRecorder::write_capture(
+    capture, directory.string(), "/planning/trajectory_optimizer");
+
+  std::ifstream parameters_file(std::filesystem::path(path) / "parameters.yaml");
+  std::stringstream parameters;
+  parameters << parameters_file.rdbuf();
+  EXPECT_EQ(
+    parameters.str(),
+    "/planning/trajectory_optimizer:\n"
+    "  ros__parameters:\n"
+    "    max_speed_mps: 10.0\n"
+    "    num_worker_threads: 2\n"
+    "    server_mode.stream_namespaces: [\"ego\"]\n"
+    "    # empty: not set or empty\n");
+  EXPECT_TRUE(std::filesystem::exists(std::filesystem::path(path) / "timings.yaml"));
+  EXPECT_TRUE(std::filesystem::exists(std::filesystem::path(path) / "inputs"));
+  std::filesystem::remove_all(directory);
+}
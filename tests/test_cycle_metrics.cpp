@@ -0,0 +1,64 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/trajectory_optimizer/cycle_metrics.hpp"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <limits>
+
+using autoware::trajectory_optimizer::apply_thresholds;
+using autoware::trajectory_optimizer::CycleMetrics;
+using autoware::trajectory_optimizer::CycleMetricsThresholds;
+using autoware::trajectory_optimizer::ThroughputMeter;
+
+TEST(CycleMetricsTest, RatesCoverTheWindowOnly)
+{
+  ThroughputMeter meter(2.0);
+  const auto start = std::chrono::steady_clock::now();
+  meter.add(start, 4);
+  meter.add(start + std::chrono::milliseconds(500), 4);
+  meter.add(start + std::chrono::milliseconds(1000), 2);
+  EXPECT_DOUBLE_EQ(meter.cycles_per_second(), 1.5);
+  EXPECT_DOUBLE_EQ(meter.candidates_per_second(), 5.0);
+
+  // the first two cycles leave the window
+  meter.add(start + std::chrono::milliseconds(2500), 2);
+  EXPECT_DOUBLE_EQ(meter.cycles_per_second(), 1.0);
+  EXPECT_DOUBLE_EQ(meter.candidates_per_second(), 2.0);
+}
+
+TEST(CycleMetricsTest, WarnsOnExceededThresholds)
+{
+  CycleMetricsThresholds thresholds;
+  thresholds.max_input_age_ms = 100.0;
+  thresholds.max_processing_time_ms = 50.0;
+
+  CycleMetrics metrics;
+  metrics.input_age_ms = 20.0;
+  metrics.processing_time_ms = 10.0;
+  // disabled threshold
+  metrics.output_age_ms = 1000.0;
+  metrics.queueing_delay_ms = std::numeric_limits<double>::quiet_NaN();
+  EXPECT_FALSE(apply_thresholds(thresholds, metrics));
+  EXPECT_EQ(metrics.level, CycleMetrics::OK);
+  EXPECT_TRUE(metrics.message.empty());
+
+  metrics.input_age_ms = 150.0;
+  metrics.processing_time_ms = 60.0;
+  EXPECT_TRUE(apply_thresholds(thresholds, metrics));
+  EXPECT_EQ(metrics.level, CycleMetrics::WARN);
+  EXPECT_EQ(metrics.message, "input age 150.0 ms > 100.0 ms, processing time 60.0 ms > 50.0 ms");
+}
@@ -0,0 +1,254 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Differential tests of the utils kernels: every production kernel is run next to its frozen
+// reference in tests/reference on the same inputs, and the first point and field where the outputs
+// diverge is reported. The kernels are deterministic and the references are verbatim copies, so
+// the default tolerance is exact; a rewrite that changes the floating point evaluation order
+// states its tolerance here.
+
+#include "autoware/trajectory_optimizer/scenario_generator.hpp"
+#include "autoware/trajectory_optimizer/static_pipeline.hpp"
+#include "autoware/trajectory_optimizer/trajectory_optimizer_structs.hpp"
+#include "autoware/trajectory_optimizer/utils.hpp"
+#include "reference/differential.hpp"
+#include "reference/reference_utils.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+using autoware::trajectory_optimizer::Odometry;
+using autoware::trajectory_optimizer::TrajectoryOptimizerParams;
+namespace pipeline = autoware::trajectory_optimizer::pipeline;
+namespace reference = autoware::trajectory_optimizer::reference;
+namespace scenarios = autoware::trajectory_optimizer::scenarios;
+namespace utils = autoware::trajectory_optimizer::utils;
+
+namespace
+{
+constexpr uint64_t num_seeds = 50;
+
+struct Input
+{
+  std::string name;
+  reference::TrajectoryPoints points;
+  Odometry odometry;
+  reference::TrajectoryPoints ego_history_points;
+};
+
+// the scenario corpus, clean and with every defect, over num_seeds seeds, plus the edge cases
+std::vector<Input> make_inputs()
+{
+  std::vector<Input> inputs;
+  for (uint64_t seed = 0; seed < num_seeds; ++seed) {
+    scenarios::ScenarioGenerator generator(seed);
+    for (const auto type : scenarios::all_scenario_types()) {
+      scenarios::ScenarioParams params;
+      params.type = type;
+      // the odd seeds draw defects, alternating point spacings
+      if (seed % 2 == 1) {
+        params.point_interval_m = seed % 4 == 1 ? 0.1 : 2.0;
+        params.defects.position_noise_stddev_m = 0.05;
+        params.defects.yaw_noise_stddev_rad = 0.05;
+        params.defects.velocity_noise_stddev_mps = 0.2;
+        params.defects.duplicate_point_ratio = 0.1;
+        params.defects.invalid_point_ratio = 0.05;
+      }
+      auto scenario = generator.generate(params);
+      inputs.push_back(
+        {scenarios::to_string(type) + " seed " + std::to_string(seed),
+         std::move(scenario.trajectory), scenario.odometry,
+         std::move(scenario.ego_history_points)});
+    }
+  }
+  for (auto & [name, points] : reference::make_edge_cases()) {
+    Odometry odometry;
+    if (!points.empty()) {
+      odometry.pose.pose = points.front().pose;
+    }
+    inputs.push_back({name, std::move(points), odometry, {}});
+  }
+  return inputs;
+}
+
+const std::vector<Input> & inputs()
+{
+  static const auto inputs = make_inputs();
+  return inputs;
+}
+
+TrajectoryOptimizerParams make_params()
+{
+  TrajectoryOptimizerParams params;
+  params.spline_interpolation_resolution_m = 0.5;
+  params.backward_trajectory_extension_m = 10.0;
+  params.nearest_dist_threshold_m = 1.5;
+  params.nearest_yaw_threshold_rad = 1.0;
+  return params;
+}
+
+// runs both kernels on a copy of the points and reports the first divergence
+template <typename ReferenceKernel, typename ProductionKernel>
+void expect_same_output(
+  const ReferenceKernel & reference_kernel, const ProductionKernel & production_kernel,
+  const reference::Tolerance & tolerance = reference::Tolerance{})
+{
+  for (const auto & input : inputs()) {
+    auto reference_points = input.points;
+    auto production_points = input.points;
+    reference_kernel(input, reference_points);
+    production_kernel(input, production_points);
+    if (
+      const auto divergence =
+        reference::find_first_divergence(reference_points, production_points, tolerance)) {
+      ADD_FAILURE() << input.name << ": " << *divergence;
+      return;
+    }
+  }
+}
+}  // namespace
+
+TEST(DifferentialTest, HarnessReportsTheFirstDivergence)
+{
+  reference::TrajectoryPoints points(3);
+  auto other = points;
+  EXPECT_FALSE(reference::find_first_divergence(points, other));
+
+  other[1].pose.position.y = 0.1;
+  other[2].longitudinal_velocity_mps = 1.0f;
+  const auto divergence = reference::find_first_divergence(points, other);
+  ASSERT_TRUE(divergence);
+  EXPECT_NE(divergence->find("point 1"), std::string::npos) << *divergence;
+  EXPECT_NE(divergence->find("pose.position.y"), std::string::npos) << *divergence;
+
+  reference::Tolerance tolerance;
+  tolerance.position_m = 0.2;
+  const auto within_tolerance = reference::find_first_divergence(points, other, tolerance);
+  ASSERT_TRUE(within_tolerance);
+  EXPECT_NE(within_tolerance->find("longitudinal_velocity_mps"), std::string::npos);
+
+  points[0].pose.position.x = std::numeric_limits<double>::quiet_NaN();
+  other = points;
+  EXPECT_FALSE(reference::find_first_divergence(points, other));
+
+  other.pop_back();
+  EXPECT_TRUE(reference::find_first_divergence(points, other));
+}
+
+TEST(DifferentialTest, ValidatePoint)
+{
+  for (const auto & input : inputs()) {
+    for (size_t i = 0; i < input.points.size(); ++i) {
+      ASSERT_EQ(
+        reference::validate_point(input.points[i]), utils::validate_point(input.points[i]))
+        << input.name << ": point " << i;
+    }
+  }
+}
+
+TEST(DifferentialTest, RemoveCloseProximityPoints)
+{
+  for (const double min_dist : {1e-2, 0.5}) {
+    expect_same_output(
+      [&](const Input &, reference::TrajectoryPoints & points) {
+        reference::remove_close_proximity_points(points, min_dist);
+      },
+      [&](const Input &, reference::TrajectoryPoints & points) {
+        utils::remove_close_proximity_points(points, min_dist);
+      });
+  }
+}
+
+TEST(DifferentialTest, RemoveInvalidPoints)
+{
+  expect_same_output(
+    [](const Input &, reference::TrajectoryPoints & points) {
+      reference::remove_invalid_points(points);
+    },
+    [](const Input &, reference::TrajectoryPoints & points) {
+      utils::remove_invalid_points(points);
+    });
+}
+
+TEST(DifferentialTest, ValidPointFilterStage)
+{
+  const auto params = make_params();
+  pipeline::Pipeline<pipeline::stages::ValidPointFilter> filter{};
+  expect_same_output(
+    [](const Input &, reference::TrajectoryPoints & points) {
+      points.erase(
+        std::remove_if(
+          points.begin(), points.end(),
+          [](const auto & point) { return !reference::validate_point(point); }),
+        points.end());
+    },
+    [&](const Input &, reference::TrajectoryPoints & points) {
+      filter.optimize_trajectory(points, params);
+    });
+}
+
+TEST(DifferentialTest, ApplySpline)
+{
+  for (const double resolution : {0.1, 0.5, 1.0}) {
+    auto params = make_params();
+    params.spline_interpolation_resolution_m = resolution;
+    const auto reference_kernel = [&](const Input &, reference::TrajectoryPoints & points) {
+      reference::apply_spline(points, params);
+    };
+    expect_same_output(reference_kernel, [&](const Input &, reference::TrajectoryPoints & points) {
+      utils::apply_spline(points, params);
+    });
+    // a scratch buffer reused across inputs must not leak into the output
+    reference::TrajectoryPoints output_points;
+    expect_same_output(reference_kernel, [&](const Input &, reference::TrajectoryPoints & points) {
+      utils::apply_spline(points, params, output_points);
+    });
+  }
+}
+
+TEST(DifferentialTest, AddEgoStateToTrajectory)
+{
+  const auto params = make_params();
+  // the input points play the part of the previous ego states
+  expect_same_output(
+    [&](const Input & input, reference::TrajectoryPoints & points) {
+      reference::add_ego_state_to_trajectory(points, input.odometry, params);
+    },
+    [&](const Input & input, reference::TrajectoryPoints & points) {
+      utils::add_ego_state_to_trajectory(points, input.odometry, params);
+    });
+}
+
+TEST(DifferentialTest, ExpandTrajectoryWithEgoHistory)
+{
+  for (const double extension_m : {5.0, 30.0}) {
+    auto params = make_params();
+    params.backward_trajectory_extension_m = extension_m;
+    expect_same_output(
+      [&](const Input & input, reference::TrajectoryPoints & points) {
+        reference::expand_trajectory_with_ego_history(
+          points, input.ego_history_points, input.odometry, params);
+      },
+      [&](const Input & input, reference::TrajectoryPoints & points) {
+        utils::expand_trajectory_with_ego_history(
+          points, input.ego_history_points, input.odometry, params);
+      });
+  }
+}
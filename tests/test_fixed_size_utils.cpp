@@ -0,0 +1,169 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/trajectory_optimizer/fixed_size_utils.hpp"
+#include "autoware/trajectory_optimizer/scenario_generator.hpp"
+#include "autoware/trajectory_optimizer/trajectory_optimizer_structs.hpp"
+#include "autoware/trajectory_optimizer/utils.hpp"
+#include "reference/differential.hpp"
+#include "reference/reference_utils.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+using autoware::trajectory_optimizer::TrajectoryOptimizerParams;
+namespace fixed_size = autoware::trajectory_optimizer::utils::fixed_size;
+namespace reference = autoware::trajectory_optimizer::reference;
+namespace scenarios = autoware::trajectory_optimizer::scenarios;
+namespace utils = autoware::trajectory_optimizer::utils;
+
+namespace
+{
+constexpr size_t fixed_points = 80;
+constexpr auto infinity = std::numeric_limits<float>::infinity();
+
+// candidates of a fixed-size generator, alone and behind a few ego history points, with and
+// without defects, and trajectories shorter than every fixed size
+std::vector<std::pair<std::string, reference::TrajectoryPoints>> make_inputs()
+{
+  std::vector<std::pair<std::string, reference::TrajectoryPoints>> inputs;
+  TrajectoryOptimizerParams extender_params;
+  extender_params.backward_trajectory_extension_m = 10.0;
+  for (uint64_t seed = 0; seed < 20; ++seed) {
+    scenarios::ScenarioGenerator generator(seed);
+    for (const auto type : scenarios::all_scenario_types()) {
+      scenarios::ScenarioParams params;
+      params.type = type;
+      params.num_points = fixed_points;
+      params.point_interval_m = 0.5;
+      if (seed % 2 == 1) {
+        params.defects.duplicate_point_ratio = 0.02;
+        params.defects.invalid_point_ratio = 0.02;
+      }
+      auto scenario = generator.generate(params);
+      const auto name = scenarios::to_string(type) + " seed " + std::to_string(seed);
+      inputs.emplace_back(name, scenario.trajectory);
+
+      auto extended = scenario.trajectory;
+      utils::expand_trajectory_with_ego_history(
+        extended, scenario.ego_history_points, scenario.odometry, extender_params);
+      inputs.emplace_back(name + " extended", std::move(extended));
+
+      scenario.trajectory.resize(fixed_points / 2);
+      inputs.emplace_back(name + " short", std::move(scenario.trajectory));
+    }
+  }
+  return inputs;
+}
+
+const std::vector<std::pair<std::string, reference::TrajectoryPoints>> & inputs()
+{
+  static const auto inputs = make_inputs();
+  return inputs;
+}
+}  // namespace
+
+TEST(FixedSizeUtilsTest, VisitTailTakesTheFirstSizeThatFits)
+{
+  std::vector<int> values(100);
+  using Sizes = std::index_sequence<80, 40>;
+  const auto visit = [&](const size_t size) {
+    size_t head_size = 0;
+    size_t tail_size = 0;
+    fixed_size::visit_tail(
+      values.data(), size, Sizes{},
+      [&](const size_t head, const auto tail) {
+        head_size = head;
+        tail_size = tail.size();
+        EXPECT_EQ(tail.end(), values.data() + size);
+      },
+      [&] { tail_size = 0; });
+    return std::make_pair(head_size, tail_size);
+  };
+  EXPECT_EQ(visit(100), std::make_pair(size_t{20}, size_t{80}));
+  EXPECT_EQ(visit(80), std::make_pair(size_t{0}, size_t{80}));
+  EXPECT_EQ(visit(50), std::make_pair(size_t{10}, size_t{40}));
+  EXPECT_EQ(visit(39), std::make_pair(size_t{0}, size_t{0}));
+}
+
+TEST(FixedSizeUtilsTest, ValidAndApartImpliesNothingToRemove)
+{
+  constexpr double min_dist = 1e-2;
+  size_t num_valid_and_apart = 0;
+  for (const auto & [name, points] : inputs()) {
+    bool expected = points.size() >= fixed_points;
+    for (size_t i = 0; i < points.size(); ++i) {
+      expected &= reference::validate_point(points[i]);
+      if (i > 0) {
+        expected &= std::hypot(
+                      points[i].pose.position.x - points[i - 1].pose.position.x,
+                      points[i].pose.position.y - points[i - 1].pose.position.y) >= min_dist;
+      }
+    }
+    // the margin of the check is far below the spacing of the generated points
+    EXPECT_EQ(fixed_size::are_valid_and_apart(points, min_dist), expected) << name;
+    num_valid_and_apart += expected;
+  }
+  EXPECT_GT(num_valid_and_apart, 0u);
+}
+
+TEST(FixedSizeUtilsTest, RemoveInvalidPointsMatchesTheReference)
+{
+  for (const auto & [name, points] : inputs()) {
+    auto reference_points = points;
+    auto production_points = points;
+    reference::remove_invalid_points(reference_points);
+    utils::remove_invalid_points(production_points);
+    if (
+      const auto divergence =
+        reference::find_first_divergence(reference_points, production_points)) {
+      ADD_FAILURE() << name << ": " << *divergence;
+    }
+  }
+}
+
+TEST(FixedSizeUtilsTest, ClampVelocitiesMatchesTheSeparatePasses)
+{
+  struct Limits
+  {
+    float min_velocity;
+    float min_acceleration;
+    float max_velocity;
+  };
+  for (const auto limits :
+       {Limits{2.0f, 0.5f, 5.0f}, Limits{2.0f, 0.5f, infinity},
+        Limits{-infinity, -infinity, 5.0f}}) {
+    for (const auto & [name, points] : inputs()) {
+      auto expected = points;
+      if (limits.min_velocity > -infinity) {
+        utils::clamp_velocities(expected, limits.min_velocity, limits.min_acceleration);
+      }
+      if (limits.max_velocity < infinity) {
+        utils::set_max_velocity(expected, limits.max_velocity);
+      }
+      auto clamped = points;
+      fixed_size::clamp_velocities(
+        clamped, limits.min_velocity, limits.min_acceleration, limits.max_velocity);
+      if (const auto divergence = reference::find_first_divergence(expected, clamped)) {
+        ADD_FAILURE() << name << ": " << *divergence;
+      }
+    }
+  }
+}
@@ -0,0 +1,272 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/trajectory_optimizer/lazy_trajectories_view.hpp"
+
+#include <rclcpp/serialization.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using autoware::trajectory_optimizer::hash_points;
+using autoware::trajectory_optimizer::LazyTrajectoriesView;
+using autoware::trajectory_optimizer::select_candidates;
+using autoware::trajectory_optimizer::Trajectories;
+using autoware::trajectory_optimizer::TrajectoryPoints;
+
+namespace
+{
+autoware_new_planning_msgs::msg::Trajectory create_candidate(
+  const size_t num_points, const double offset, const double score)
+{
+  autoware_new_planning_msgs::msg::Trajectory trajectory;
+  trajectory.header.frame_id = "map";
+  trajectory.header.stamp.sec = 10;
+  trajectory.generator_id.uuid[0] = static_cast<uint8_t>(offset);
+  trajectory.score = score;
+  for (size_t i = 0; i < num_points; ++i) {
+    autoware_planning_msgs::msg::TrajectoryPoint point;
+    point.time_from_start.sec = static_cast<int32_t>(i);
+    point.pose.position.x = offset + static_cast<double>(i);
+    point.pose.orientation.w = 1.0;
+    point.longitudinal_velocity_mps = 2.0f;
+    point.rear_wheel_angle_rad = 0.1f;
+    trajectory.points.push_back(point);
+  }
+  return trajectory;
+}
+
+rclcpp::SerializedMessage serialize(const Trajectories & trajectories)
+{
+  rclcpp::SerializedMessage serialized_msg;
+  rclcpp::Serialization<Trajectories>().serialize_message(&trajectories, &serialized_msg);
+  return serialized_msg;
+}
+
+/**
+ * @brief Little-endian CDR writer with the alignment capped at max_alignment, relative to the end
+ * of the encapsulation, like the reader of the view.
+ */
+class CdrWriter
+{
+public:
+  CdrWriter(const uint8_t encapsulation_kind, const size_t max_alignment)
+  : buffer_{0x00, encapsulation_kind, 0x00, 0x00}, max_alignment_(max_alignment)
+  {
+  }
+
+  template <typename T>
+  void write(const T value)
+  {
+    const auto alignment = std::min(sizeof(T), max_alignment_);
+    while ((buffer_.size() - 4) % alignment != 0) {
+      buffer_.push_back(0);
+    }
+    write_bytes(&value, sizeof(T));
+  }
+
+  void write_bytes(const void * data, const size_t size)
+  {
+    const auto * bytes = static_cast<const uint8_t *>(data);
+    buffer_.insert(buffer_.end(), bytes, bytes + size);
+  }
+
+  void write_string(const std::string & value)
+  {
+    write(static_cast<uint32_t>(value.size() + 1));
+    write_bytes(value.c_str(), value.size() + 1);
+  }
+
+  rclcpp::SerializedMessage message() const
+  {
+    rclcpp::SerializedMessage serialized_msg(buffer_.size());
+    auto & rcl_msg = serialized_msg.get_rcl_serialized_message();
+    std::memcpy(rcl_msg.buffer, buffer_.data(), buffer_.size());
+    rcl_msg.buffer_length = buffer_.size();
+    return serialized_msg;
+  }
+
+private:
+  std::vector<uint8_t> buffer_;
+  size_t max_alignment_;
+};
+
+// encodes the message field by field, with encapsulation 0x01 and alignment 8 for plain CDR, or
+// encapsulation 0x07 and alignment 4 for XCDR2
+rclcpp::SerializedMessage encode(
+  const Trajectories & trajectories, const uint8_t encapsulation_kind, const size_t max_alignment)
+{
+  CdrWriter writer(encapsulation_kind, max_alignment);
+  writer.write(static_cast<uint32_t>(trajectories.trajectories.size()));
+  for (const auto & trajectory : trajectories.trajectories) {
+    writer.write(trajectory.header.stamp.sec);
+    writer.write(trajectory.header.stamp.nanosec);
+    writer.write_string(trajectory.header.frame_id);
+    writer.write_bytes(trajectory.generator_id.uuid.data(), trajectory.generator_id.uuid.size());
+    writer.write(static_cast<uint32_t>(trajectory.points.size()));
+    for (const auto & point : trajectory.points) {
+      writer.write(point.time_from_start.sec);
+      writer.write(point.time_from_start.nanosec);
+      writer.write(point.pose.position.x);
+      writer.write(point.pose.position.y);
+      writer.write(point.pose.position.z);
+      writer.write(point.pose.orientation.x);
+      writer.write(point.pose.orientation.y);
+      writer.write(point.pose.orientation.z);
+      writer.write(point.pose.orientation.w);
+      writer.write(point.longitudinal_velocity_mps);
+      writer.write(point.lateral_velocity_mps);
+      writer.write(point.acceleration_mps2);
+      writer.write(point.heading_rate_rps);
+      writer.write(point.front_wheel_angle_rad);
+      writer.write(point.rear_wheel_angle_rad);
+    }
+    writer.write(trajectory.score);
+  }
+  writer.write(static_cast<uint32_t>(trajectories.generator_info.size()));
+  for (const auto & generator_info : trajectories.generator_info) {
+    writer.write_bytes(
+      generator_info.generator_id.uuid.data(), generator_info.generator_id.uuid.size());
+    writer.write_string(generator_info.generator_name.data);
+  }
+  return writer.message();
+}
+
+std::vector<uint8_t> get_bytes(const rclcpp::SerializedMessage & serialized_msg)
+{
+  const auto & rcl_msg = serialized_msg.get_rcl_serialized_message();
+  return std::vector<uint8_t>(rcl_msg.buffer, rcl_msg.buffer + rcl_msg.buffer_length);
+}
+
+Trajectories create_trajectories()
+{
+  Trajectories trajectories;
+  // the frame id lengths vary the alignment of the point arrays
+  trajectories.trajectories.push_back(create_candidate(5, 0.0, 0.5));
+  trajectories.trajectories.push_back(create_candidate(0, 1.0, 0.9));
+  trajectories.trajectories.push_back(create_candidate(7, 2.0, 0.1));
+  trajectories.trajectories.back().header.frame_id = "base_link";
+  trajectories.trajectories.push_back(create_candidate(5, 0.0, 0.7));
+  trajectories.generator_info.resize(1);
+  trajectories.generator_info.front().generator_name.data = "generator";
+  return trajectories;
+}
+}  // namespace
+
+TEST(LazyTrajectoriesViewTest, DecodesCandidates)
+{
+  const auto trajectories = create_trajectories();
+  const auto serialized_msg = serialize(trajectories);
+
+  LazyTrajectoriesView view;
+  ASSERT_TRUE(view.parse(serialized_msg));
+  ASSERT_EQ(view.candidates().size(), trajectories.trajectories.size());
+  TrajectoryPoints points;
+  for (size_t i = 0; i < trajectories.trajectories.size(); ++i) {
+    const auto & expected = trajectories.trajectories[i];
+    const auto & candidate = view.candidates()[i];
+    EXPECT_EQ(candidate.header, expected.header);
+    EXPECT_EQ(candidate.generator_id, expected.generator_id);
+    EXPECT_DOUBLE_EQ(candidate.score, expected.score);
+    EXPECT_EQ(candidate.num_points, expected.points.size());
+    view.decode_points(i, points);
+    EXPECT_EQ(points, expected.points);
+  }
+
+  decltype(Trajectories::generator_info) generator_info;
+  ASSERT_TRUE(view.decode_generator_info(generator_info));
+  EXPECT_EQ(generator_info, trajectories.generator_info);
+}
+
+TEST(LazyTrajectoriesViewTest, HashesRawPointsLikeDecodedPoints)
+{
+  const auto trajectories = create_trajectories();
+  const auto serialized_msg = serialize(trajectories);
+
+  LazyTrajectoriesView view;
+  ASSERT_TRUE(view.parse(serialized_msg));
+  for (size_t i = 0; i < trajectories.trajectories.size(); ++i) {
+    EXPECT_EQ(view.hash_points(i), hash_points(trajectories.trajectories[i].points));
+  }
+  // candidates 0 and 3 only differ in score
+  EXPECT_EQ(view.hash_points(0), view.hash_points(3));
+  EXPECT_NE(view.hash_points(0), view.hash_points(2));
+}
+
+TEST(LazyTrajectoriesViewTest, FixtureEncoderMatchesTypeSupport)
+{
+  // the plain CDR output of the fixture encoder is checked against the type support, so that the
+  // XCDR2 output below only differs in the encapsulation and the alignment of 8-byte fields
+  const auto trajectories = create_trajectories();
+  EXPECT_EQ(get_bytes(encode(trajectories, 0x01, 8)), get_bytes(serialize(trajectories)));
+}
+
+TEST(LazyTrajectoriesViewTest, DecodesXcdr2Candidates)
+{
+  auto trajectories = create_trajectories();
+  // an odd number of 4-byte words before the points, which plain CDR would pad before the doubles
+  trajectories.trajectories.front().header.frame_id = "odom";
+  const auto serialized_msg = encode(trajectories, 0x07, 4);
+  ASSERT_NE(get_bytes(serialized_msg), get_bytes(encode(trajectories, 0x01, 8)));
+
+  LazyTrajectoriesView view;
+  ASSERT_TRUE(view.parse(serialized_msg));
+  ASSERT_EQ(view.candidates().size(), trajectories.trajectories.size());
+  TrajectoryPoints points;
+  for (size_t i = 0; i < trajectories.trajectories.size(); ++i) {
+    const auto & expected = trajectories.trajectories[i];
+    const auto & candidate = view.candidates()[i];
+    EXPECT_EQ(candidate.header, expected.header);
+    EXPECT_EQ(candidate.generator_id, expected.generator_id);
+    EXPECT_DOUBLE_EQ(candidate.score, expected.score);
+    EXPECT_EQ(candidate.num_points, expected.points.size());
+    view.decode_points(i, points);
+    EXPECT_EQ(points, expected.points);
+    EXPECT_EQ(view.hash_points(i), hash_points(expected.points));
+  }
+}
+
+TEST(LazyTrajectoriesViewTest, RejectsUnsupportedEncapsulation)
+{
+  const auto trajectories = create_trajectories();
+  LazyTrajectoriesView view;
+  // big-endian plain CDR
+  EXPECT_FALSE(view.parse(encode(trajectories, 0x00, 8)));
+  // little-endian parameter list CDR
+  EXPECT_FALSE(view.parse(encode(trajectories, 0x03, 8)));
+}
+
+TEST(LazyTrajectoriesViewTest, RejectsTruncatedBuffer)
+{
+  auto serialized_msg = serialize(create_trajectories());
+  serialized_msg.get_rcl_serialized_message().buffer_length = 40;
+  LazyTrajectoriesView view;
+  EXPECT_FALSE(view.parse(serialized_msg));
+}
+
+TEST(LazyTrajectoriesViewTest, SelectsBestUniqueCandidates)
+{
+  const std::vector<double> scores{0.5, 0.9, 0.1, 0.7};
+  const std::vector<uint64_t> hashes{1, 2, 3, 1};
+
+  EXPECT_EQ(select_candidates(scores, {}, 0), (std::vector<size_t>{0, 1, 2, 3}));
+  EXPECT_EQ(select_candidates(scores, {}, 2), (std::vector<size_t>{1, 3}));
+  EXPECT_EQ(select_candidates(scores, hashes, 0), (std::vector<size_t>{0, 1, 2}));
+  EXPECT_EQ(select_candidates(scores, hashes, 2), (std::vector<size_t>{0, 1}));
+}
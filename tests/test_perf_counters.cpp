@@ -0,0 +1,104 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/trajectory_optimizer/perf_counters.hpp"
+
+#include <gtest/gtest.h>
+
+using autoware::trajectory_optimizer::PerfCounterAggregator;
+using autoware::trajectory_optimizer::PerfCounterGroup;
+using autoware::trajectory_optimizer::PerfCounterValues;
+using autoware::trajectory_optimizer::ScopedStagePerfCounters;
+using autoware::trajectory_optimizer::scale_to_enabled_time;
+
+TEST(PerfCountersTest, AggregatesPerStage)
+{
+  PerfCounterAggregator aggregator;
+  aggregator.add("b_stage", PerfCounterValues{10, 20, 1, 2});
+  aggregator.add("a_stage", PerfCounterValues{1, 1, 1, 1});
+  aggregator.add("b_stage", PerfCounterValues{10, 20, 1, 2});
+
+  const auto totals = aggregator.take();
+  ASSERT_EQ(totals.size(), 2u);
+  EXPECT_EQ(totals[0].first, "a_stage");
+  EXPECT_EQ(totals[1].first, "b_stage");
+  EXPECT_EQ(totals[1].second.calls, 2u);
+  EXPECT_EQ(totals[1].second.values.instructions, 40u);
+
+  // totals start over after each take
+  EXPECT_EQ(aggregator.take()[1].second.calls, 0u);
+}
+
+TEST(PerfCountersTest, ScalesMultiplexedCounts)
+{
+  // counted for the whole time it was enabled
+  const auto full = scale_to_enabled_time(PerfCounterValues{10, 20, 1, 2, 100, 100});
+  ASSERT_TRUE(full.has_value());
+  EXPECT_EQ(full->cycles, 10u);
+  EXPECT_EQ(full->branch_misses, 2u);
+
+  // counted for a quarter of the time
+  const auto scaled = scale_to_enabled_time(PerfCounterValues{10, 20, 1, 3, 400, 100});
+  ASSERT_TRUE(scaled.has_value());
+  EXPECT_EQ(scaled->cycles, 40u);
+  EXPECT_EQ(scaled->instructions, 80u);
+  EXPECT_EQ(scaled->cache_misses, 4u);
+  EXPECT_EQ(scaled->branch_misses, 12u);
+  EXPECT_EQ(scaled->time_enabled_ns, 400u);
+  EXPECT_EQ(scaled->time_running_ns, 100u);
+
+  // never scheduled on the hardware counters
+  EXPECT_FALSE(scale_to_enabled_time(PerfCounterValues{0, 0, 0, 0, 400, 0}).has_value());
+}
+
+TEST(PerfCountersTest, FlagsScaledAndUnmeasuredCalls)
+{
+  PerfCounterAggregator aggregator;
+  aggregator.add("stage", PerfCounterValues{10, 20, 1, 2, 100, 100});
+  aggregator.add("stage", PerfCounterValues{40, 80, 4, 8, 400, 100});
+  aggregator.add_unmeasured("stage");
+
+  const auto totals = aggregator.take();
+  ASSERT_EQ(totals.size(), 1u);
+  const auto & stage_totals = totals.front().second;
+  EXPECT_EQ(stage_totals.calls, 2u);
+  EXPECT_EQ(stage_totals.scaled_calls, 1u);
+  EXPECT_EQ(stage_totals.unmeasured_calls, 1u);
+  EXPECT_EQ(stage_totals.values.cycles, 50u);
+}
+
+TEST(PerfCountersTest, ScopedCountersDegradeGracefully)
+{
+  PerfCounterAggregator aggregator;
+  {
+    const ScopedStagePerfCounters counters(nullptr, "stage");
+  }
+  {
+    const ScopedStagePerfCounters counters(&aggregator, "stage");
+    volatile double sum = 0.0;
+    for (int i = 0; i < 1000; ++i) {
+      sum = sum + static_cast<double>(i);
+    }
+  }
+
+  const auto totals = aggregator.take();
+  // nothing is recorded where the kernel does not allow perf_event_open
+  if (!PerfCounterGroup::for_current_thread().is_available()) {
+    EXPECT_TRUE(totals.empty());
+    return;
+  }
+  ASSERT_EQ(totals.size(), 1u);
+  // unmeasured if other events held the hardware counters all along
+  EXPECT_EQ(totals.front().second.calls + totals.front().second.unmeasured_calls, 1u);
+}
@@ -0,0 +1,85 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// The production pipeline replaces OptimizerChain only when TRAJECTORY_OPTIMIZER_STATIC_PIPELINE
+// is set, so it is compiled and compared here whatever the build option.
+
+#include "../benchmark/fuzzed_cycle.hpp"
+#include "autoware/trajectory_optimizer/optimizer_chain.hpp"
+#include "autoware/trajectory_optimizer/production_pipeline.hpp"
+#include "autoware/trajectory_optimizer/scenario_generator.hpp"
+#include "reference/differential.hpp"
+
+#include <autoware_utils/system/time_keeper.hpp>
+#include <rclcpp/rclcpp.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+
+using autoware::trajectory_optimizer::OptimizerChain;
+using autoware::trajectory_optimizer::pipeline::ProductionPipeline;
+namespace benchmark = autoware::trajectory_optimizer::benchmark;
+namespace reference = autoware::trajectory_optimizer::reference;
+namespace scenarios = autoware::trajectory_optimizer::scenarios;
+
+namespace
+{
+class ProductionPipelineTest : public ::testing::Test
+{
+protected:
+  static void SetUpTestSuite() { rclcpp::init(0, nullptr); }
+  static void TearDownTestSuite() { rclcpp::shutdown(); }
+};
+}  // namespace
+
+TEST_F(ProductionPipelineTest, MatchesOptimizerChain)
+{
+  // each chain declares the smoother parameters on its own node
+  auto chain_node = benchmark::create_node_with_shipped_config("optimizer_chain");
+  auto pipeline_node = benchmark::create_node_with_shipped_config("production_pipeline");
+  const auto params = benchmark::create_fuzzing_params(*chain_node);
+  OptimizerChain chain(
+    chain_node.get(), std::make_shared<autoware_utils_debug::TimeKeeper>(), params);
+  ProductionPipeline pipeline(
+    pipeline_node.get(), std::make_shared<autoware_utils_debug::TimeKeeper>(), params);
+
+  // both chains see the same sequence, so the warm starts of their smoothers match too
+  for (uint64_t seed = 0; seed < 4; ++seed) {
+    scenarios::ScenarioGenerator generator(seed);
+    for (const auto type : scenarios::all_scenario_types()) {
+      scenarios::ScenarioParams scenario_params;
+      scenario_params.type = type;
+      if (seed % 2 == 1) {
+        scenario_params.defects.position_noise_stddev_m = 0.05;
+        scenario_params.defects.duplicate_point_ratio = 0.1;
+        scenario_params.defects.invalid_point_ratio = 0.05;
+      }
+      const auto scenario = generator.generate(scenario_params);
+      auto cycle_params = params;
+      cycle_params.current_odometry = scenario.odometry;
+      cycle_params.current_acceleration = scenario.acceleration;
+      cycle_params.ego_history_points = scenario.ego_history_points;
+
+      auto chain_points = scenario.trajectory;
+      auto pipeline_points = scenario.trajectory;
+      chain.optimize_trajectory(chain_points, cycle_params);
+      pipeline.optimize_trajectory(pipeline_points, cycle_params);
+      if (const auto divergence = reference::find_first_divergence(chain_points, pipeline_points)) {
+        ADD_FAILURE() << scenarios::to_string(type) << " seed " << seed << ": " << *divergence;
+      }
+    }
+  }
+}
@@ -0,0 +1,103 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/trajectory_optimizer/realtime_profile.hpp"
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+using autoware::trajectory_optimizer::PageFaultMonitor;
+using autoware::trajectory_optimizer::PageFaults;
+using autoware::trajectory_optimizer::ScopedPageFaultCycle;
+
+namespace
+{
+constexpr size_t num_pages = 64;
+
+// maps num_pages fresh pages and writes to each, which takes one minor fault per page
+void touch_fresh_pages()
+{
+  const auto page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  void * memory = mmap(
+    nullptr, num_pages * page_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  ASSERT_NE(memory, MAP_FAILED);
+  auto * bytes = static_cast<volatile unsigned char *>(memory);
+  for (size_t i = 0; i < num_pages; ++i) {
+    bytes[i * page_size] = 1;
+  }
+  munmap(memory, num_pages * page_size);
+}
+}  // namespace
+
+TEST(RealtimeProfileTest, PageFaultMonitorCountsSteadyStateCyclesOnly)
+{
+  PageFaultMonitor monitor(2);
+  for (int i = 0; i < 2; ++i) {
+    monitor.begin_cycle();
+    touch_fresh_pages();
+    EXPECT_FALSE(monitor.end_cycle().has_value()) << "warm-up cycle " << i;
+  }
+
+  monitor.begin_cycle();
+  touch_fresh_pages();
+  const auto page_faults = monitor.end_cycle();
+  ASSERT_TRUE(page_faults.has_value());
+  EXPECT_GE(page_faults->minor, static_cast<int64_t>(num_pages));
+  EXPECT_GE(page_faults->major, 0);
+
+  // faults taken outside of a cycle are not counted in the next one
+  touch_fresh_pages();
+  monitor.begin_cycle();
+  const auto quiet = monitor.end_cycle();
+  ASSERT_TRUE(quiet.has_value());
+  EXPECT_LT(quiet->minor, static_cast<int64_t>(num_pages));
+}
+
+TEST(RealtimeProfileTest, ScopedPageFaultCycleEndsOnEveryExit)
+{
+  PageFaultMonitor monitor(1);
+  std::vector<PageFaults> reports;
+  const auto report = [&reports](const PageFaults & page_faults) {
+    reports.push_back(page_faults);
+  };
+  const auto run_cycle = [&](const bool return_early) {
+    const ScopedPageFaultCycle cycle(&monitor, report);
+    if (return_early) {
+      return;
+    }
+    touch_fresh_pages();
+  };
+
+  // the warm-up cycle is not reported, even when it returns early
+  run_cycle(true);
+  EXPECT_TRUE(reports.empty());
+  run_cycle(false);
+  run_cycle(true);
+  ASSERT_EQ(reports.size(), 2u);
+  EXPECT_GE(reports[0].minor, static_cast<int64_t>(num_pages));
+  EXPECT_LT(reports[1].minor, static_cast<int64_t>(num_pages));
+
+  // no monitor, no report
+  {
+    const ScopedPageFaultCycle cycle(nullptr, report);
+    touch_fresh_pages();
+  }
+  EXPECT_EQ(reports.size(), 2u);
+}
@@ -0,0 +1,144 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/trajectory_optimizer/scenario_generator.hpp"
+#include "autoware/trajectory_optimizer/trajectory_optimizer_structs.hpp"
+#include "autoware/trajectory_optimizer/utils.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+
+using autoware::trajectory_optimizer::TrajectoryOptimizerParams;
+namespace scenarios = autoware::trajectory_optimizer::scenarios;
+namespace utils = autoware::trajectory_optimizer::utils;
+
+namespace
+{
+double get_yaw(const scenarios::TrajectoryPoint & point)
+{
+  return 2.0 * std::atan2(point.pose.orientation.z, point.pose.orientation.w);
+}
+
+scenarios::Scenario generate(const scenarios::ScenarioType type, const uint64_t seed = 0)
+{
+  scenarios::ScenarioParams params;
+  params.type = type;
+  return scenarios::ScenarioGenerator(seed).generate(params);
+}
+}  // namespace
+
+TEST(ScenarioGeneratorTest, SameSeedGeneratesSameScenarios)
+{
+  for (const auto type : scenarios::all_scenario_types()) {
+    const auto a = generate(type, 7);
+    const auto b = generate(type, 7);
+    ASSERT_EQ(a.trajectory.size(), b.trajectory.size()) << scenarios::to_string(type);
+    for (size_t i = 0; i < a.trajectory.size(); ++i) {
+      EXPECT_EQ(a.trajectory[i].pose.position.x, b.trajectory[i].pose.position.x);
+      EXPECT_EQ(a.trajectory[i].pose.position.y, b.trajectory[i].pose.position.y);
+      EXPECT_EQ(
+        a.trajectory[i].longitudinal_velocity_mps, b.trajectory[i].longitudinal_velocity_mps);
+    }
+    EXPECT_EQ(a.odometry.pose.pose.position.y, b.odometry.pose.pose.position.y);
+  }
+}
+
+TEST(ScenarioGeneratorTest, ScenariosHaveTheirShape)
+{
+  for (const auto type : scenarios::all_scenario_types()) {
+    const auto scenario = generate(type);
+    ASSERT_EQ(scenario.trajectory.size(), 100u) << scenarios::to_string(type);
+    EXPECT_EQ(scenario.ego_history_points.size(), 20u);
+    for (const auto & point : scenario.trajectory) {
+      EXPECT_TRUE(utils::validate_point(point)) << scenarios::to_string(type);
+      // heading rate times speed is the lateral acceleration
+      EXPECT_LE(
+        std::abs(point.heading_rate_rps * point.longitudinal_velocity_mps), 2.0f + 1e-3f);
+    }
+  }
+
+  const auto lane_change = generate(scenarios::ScenarioType::LANE_CHANGE);
+  EXPECT_NEAR(std::abs(lane_change.trajectory.back().pose.position.y), 3.5, 0.5);
+  EXPECT_NEAR(get_yaw(lane_change.trajectory.back()), 0.0, 0.05);
+
+  const auto turn = generate(scenarios::ScenarioType::INTERSECTION_TURN);
+  EXPECT_NEAR(std::abs(get_yaw(turn.trajectory.back())), M_PI / 2.0, 0.1);
+
+  const auto u_turn = generate(scenarios::ScenarioType::U_TURN);
+  EXPECT_NEAR(std::abs(get_yaw(u_turn.trajectory.back())), M_PI, 0.1);
+
+  const auto pull_over = generate(scenarios::ScenarioType::PULL_OVER);
+  EXPECT_FLOAT_EQ(pull_over.trajectory.back().longitudinal_velocity_mps, 0.0f);
+
+  const auto stop_and_go = generate(scenarios::ScenarioType::STOP_AND_GO);
+  EXPECT_FLOAT_EQ(stop_and_go.trajectory.front().longitudinal_velocity_mps, 0.0f);
+  EXPECT_TRUE(std::any_of(
+    stop_and_go.trajectory.begin() + 10, stop_and_go.trajectory.end(),
+    [](const auto & point) { return point.longitudinal_velocity_mps < 0.5f; }));
+}
+
+TEST(ScenarioGeneratorTest, DefectsAreRemovedByTheChainUtils)
+{
+  scenarios::ScenarioParams params;
+  params.type = scenarios::ScenarioType::LANE_CHANGE;
+  params.defects.invalid_point_ratio = 0.1;
+  auto invalid = scenarios::ScenarioGenerator(1).generate(params).trajectory;
+  const auto num_valid = std::count_if(invalid.begin(), invalid.end(), [](const auto & point) {
+    return utils::validate_point(point);
+  });
+  ASSERT_LT(num_valid, static_cast<std::ptrdiff_t>(invalid.size()));
+  utils::remove_invalid_points(invalid);
+  EXPECT_EQ(static_cast<std::ptrdiff_t>(invalid.size()), num_valid);
+
+  params.defects = scenarios::DefectParams{};
+  params.defects.duplicate_point_ratio = 0.2;
+  auto duplicated = scenarios::ScenarioGenerator(1).generate(params).trajectory;
+  ASSERT_GT(duplicated.size(), params.num_points);
+  utils::remove_invalid_points(duplicated);
+  EXPECT_EQ(duplicated.size(), params.num_points);
+}
+
+TEST(ScenarioGeneratorTest, CandidateScoresSumToOne)
+{
+  scenarios::ScenarioParams params;
+  params.type = scenarios::ScenarioType::INTERSECTION_TURN;
+  scenarios::Scenario scenario;
+  const auto candidates = scenarios::ScenarioGenerator(3).generate_candidates(params, 6, &scenario);
+  ASSERT_EQ(candidates.trajectories.size(), 6u);
+  double total_score = 0.0;
+  for (size_t i = 0; i < candidates.trajectories.size(); ++i) {
+    total_score += candidates.trajectories[i].score;
+    if (i > 0) {
+      EXPECT_LE(candidates.trajectories[i].score, candidates.trajectories[i - 1].score);
+    }
+  }
+  EXPECT_NEAR(total_score, 1.0, 1e-9);
+  EXPECT_EQ(candidates.trajectories.front().points.size(), scenario.trajectory.size());
+}
+
+TEST(ScenarioGeneratorTest, SplineHandlesEveryScenario)
+{
+  TrajectoryOptimizerParams params;
+  params.spline_interpolation_resolution_m = 0.5;
+  for (const auto type : scenarios::all_scenario_types()) {
+    auto points = generate(type).trajectory;
+    utils::apply_spline(points, params);
+    ASSERT_GE(points.size(), 2u) << scenarios::to_string(type);
+    for (const auto & point : points) {
+      EXPECT_TRUE(utils::validate_point(point)) << scenarios::to_string(type);
+    }
+  }
+}
@@ -0,0 +1,153 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/trajectory_optimizer/shadow_chain.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <future>
+#include <limits>
+#include <vector>
+
+using autoware::trajectory_optimizer::add_to_metrics;
+using autoware::trajectory_optimizer::compare_outputs;
+using autoware::trajectory_optimizer::get_shadow_overrides;
+using autoware::trajectory_optimizer::ShadowMetrics;
+using autoware::trajectory_optimizer::ShadowRunner;
+using autoware_planning_msgs::msg::TrajectoryPoint;
+
+namespace
+{
+std::vector<TrajectoryPoint> make_line(
+  const size_t num_points, const double interval_m, const double y, const float velocity)
+{
+  std::vector<TrajectoryPoint> points(num_points);
+  for (size_t i = 0; i < num_points; ++i) {
+    points[i].pose.position.x = static_cast<double>(i) * interval_m;
+    points[i].pose.position.y = y;
+    points[i].longitudinal_velocity_mps = velocity;
+  }
+  return points;
+}
+
+ShadowMetrics make_empty_metrics()
+{
+  ShadowMetrics metrics;
+  const auto nan = std::numeric_limits<double>::quiet_NaN();
+  metrics.max_position_deviation_m = nan;
+  metrics.mean_position_deviation_m = nan;
+  metrics.max_velocity_difference_mps = nan;
+  metrics.max_length_difference_m = nan;
+  return metrics;
+}
+}  // namespace
+
+TEST(ShadowChainTest, SamePathAtAnotherResolutionHasNoDeviation)
+{
+  const auto primary = make_line(11, 1.0, 0.0, 5.0f);
+  const auto shadow = make_line(41, 0.25, 0.0, 5.0f);
+  const auto difference = compare_outputs(primary, shadow);
+  EXPECT_NEAR(difference.max_position_deviation_m, 0.0, 1e-12);
+  EXPECT_NEAR(difference.max_velocity_difference_mps, 0.0, 1e-6);
+  EXPECT_NEAR(difference.length_difference_m, 0.0, 1e-9);
+}
+
+TEST(ShadowChainTest, MeasuresOffsetVelocityAndLength)
+{
+  auto primary = make_line(11, 1.0, 0.0, 5.0f);
+  // the velocity ramps from 0 to 10 along the primary path
+  for (size_t i = 0; i < primary.size(); ++i) {
+    primary[i].longitudinal_velocity_mps = static_cast<float>(i);
+  }
+  auto shadow = make_line(5, 1.0, 0.5, 0.0f);
+  shadow[2].pose.position.y = 1.0;
+  for (size_t i = 0; i < shadow.size(); ++i) {
+    shadow[i].longitudinal_velocity_mps = static_cast<float>(i);
+  }
+  shadow[4].longitudinal_velocity_mps = 6.0f;
+  const auto difference = compare_outputs(primary, shadow);
+  EXPECT_NEAR(difference.max_position_deviation_m, 1.0, 1e-12);
+  EXPECT_NEAR(difference.mean_position_deviation_m, (4 * 0.5 + 1.0) / 5.0, 1e-12);
+  EXPECT_NEAR(difference.max_velocity_difference_mps, 2.0, 1e-6);
+  EXPECT_LT(difference.length_difference_m, 0.0);
+
+  EXPECT_TRUE(std::isnan(compare_outputs({}, shadow).max_position_deviation_m));
+  EXPECT_TRUE(std::isnan(compare_outputs(primary, {}).length_difference_m));
+}
+
+TEST(ShadowChainTest, MetricsAggregateTheCandidates)
+{
+  auto metrics = make_empty_metrics();
+  add_to_metrics(compare_outputs({}, make_line(3, 1.0, 0.0, 1.0f)), metrics);
+  EXPECT_EQ(metrics.num_candidates, 1u);
+  EXPECT_EQ(metrics.num_compared_candidates, 0u);
+  EXPECT_TRUE(std::isnan(metrics.max_position_deviation_m));
+
+  const auto primary = make_line(11, 1.0, 0.0, 1.0f);
+  add_to_metrics(compare_outputs(primary, make_line(11, 1.0, 0.2, 1.0f)), metrics);
+  add_to_metrics(compare_outputs(primary, make_line(6, 1.0, 0.4, 1.0f)), metrics);
+  EXPECT_EQ(metrics.num_candidates, 3u);
+  EXPECT_EQ(metrics.num_compared_candidates, 2u);
+  EXPECT_NEAR(metrics.max_position_deviation_m, 0.4, 1e-12);
+  EXPECT_NEAR(metrics.mean_position_deviation_m, 0.3, 1e-12);
+  EXPECT_NEAR(metrics.max_length_difference_m, -5.0, 1e-9);
+}
+
+TEST(ShadowChainTest, OverridesAreRenamedWithoutPrefix)
+{
+  const auto overrides = get_shadow_overrides(
+    {rclcpp::Parameter("shadow.parameters.spline_interpolation_resolution_m", 0.25),
+     rclcpp::Parameter("spline_interpolation_resolution_m", 0.5),
+     rclcpp::Parameter("shadow.sample_period", 10), rclcpp::Parameter("shadow.parameters.", 1)});
+  ASSERT_EQ(overrides.size(), 1u);
+  EXPECT_EQ(overrides.front().get_name(), "spline_interpolation_resolution_m");
+  EXPECT_DOUBLE_EQ(overrides.front().as_double(), 0.25);
+}
+
+TEST(ShadowChainTest, RunnerSkipsOffersWhileBusy)
+{
+  std::atomic<bool> started{false};
+  ShadowRunner runner([&]() { started = true; });
+
+  std::promise<void> release;
+  auto released = release.get_future().share();
+  std::promise<void> first_done;
+  ASSERT_TRUE(runner.try_reserve());
+  runner.submit([&]() {
+    released.wait();
+    first_done.set_value();
+  });
+  EXPECT_FALSE(runner.try_reserve());
+  EXPECT_FALSE(runner.try_reserve());
+  release.set_value();
+  first_done.get_future().wait();
+  EXPECT_TRUE(started.load());
+  EXPECT_EQ(runner.take_num_skipped(), 2u);
+  EXPECT_EQ(runner.take_num_skipped(), 0u);
+
+  // the reservation is released once the task has returned
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  bool reserved = false;
+  while (!reserved && std::chrono::steady_clock::now() < deadline) {
+    reserved = runner.try_reserve();
+  }
+  ASSERT_TRUE(reserved);
+  std::promise<void> second_done;
+  runner.submit([&]() { second_done.set_value(); });
+  EXPECT_EQ(
+    second_done.get_future().wait_for(std::chrono::seconds(5)), std::future_status::ready);
+}
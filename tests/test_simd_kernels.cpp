@@ -0,0 +1,222 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Every instruction set the cpu supports is forced in turn and its kernels are compared with the
+// scalar ones, and the utils functions built on them with their frozen references.
+
+#include "autoware/trajectory_optimizer/scenario_generator.hpp"
+#include "autoware/trajectory_optimizer/simd_kernels.hpp"
+#include "autoware/trajectory_optimizer/utils.hpp"
+#include "reference/differential.hpp"
+#include "reference/reference_utils.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace reference = autoware::trajectory_optimizer::reference;
+namespace scenarios = autoware::trajectory_optimizer::scenarios;
+namespace simd = autoware::trajectory_optimizer::simd;
+namespace utils = autoware::trajectory_optimizer::utils;
+
+namespace
+{
+constexpr double min_dist = 0.1;
+
+// restores the instruction set selected at startup
+class ScopedIsa
+{
+public:
+  explicit ScopedIsa(const simd::Isa isa) : previous_(simd::active_isa())
+  {
+    EXPECT_TRUE(simd::set_active_isa(isa));
+  }
+  ~ScopedIsa() { simd::set_active_isa(previous_); }
+  ScopedIsa(const ScopedIsa &) = delete;
+  ScopedIsa & operator=(const ScopedIsa &) = delete;
+
+private:
+  simd::Isa previous_;
+};
+
+// the edge cases, defective scenarios of every length up to past two AVX-512 blocks, and points
+// spaced at min_dist give or take the rounding error of the squared distance
+std::vector<std::pair<std::string, reference::TrajectoryPoints>> make_inputs()
+{
+  auto inputs = reference::make_edge_cases();
+  for (uint64_t seed = 0; seed < 4; ++seed) {
+    scenarios::ScenarioParams params;
+    const auto & types = scenarios::all_scenario_types();
+    params.type = types.at(seed % types.size());
+    params.point_interval_m = 0.1;
+    params.defects.duplicate_point_ratio = 0.2;
+    params.defects.invalid_point_ratio = 0.2;
+    const auto scenario = scenarios::ScenarioGenerator(seed).generate(params);
+    for (size_t size = 0; size <= 20; ++size) {
+      inputs.emplace_back(
+        "seed " + std::to_string(seed) + " size " + std::to_string(size),
+        reference::TrajectoryPoints(
+          scenario.trajectory.begin(), scenario.trajectory.begin() + size));
+    }
+    inputs.emplace_back("seed " + std::to_string(seed), scenario.trajectory);
+  }
+
+  reference::TrajectoryPoints boundary(40);
+  for (size_t i = 1; i < boundary.size(); ++i) {
+    const double step = std::nextafter(min_dist, i % 3 == 0 ? 0.0 : 1.0);
+    const double angle = 0.1 * static_cast<double>(i);
+    boundary[i].pose.position.x = boundary[i - 1].pose.position.x + step * std::cos(angle);
+    boundary[i].pose.position.y = boundary[i - 1].pose.position.y + step * std::sin(angle);
+  }
+  inputs.emplace_back("boundary", boundary);
+  return inputs;
+}
+
+const std::vector<std::pair<std::string, reference::TrajectoryPoints>> & inputs()
+{
+  static const auto inputs = make_inputs();
+  return inputs;
+}
+
+std::vector<uint8_t> flag_invalid_points(const reference::TrajectoryPoints & points)
+{
+  std::vector<uint8_t> flags(points.size(), 2);
+  simd::flag_invalid_points(points.data(), points.size(), flags.data());
+  return flags;
+}
+
+std::vector<uint8_t> flag_close_pairs(const reference::TrajectoryPoints & points)
+{
+  std::vector<uint8_t> flags(points.empty() ? 0 : points.size() - 1, 2);
+  simd::flag_close_pairs(points.data(), points.size(), min_dist, flags.data());
+  return flags;
+}
+
+reference::TrajectoryPoints clamp(reference::TrajectoryPoints points)
+{
+  simd::clamp_min_velocity_and_acceleration(points.data(), points.size(), 0.5f, -0.0f);
+  simd::clamp_max_velocity(points.data(), points.size(), 10.0f);
+  return points;
+}
+}  // namespace
+
+TEST(SimdKernelsTest, ScalarIsAlwaysSupported)
+{
+  const auto isas = simd::supported_isas();
+  ASSERT_FALSE(isas.empty());
+  EXPECT_EQ(isas.front(), simd::Isa::SCALAR);
+  EXPECT_NE(std::find(isas.begin(), isas.end(), simd::active_isa()), isas.end());
+  EXPECT_EQ(simd::to_string(simd::Isa::AVX512), "avx512");
+}
+
+TEST(SimdKernelsTest, EveryIsaMatchesScalar)
+{
+  for (const auto isa : simd::supported_isas()) {
+    for (const auto & [name, points] : inputs()) {
+      std::vector<uint8_t> expected_invalid;
+      std::vector<uint8_t> expected_close;
+      reference::TrajectoryPoints expected_clamped;
+      {
+        ScopedIsa scalar(simd::Isa::SCALAR);
+        expected_invalid = flag_invalid_points(points);
+        expected_close = flag_close_pairs(points);
+        expected_clamped = clamp(points);
+      }
+      ScopedIsa forced(isa);
+      const auto label = simd::to_string(isa) + " " + name;
+      EXPECT_EQ(flag_invalid_points(points), expected_invalid) << label;
+      EXPECT_EQ(flag_close_pairs(points), expected_close) << label;
+      if (
+        const auto divergence =
+          reference::find_first_divergence(expected_clamped, clamp(points))) {
+        ADD_FAILURE() << label << ": " << *divergence;
+      }
+    }
+  }
+}
+
+TEST(SimdKernelsTest, FlagsMatchTheUtils)
+{
+  for (const auto isa : simd::supported_isas()) {
+    ScopedIsa forced(isa);
+    for (const auto & [name, points] : inputs()) {
+      const auto is_invalid = flag_invalid_points(points);
+      const auto is_close = flag_close_pairs(points);
+      for (size_t i = 0; i < points.size(); ++i) {
+        ASSERT_EQ(is_invalid[i], !reference::validate_point(points[i]))
+          << simd::to_string(isa) << " " << name << ": point " << i;
+        if (i > 0) {
+          const auto distance = std::hypot(
+            points[i].pose.position.x - points[i - 1].pose.position.x,
+            points[i].pose.position.y - points[i - 1].pose.position.y);
+          ASSERT_EQ(is_close[i - 1], distance < min_dist)
+            << simd::to_string(isa) << " " << name << ": point " << i;
+        }
+      }
+    }
+  }
+}
+
+TEST(SimdKernelsTest, ClampKeepsNanAndSignedZeros)
+{
+  constexpr auto nan = std::numeric_limits<float>::quiet_NaN();
+  for (const auto isa : simd::supported_isas()) {
+    ScopedIsa forced(isa);
+    reference::TrajectoryPoints points(11);
+    points[3].longitudinal_velocity_mps = nan;
+    points[9].acceleration_mps2 = nan;
+    points[10].longitudinal_velocity_mps = 20.0f;
+    simd::clamp_min_velocity_and_acceleration(points.data(), points.size(), 0.0f, -0.0f);
+    simd::clamp_max_velocity(points.data(), points.size(), nan);
+    EXPECT_TRUE(std::isnan(points[3].longitudinal_velocity_mps)) << simd::to_string(isa);
+    EXPECT_TRUE(std::isnan(points[9].acceleration_mps2)) << simd::to_string(isa);
+    EXPECT_EQ(points[10].longitudinal_velocity_mps, 20.0f) << simd::to_string(isa);
+    // std::max(+0, -0) keeps +0
+    EXPECT_FALSE(std::signbit(points[0].acceleration_mps2)) << simd::to_string(isa);
+  }
+}
+
+TEST(SimdKernelsTest, UtilsMatchTheReferencesOnEveryIsa)
+{
+  for (const auto isa : simd::supported_isas()) {
+    ScopedIsa forced(isa);
+    for (const auto & [name, points] : inputs()) {
+      auto reference_points = points;
+      auto production_points = points;
+      reference::remove_close_proximity_points(reference_points, min_dist);
+      utils::remove_close_proximity_points(production_points, min_dist);
+      if (
+        const auto divergence =
+          reference::find_first_divergence(reference_points, production_points)) {
+        ADD_FAILURE() << simd::to_string(isa) << " " << name << ": " << *divergence;
+      }
+
+      reference_points = points;
+      production_points = points;
+      reference::remove_invalid_points(reference_points);
+      utils::remove_invalid_points(production_points);
+      if (
+        const auto divergence =
+          reference::find_first_divergence(reference_points, production_points)) {
+        ADD_FAILURE() << simd::to_string(isa) << " " << name << ": " << *divergence;
+      }
+    }
+  }
+}
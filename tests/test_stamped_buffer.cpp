@@ -0,0 +1,96 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/trajectory_optimizer/stamped_buffer.hpp"
+
+#include <gtest/gtest.h>
+
+#include <nav_msgs/msg/odometry.hpp>
+
+#include <memory>
+
+using autoware::trajectory_optimizer::StampedBuffer;
+using nav_msgs::msg::Odometry;
+
+namespace
+{
+constexpr int64_t kNanosecondsPerSecond = 1000000000;
+
+Odometry::ConstSharedPtr create_odometry(const int32_t sec, const double x)
+{
+  auto odometry = std::make_shared<Odometry>();
+  odometry->header.stamp.sec = sec;
+  odometry->pose.pose.position.x = x;
+  return odometry;
+}
+}  // namespace
+
+TEST(StampedBufferTest, FindsLatestMessageAtStamp)
+{
+  StampedBuffer<Odometry> buffer;
+  EXPECT_EQ(buffer.find_latest_at(5 * kNanosecondsPerSecond), nullptr);
+
+  buffer.push(create_odometry(1, 1.0));
+  buffer.push(create_odometry(3, 3.0));
+  EXPECT_EQ(buffer.find_latest_at(0), nullptr);
+  EXPECT_DOUBLE_EQ(buffer.find_latest_at(1 * kNanosecondsPerSecond)->pose.pose.position.x, 1.0);
+  EXPECT_DOUBLE_EQ(buffer.find_latest_at(2 * kNanosecondsPerSecond)->pose.pose.position.x, 1.0);
+  EXPECT_DOUBLE_EQ(buffer.find_latest_at(4 * kNanosecondsPerSecond)->pose.pose.position.x, 3.0);
+}
+
+TEST(StampedBufferTest, LookupIsCompleteOnceLaterMessageArrives)
+{
+  StampedBuffer<Odometry> buffer;
+  buffer.push(create_odometry(1, 1.0));
+  EXPECT_TRUE(buffer.is_complete(1 * kNanosecondsPerSecond));
+  EXPECT_FALSE(buffer.is_complete(2 * kNanosecondsPerSecond));
+
+  buffer.push(create_odometry(2, 2.0));
+  EXPECT_TRUE(buffer.is_complete(2 * kNanosecondsPerSecond));
+}
+
+TEST(StampedBufferTest, DropsOutOfOrderMessages)
+{
+  StampedBuffer<Odometry> buffer;
+  EXPECT_TRUE(buffer.push(create_odometry(2, 2.0)));
+  EXPECT_FALSE(buffer.push(create_odometry(1, 1.0)));
+  EXPECT_EQ(buffer.size(), 1u);
+}
+
+TEST(StampedBufferTest, KeepsMessagesUntilDiscarded)
+{
+  StampedBuffer<Odometry> buffer;
+  for (int32_t sec = 1; sec <= 4; ++sec) {
+    buffer.push(create_odometry(sec, static_cast<double>(sec)));
+  }
+  EXPECT_EQ(buffer.size(), 4u);
+  EXPECT_DOUBLE_EQ(buffer.find_latest_at(1 * kNanosecondsPerSecond)->pose.pose.position.x, 1.0);
+
+  buffer.discard_oldest(2);
+  EXPECT_EQ(buffer.size(), 2u);
+  EXPECT_EQ(buffer.find_latest_at(2 * kNanosecondsPerSecond), nullptr);
+  EXPECT_DOUBLE_EQ(buffer.find_latest_at(3 * kNanosecondsPerSecond)->pose.pose.position.x, 3.0);
+}
+
+TEST(StampedBufferTest, DiscardKeepsMessageStillNeeded)
+{
+  StampedBuffer<Odometry> buffer;
+  buffer.push(create_odometry(1, 1.0));
+  buffer.push(create_odometry(2, 2.0));
+  buffer.push(create_odometry(4, 4.0));
+
+  buffer.discard_before(3 * kNanosecondsPerSecond);
+  EXPECT_EQ(buffer.size(), 2u);
+  EXPECT_DOUBLE_EQ(buffer.find_latest_at(3 * kNanosecondsPerSecond)->pose.pose.position.x, 2.0);
+}
@@ -0,0 +1,94 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/trajectory_optimizer/static_pipeline.hpp"
+#include "autoware/trajectory_optimizer/trajectory_optimizer_structs.hpp"
+#include "autoware/trajectory_optimizer/utils.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+
+using autoware::trajectory_optimizer::TrajectoryOptimizerParams;
+using autoware::trajectory_optimizer::pipeline::Pipeline;
+using autoware::trajectory_optimizer::pipeline::TrajectoryPoints;
+namespace stages = autoware::trajectory_optimizer::pipeline::stages;
+namespace utils = autoware::trajectory_optimizer::utils;
+
+namespace
+{
+TrajectoryPoints create_sample_trajectory()
+{
+  TrajectoryPoints points(20);
+  for (size_t i = 0; i < points.size(); ++i) {
+    points[i].pose.position.x = static_cast<double>(i);
+    points[i].longitudinal_velocity_mps = 0.5f * static_cast<float>(i);
+    points[i].acceleration_mps2 = -0.1f;
+  }
+  points[7].pose.position.y = std::nan("");
+  return points;
+}
+
+TrajectoryOptimizerParams create_params()
+{
+  TrajectoryOptimizerParams params;
+  params.set_engage_speed = true;
+  params.limit_speed = true;
+  params.target_pull_out_speed_mps = 1.0;
+  params.target_pull_out_acc_mps2 = 0.5;
+  params.max_speed_mps = 5.0;
+  return params;
+}
+}  // namespace
+
+TEST(StaticPipelineTest, FusedStagesMatchSeparatePasses)
+{
+  const auto params = create_params();
+  auto expected = create_sample_trajectory();
+  utils::clamp_velocities(expected, 1.0f, 0.5f);
+  utils::set_max_velocity(expected, 5.0f);
+  expected.erase(
+    std::remove_if(
+      expected.begin(), expected.end(), [](const auto & p) { return !utils::validate_point(p); }),
+    expected.end());
+
+  Pipeline<stages::EngageSpeedClamp, stages::MaxSpeedLimit, stages::ValidPointFilter> pipeline{};
+  auto points = create_sample_trajectory();
+  pipeline.optimize_trajectory(points, params);
+
+  ASSERT_EQ(points.size(), expected.size());
+  for (size_t i = 0; i < points.size(); ++i) {
+    EXPECT_DOUBLE_EQ(points[i].pose.position.x, expected[i].pose.position.x);
+    EXPECT_FLOAT_EQ(points[i].longitudinal_velocity_mps, expected[i].longitudinal_velocity_mps);
+    EXPECT_FLOAT_EQ(points[i].acceleration_mps2, expected[i].acceleration_mps2);
+  }
+}
+
+TEST(StaticPipelineTest, DisabledStagesLeavePointsUntouched)
+{
+  auto params = create_params();
+  params.set_engage_speed = false;
+  params.limit_speed = false;
+
+  Pipeline<stages::EngageSpeedClamp, stages::MaxSpeedLimit> pipeline{};
+  const auto expected = create_sample_trajectory();
+  auto points = expected;
+  pipeline.optimize_trajectory(points, params);
+
+  ASSERT_EQ(points.size(), expected.size());
+  for (size_t i = 0; i < points.size(); ++i) {
+    EXPECT_FLOAT_EQ(points[i].longitudinal_velocity_mps, expected[i].longitudinal_velocity_mps);
+  }
+}
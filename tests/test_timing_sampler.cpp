@@ -0,0 +1,43 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/trajectory_optimizer/timing_sampler.hpp"
+
+#include <gtest/gtest.h>
+
+using autoware::trajectory_optimizer::TimingSampler;
+
+TEST(TimingSamplerTest, SamplesOneCycleInEveryPeriod)
+{
+  TimingSampler sampler(3);
+  EXPECT_TRUE(sampler.sample_cycle());
+  EXPECT_FALSE(sampler.sample_cycle());
+  EXPECT_FALSE(sampler.sample_cycle());
+  EXPECT_TRUE(sampler.sample_cycle());
+
+  // the period can be changed between cycles
+  sampler.set_period(1);
+  EXPECT_TRUE(sampler.sample_cycle());
+  EXPECT_TRUE(sampler.sample_cycle());
+  sampler.set_period(0);
+  EXPECT_FALSE(sampler.sample_cycle());
+}
+
+TEST(TimingSamplerTest, ForcedCycleIsSampledOnce)
+{
+  TimingSampler sampler(0);
+  sampler.force_next();
+  EXPECT_TRUE(sampler.sample_cycle());
+  EXPECT_FALSE(sampler.sample_cycle());
+}
@@ -0,0 +1,74 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/trajectory_optimizer/trajectory_buffer_pool.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+using autoware::trajectory_optimizer::NewTrajectory;
+using autoware::trajectory_optimizer::Trajectories;
+using autoware::trajectory_optimizer::TrajectoryBufferPool;
+
+namespace
+{
+Trajectories create_trajectories(const size_t num_candidates, const size_t num_points)
+{
+  Trajectories trajectories;
+  for (size_t i = 0; i < num_candidates; ++i) {
+    NewTrajectory trajectory;
+    trajectory.score = static_cast<double>(i);
+    trajectory.points.resize(num_points);
+    for (size_t j = 0; j < num_points; ++j) {
+      trajectory.points[j].pose.position.x = static_cast<double>(j);
+    }
+    trajectories.trajectories.push_back(trajectory);
+  }
+  return trajectories;
+}
+}  // namespace
+
+TEST(TrajectoryBufferPoolTest, CopiesInput)
+{
+  TrajectoryBufferPool pool;
+  const auto input = create_trajectories(3, 10);
+  const auto & output = pool.acquire(input);
+  ASSERT_EQ(output.trajectories.size(), 3u);
+  for (size_t i = 0; i < 3; ++i) {
+    EXPECT_DOUBLE_EQ(output.trajectories[i].score, input.trajectories[i].score);
+    ASSERT_EQ(output.trajectories[i].points.size(), 10u);
+    EXPECT_DOUBLE_EQ(output.trajectories[i].points.back().pose.position.x, 9.0);
+  }
+}
+
+TEST(TrajectoryBufferPoolTest, KeepsSlotStorageAcrossCycles)
+{
+  TrajectoryBufferPool pool;
+  std::vector<const void *> storage;
+  for (const auto & trajectory : pool.acquire(create_trajectories(3, 20)).trajectories) {
+    storage.push_back(trajectory.points.data());
+  }
+
+  // a smaller cycle parks the surplus slots instead of releasing them
+  EXPECT_EQ(pool.acquire(create_trajectories(1, 10)).trajectories.size(), 1u);
+  EXPECT_EQ(pool.slot_count(), 3u);
+
+  const auto & output = pool.acquire(create_trajectories(3, 20));
+  EXPECT_EQ(pool.slot_count(), 3u);
+  for (const auto & trajectory : output.trajectories) {
+    EXPECT_NE(std::find(storage.begin(), storage.end(), trajectory.points.data()), storage.end());
+  }
+}
@@ -21,6 +21,7 @@
 #include <gtest/gtest.h>
 
 #include <limits>
+#include <set>
 
 using namespace autoware::trajectory_optimizer::utils;
 using namespace autoware::trajectory_optimizer;
@@ -113,6 +114,37 @@ TEST_F(TrajectoryInterpolatorUtilsTest, ApplySpline)
   ASSERT_GE(points.size(), 2);
 }
 
+TEST_F(TrajectoryInterpolatorUtilsTest, ApplySplineWithScratchBuffer)
+{
+  TrajectoryOptimizerParams params;
+  params.spline_interpolation_resolution_m = 0.1;
+  TrajectoryPoints expected = create_sample_trajectory();
+  utils::apply_spline(expected, params);
+
+  TrajectoryPoints points = create_sample_trajectory();
+  TrajectoryPoints scratch_points;
+  utils::apply_spline(points, params, scratch_points);
+  ASSERT_EQ(points.size(), expected.size());
+  for (size_t i = 0; i < points.size(); ++i) {
+    EXPECT_DOUBLE_EQ(points[i].pose.position.x, expected[i].pose.position.x);
+    EXPECT_DOUBLE_EQ(points[i].pose.position.y, expected[i].pose.position.y);
+  }
+
+  // once both buffers have grown, the calls alternate between them without reallocating
+  const TrajectoryPoints input = create_sample_trajectory();
+  for (int i = 0; i < 2; ++i) {
+    points.assign(input.begin(), input.end());
+    utils::apply_spline(points, params, scratch_points);
+  }
+  const std::set<const TrajectoryPoint *> buffers{points.data(), scratch_points.data()};
+  for (int i = 0; i < 4; ++i) {
+    points.assign(input.begin(), input.end());
+    utils::apply_spline(points, params, scratch_points);
+    EXPECT_EQ(buffers.count(points.data()), 1u);
+    EXPECT_EQ(buffers.count(scratch_points.data()), 1u);
+  }
+}
+
 TEST_F(TrajectoryInterpolatorUtilsTest, AddEgoStateToTrajectory)
 {
   TrajectoryPoints points = create_sample_trajectory();
@@ -0,0 +1,74 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/trajectory_optimizer/worker_pool.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using autoware::trajectory_optimizer::WorkerPool;
+
+TEST(WorkerPoolTest, RunsEveryTaskOnce)
+{
+  std::atomic<size_t> started_workers{0};
+  WorkerPool pool(4, [&](size_t) { ++started_workers; });
+  std::vector<std::atomic<int>> counts(100);
+  pool.parallel_for(counts.size(), [&](size_t index, size_t worker_id) {
+    EXPECT_LT(worker_id, pool.size());
+    ++counts[index];
+  });
+  for (const auto & count : counts) {
+    EXPECT_EQ(count.load(), 1);
+  }
+  EXPECT_EQ(started_workers.load(), 4u);
+}
+
+TEST(WorkerPoolTest, ServesConcurrentCallers)
+{
+  WorkerPool pool(3, [](size_t) {});
+  std::atomic<size_t> total{0};
+  std::vector<std::thread> callers;
+  for (int i = 0; i < 4; ++i) {
+    callers.emplace_back([&]() {
+      for (int j = 0; j < 10; ++j) {
+        pool.parallel_for(16, [&](size_t, size_t) { ++total; });
+      }
+    });
+  }
+  for (auto & caller : callers) {
+    caller.join();
+  }
+  EXPECT_EQ(total.load(), 4u * 10u * 16u);
+}
+
+TEST(WorkerPoolTest, RethrowsTaskException)
+{
+  WorkerPool pool(2, [](size_t) {});
+  std::atomic<size_t> completed{0};
+  EXPECT_THROW(
+    pool.parallel_for(
+      8,
+      [&](size_t index, size_t) {
+        if (index == 3) {
+          throw std::runtime_error("failure");
+        }
+        ++completed;
+      }),
+    std::runtime_error);
+  EXPECT_EQ(completed.load(), 7u);
+}